@@ -0,0 +1,117 @@
+// ads101x
+#include <ads101x/driver.hpp>
+
+// std
+#include <chrono>
+#include <iostream>
+
+// Create virtually dispatched mock.
+struct virtual_driver
+    : public ads101x::driver
+{
+    void open_i2c(uint32_t i2c_bus, uint8_t i2c_address) override
+    {}
+    void close_i2c() override
+    {}
+    void write_register(uint8_t register_address, uint16_t value) const override
+    {
+        virtual_driver::value = value;
+    }
+    uint16_t read_register(uint8_t register_address) const override
+    {
+        return virtual_driver::value += register_address + 16;
+    }
+    void read_registers(uint8_t register_address, std::span<uint16_t> values) const override
+    {
+        uint16_t current = virtual_driver::value;
+        for(auto& value : values)
+        {
+            value = current += register_address + 16;
+        }
+        virtual_driver::value = current;
+    }
+    mutable uint16_t value = 0;
+};
+
+// Create statically dispatched mock.
+class static_driver
+    : public ads101x::basic_driver<static_driver>
+{
+private:
+    friend class ads101x::basic_driver<static_driver>;
+    void open_i2c(uint32_t i2c_bus, uint8_t i2c_address)
+    {}
+    void close_i2c()
+    {}
+    void write_register(uint8_t register_address, uint16_t value) const
+    {
+        static_driver::value = value;
+    }
+    uint16_t read_register(uint8_t register_address) const
+    {
+        return static_driver::value += register_address + 16;
+    }
+    mutable uint16_t value = 0;
+};
+
+// Hide the dynamic type of the virtual driver so calls cannot be devirtualized.
+__attribute__((noinline)) const ads101x::driver& erase(const virtual_driver& driver)
+{
+    return driver;
+}
+
+// Measures read_conversion() and returns nanoseconds per call.
+template<class driver_type>
+double measure(const driver_type& driver, uint32_t iterations, uint32_t& checksum)
+{
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < iterations; ++i)
+    {
+        checksum += driver.read_conversion();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / iterations;
+}
+
+// Measures read_conversions() and returns nanoseconds per value.
+template<class driver_type>
+double measure_block(const driver_type& driver, uint32_t iterations, uint32_t& checksum)
+{
+    uint16_t block[64];
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < iterations / 64; ++i)
+    {
+        driver.read_conversions(block);
+        checksum += block[63];
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / (iterations / 64 * 64);
+}
+
+int32_t main(int32_t argc, char** argv)
+{
+    // Get iteration count.
+    uint32_t iterations = (argc > 1) ? std::stoul(argv[1]) : 100000000;
+
+    // Create drivers.
+    virtual_driver virtual_mock;
+    static_driver static_mock;
+    uint32_t checksum = 0;
+
+    // Run benchmarks.
+    double virtual_ns = measure(erase(virtual_mock), iterations, checksum);
+    double static_ns = measure(static_mock, iterations, checksum);
+    double virtual_block_ns = measure_block(erase(virtual_mock), iterations, checksum);
+    double static_block_ns = measure_block(static_mock, iterations, checksum);
+
+    // Report results.
+    std::cout << "read_conversion() over " << iterations << " iterations" << std::endl;
+    std::cout << "  virtual driver:        " << virtual_ns << " ns/call" << std::endl;
+    std::cout << "  basic_driver<backend>: " << static_ns << " ns/call" << std::endl;
+    std::cout << "read_conversions() in blocks of 64" << std::endl;
+    std::cout << "  virtual driver:        " << virtual_block_ns << " ns/value" << std::endl;
+    std::cout << "  basic_driver<backend>: " << static_block_ns << " ns/value" << std::endl;
+    std::cout << "  (checksum " << checksum << ")" << std::endl;
+
+    return 0;
+}
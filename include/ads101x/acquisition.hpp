@@ -0,0 +1,229 @@
+/// \file ads101x/acquisition.hpp
+/// \brief Defines the ads101x::acquisition class.
+#ifndef ADS101X___ACQUISITION_H
+#define ADS101X___ACQUISITION_H
+
+// ads101x
+#include <ads101x/broadcast_ring.hpp>
+#include <ads101x/driver.hpp>
+#include <ads101x/event.hpp>
+#include <ads101x/realtime.hpp>
+#include <ads101x/sample.hpp>
+#include <ads101x/seqlock.hpp>
+#include <ads101x/variant.hpp>
+
+// std
+#include <array>
+#include <atomic>
+#include <functional>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace ads101x {
+
+/// \brief Continuously acquires samples from an ADS101X on a dedicated thread.
+/// \details Samples are written in blocks directly into a broadcast ring, which any number of consumers can read
+/// through their own independent readers without copying. Sinks can also be added to process each block on the
+/// acquisition thread as soon as it is published. Consumers that only need the newest value of a channel can read it
+/// with latest() instead of following the stream.
+class acquisition
+{
+public:
+    // CONSTRUCTORS
+    /// \brief Creates a new acquisition for a driver.
+    /// \param driver The started driver to acquire samples from.
+    /// \param block_size The number of samples in each block.
+    /// \param block_count The number of blocks held in the broadcast ring.
+    acquisition(ads101x::driver& driver, uint32_t block_size = 32, uint32_t block_count = 64);
+    ~acquisition();
+
+    // SETTINGS
+    /// \brief Enumerates the ways the acquisition thread paces conversions.
+    enum class mode
+    {
+        POLLING,        ///< Continuous conversions, read at the data rate on a timer.
+        DATA_READY,     ///< Continuous conversions, read on each ALERT/RDY conversion-ready edge.
+        SINGLESHOT      ///< One single-shot conversion per sample, cycling through the channels.
+    };
+    /// \brief Sets the acquisition mode.
+    /// \param mode The acquisition mode.
+    void set_mode(acquisition::mode mode);
+    /// \brief Sets the configuration used for all conversions.
+    /// \details The operation, mode, and multiplexer fields are managed by the acquisition.
+    /// \param configuration The base configuration.
+    void set_configuration(const ads101x::configuration& configuration);
+    /// \brief Sets the variant of the device, which determines the conversion period of each data rate setting.
+    /// \details The conversion timer and the ALERT/RDY watchdog are derived from the variant's data rates. Defaults to
+    /// the ADS1015.
+    /// \param variant The device variant.
+    void set_variant(ads101x::variant variant);
+    /// \brief Sets the channels to acquire.
+    /// \details Continuous modes acquire the first channel. Single-shot mode cycles through all channels.
+    /// \param channels The multiplexer settings to acquire.
+    /// \exception std::runtime_error if no channels are provided.
+    void set_channels(const std::vector<ads101x::configuration::multiplexer>& channels);
+    /// \brief Sets the GPIO pin connected to ALERT/RDY.
+    /// \details Required for DATA_READY mode. In SINGLESHOT mode the conversion-ready edge replaces the conversion timer.
+    /// \param pin The GPIO pin.
+    void set_alert_rdy_pin(uint16_t pin);
+    /// \brief Sets the ALERT/RDY watchdog used to recover from stalled conversions.
+    /// \details When ALERT/RDY paces the acquisition, a missed edge or a device that stopped converting (e.g. after a
+    /// brown-out reset) would otherwise leave the thread waiting forever. With the watchdog armed, the driver reports
+    /// a stall once no edge has arrived for the given number of conversion periods, and the thread rewrites the
+    /// thresholds and configuration to restart conversions. Requires a driver that supports watchdogs.
+    /// \param periods The number of conversion periods without an edge that count as a stall, or zero to disable.
+    void set_watchdog(uint32_t periods);
+    /// \brief Sets the real-time profile applied to the acquisition thread when it starts.
+    /// \details Once started, the acquisition thread does not allocate memory, and only handles exceptions thrown by
+    /// the driver on bus errors. Sinks must not allocate either for this to hold.
+    /// \param profile The real-time profile.
+    void set_realtime(const ads101x::realtime_profile& profile);
+    /// \brief Sets a probe that is called on the acquisition thread as each conversion read starts.
+    /// \details The probe receives the time the conversion became ready (its ALERT/RDY edge when a pin is used,
+    /// otherwise its timer deadline) and the time the read started, both in CLOCK_MONOTONIC nanoseconds.
+    /// \param probe The probe, or nullptr to remove it. It must not block.
+    void set_timing_probe(std::function<void(uint64_t, uint64_t)> probe);
+    /// \brief Adds a sink that is called on the acquisition thread with every published block.
+    /// \param sink The sink to add. It must not block.
+    void add_sink(std::function<void(std::span<const ads101x::sample>)> sink);
+    /// \brief Adds a sink that is called on the acquisition thread with every sample as it is acquired.
+    /// \details Lets a consumer react to a single sample without waiting for its block to fill.
+    /// \param sink The sink to add. It must not block.
+    void add_sample_sink(std::function<void(const ads101x::sample&)> sink);
+    /// \brief Sets an event that is signalled each time a block is published.
+    /// \details Lets a single-threaded event loop poll for available samples, then drain them with a reader.
+    /// \param event The event, or nullptr to remove it. Must outlive the acquisition's thread.
+    void set_event(const ads101x::event* event);
+
+    // CONTROL
+    /// \brief Configures the device and starts the acquisition thread.
+    /// \details Returns once the thread has applied its real-time profile.
+    /// \exception std::runtime_error if the acquisition is already running or the device cannot be configured.
+    void start();
+    /// \brief Stops the acquisition thread, publishes any partial block, and powers down the device.
+    void stop();
+    /// \brief Indicates if the acquisition thread is running.
+    /// \return TRUE if running, otherwise FALSE.
+    bool running() const;
+
+    // STREAM
+    /// \brief Creates an independent reader of the sample stream, starting at the next published block.
+    /// \return The new reader.
+    ads101x::broadcast_ring<ads101x::sample>::reader subscribe() const;
+    /// \brief Gets the broadcast ring holding the sample stream.
+    /// \return The broadcast ring.
+    const ads101x::broadcast_ring<ads101x::sample>& ring() const;
+    /// \brief Gets the latest sample of a channel.
+    /// \details Each channel's latest sample, with its value, full-scale range, timestamp, and sequence number, is
+    /// published in a seqlock slot as it is acquired. Any number of threads can read it concurrently without locks or
+    /// system calls, and without slowing the acquisition thread.
+    /// \param channel The channel.
+    /// \param sample The sample to store the latest sample in.
+    /// \return TRUE if the channel has been sampled, otherwise FALSE.
+    bool latest(ads101x::configuration::multiplexer channel, ads101x::sample& sample) const;
+
+    // METRICS
+    /// \brief Gets the number of samples acquired.
+    /// \return The number of samples.
+    uint64_t samples() const;
+    /// \brief Gets the number of failed conversion reads.
+    /// \return The number of errors.
+    uint64_t errors() const;
+    /// \brief Gets the number of stalled conversions the acquisition recovered from.
+    /// \return The number of stalls.
+    uint64_t stalls() const;
+    /// \brief Gets the longest interval between consecutive conversion reads since the acquisition started.
+    /// \return The interval in nanoseconds.
+    uint64_t max_interval() const;
+    /// \brief Gets the real-time settings granted to the acquisition thread when it last started.
+    /// \return The granted settings.
+    ads101x::realtime_report realtime() const;
+
+private:
+    // THREAD
+    /// \brief The acquisition thread function.
+    void run();
+    /// \brief Waits for the next conversion to be ready, recovering from stalls.
+    /// \param deadline The conversion timer deadline, in CLOCK_MONOTONIC nanoseconds.
+    /// \param channel The channel being converted.
+    /// \return TRUE if a conversion is ready, FALSE if the acquisition is stopping.
+    bool wait_ready(uint64_t deadline, ads101x::configuration::multiplexer channel);
+    /// \brief Reconfigures the device to restart conversions after a stall.
+    /// \param channel The channel being converted.
+    void recover(ads101x::configuration::multiplexer channel);
+    /// \brief Reads one sample and appends it to the current block.
+    void acquire(ads101x::configuration::multiplexer channel);
+    /// \brief Publishes the current block and claims the next.
+    void publish();
+
+    // DRIVER
+    /// \brief The driver to acquire from.
+    ads101x::driver& m_driver;
+
+    // SETTINGS
+    /// \brief The acquisition mode.
+    acquisition::mode m_mode;
+    /// \brief The base configuration.
+    ads101x::configuration m_configuration;
+    /// \brief The device variant.
+    ads101x::variant m_variant;
+    /// \brief The channels to acquire.
+    std::vector<ads101x::configuration::multiplexer> m_channels;
+    /// \brief The ALERT/RDY pin, or -1 if not set.
+    int32_t m_alert_rdy_pin;
+    /// \brief The ALERT/RDY watchdog in conversion periods, or zero if disabled.
+    uint32_t m_watchdog;
+    /// \brief The block sinks.
+    std::vector<std::function<void(std::span<const ads101x::sample>)>> m_sinks;
+    /// \brief The sample sinks.
+    std::vector<std::function<void(const ads101x::sample&)>> m_sample_sinks;
+    /// \brief The event signalled on each published block, or nullptr.
+    const ads101x::event* m_event;
+    /// \brief The timing probe.
+    std::function<void(uint64_t, uint64_t)> m_timing_probe;
+    /// \brief The real-time profile of the acquisition thread.
+    ads101x::realtime_profile m_realtime_profile;
+
+    // THREAD
+    /// \brief The acquisition thread.
+    std::thread m_thread;
+    /// \brief Indicates if the acquisition thread should run.
+    std::atomic<bool> m_running;
+    /// \brief Counts conversion-ready edges not yet consumed.
+    std::atomic<uint32_t> m_ready;
+    /// \brief Set by the watchdog when conversions have stalled.
+    std::atomic<bool> m_stalled;
+    /// \brief The time the latest conversion became ready, in CLOCK_MONOTONIC nanoseconds.
+    std::atomic<uint64_t> m_ready_time;
+    /// \brief Set once the thread has applied its real-time profile.
+    std::atomic<bool> m_started;
+    /// \brief The real-time settings granted to the thread.
+    ads101x::realtime_report m_realtime_report;
+
+    // STREAM
+    /// \brief The broadcast ring holding the sample stream.
+    ads101x::broadcast_ring<ads101x::sample> m_ring;
+    /// \brief The block currently being filled.
+    std::span<ads101x::sample> m_block;
+    /// \brief The number of samples in the current block.
+    uint32_t m_block_fill;
+    /// \brief The latest sample of each channel, indexed by multiplexer setting.
+    std::array<ads101x::seqlock<ads101x::sample>, 8> m_latest;
+
+    // METRICS
+    /// \brief The number of samples acquired.
+    std::atomic<uint64_t> m_samples;
+    /// \brief The number of failed reads.
+    std::atomic<uint64_t> m_errors;
+    /// \brief The number of stalls recovered from.
+    std::atomic<uint64_t> m_stalls;
+    /// \brief The time of the last conversion read, in CLOCK_MONOTONIC nanoseconds.
+    uint64_t m_last_read;
+    /// \brief The longest interval between conversion reads.
+    std::atomic<uint64_t> m_max_interval;
+};
+
+}
+
+#endif
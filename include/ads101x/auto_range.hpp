@@ -0,0 +1,95 @@
+/// \file ads101x/auto_range.hpp
+/// \brief Defines the ads101x::auto_range class.
+#ifndef ADS101X___AUTO_RANGE_H
+#define ADS101X___AUTO_RANGE_H
+
+// ads101x
+#include <ads101x/driver.hpp>
+#include <ads101x/sample.hpp>
+
+namespace ads101x {
+
+/// \brief Selects the ADS101X full-scale range from the measured signal.
+/// \details Each processed conversion is tagged with the full-scale range that was active when it was taken. The
+/// range is widened as soon as a conversion reaches the upper threshold, and narrowed once the conversion would sit
+/// below the lower threshold of the next narrower range for a number of consecutive conversions. Range changes are
+/// held as pending until the next call to write_config(), so in single-shot operation they cost no extra I2C
+/// transactions.
+class auto_range
+{
+public:
+    // CONSTRUCTORS
+    /// \brief Creates a new auto-range controller.
+    /// \param configuration The initial configuration, including the starting full-scale range.
+    /// \param upper_threshold The fraction of full scale at or above which the range is widened.
+    /// \param lower_threshold The fraction of the next narrower full scale below which the range is narrowed.
+    /// \param dwell The number of consecutive conversions below the lower threshold required to narrow the range.
+    /// \exception std::runtime_error if the thresholds do not provide hysteresis or dwell is zero.
+    auto_range(const ads101x::configuration& configuration, float upper_threshold = 0.95f, float lower_threshold = 0.8f, uint32_t dwell = 4);
+
+    // LIMITS
+    /// \brief Sets the range of full-scale ranges that may be selected.
+    /// \param widest The widest full-scale range that may be selected.
+    /// \param narrowest The narrowest full-scale range that may be selected.
+    /// \exception std::runtime_error if widest is narrower than narrowest.
+    void set_limits(ads101x::configuration::fsr widest, ads101x::configuration::fsr narrowest);
+
+    // CONFIGURATION
+    /// \brief Gets the configuration that will be written by the next write_config().
+    /// \return The configuration, including any pending full-scale range change.
+    ads101x::configuration get_configuration() const;
+    /// \brief Replaces the managed configuration.
+    /// \details The full-scale range of the provided configuration becomes the pending range.
+    /// \param configuration The configuration to manage.
+    void set_configuration(const ads101x::configuration& configuration);
+    /// \brief Indicates if a full-scale range change is waiting for the next configuration write.
+    /// \return TRUE if a range change is pending, otherwise FALSE.
+    bool pending() const;
+    /// \brief Gets the full-scale range that new conversions are being taken at.
+    /// \return The active full-scale range.
+    ads101x::configuration::fsr active_fsr() const;
+
+    // CONVERSION
+    /// \brief Tags a conversion with the active full-scale range and updates the range selection.
+    /// \param conversion The 12-bit conversion value read from the ADS101X.
+    /// \return The conversion tagged with the full-scale range it was taken at.
+    ads101x::sample process(uint16_t conversion);
+
+    // DRIVER
+    /// \brief Writes the managed configuration, including any pending range change, to the ADS101X.
+    /// \param driver The driver to write the configuration with.
+    /// \exception std::runtime_error if the write command fails.
+    void write_config(const ads101x::driver& driver);
+    /// \brief Reads a conversion from the ADS101X and processes it.
+    /// \param driver The driver to read the conversion with.
+    /// \return The conversion tagged with the full-scale range it was taken at.
+    /// \exception std::runtime_error if the read command fails.
+    ads101x::sample read_conversion(const ads101x::driver& driver);
+
+private:
+    // CONFIGURATION
+    /// \brief The managed configuration, holding the pending full-scale range.
+    ads101x::configuration m_configuration;
+    /// \brief The full-scale range of the last configuration written to the ADS101X.
+    ads101x::configuration::fsr m_active_fsr;
+
+    // THRESHOLDS
+    /// \brief The conversion magnitude at or above which the range is widened.
+    int32_t m_upper_threshold;
+    /// \brief The fraction of the next narrower full scale below which the range is narrowed.
+    float m_lower_threshold;
+    /// \brief The number of consecutive under-range conversions required to narrow the range.
+    uint32_t m_dwell;
+    /// \brief The current number of consecutive under-range conversions.
+    uint32_t m_dwell_count;
+
+    // LIMITS
+    /// \brief The widest selectable full-scale range.
+    ads101x::configuration::fsr m_widest;
+    /// \brief The narrowest selectable full-scale range.
+    ads101x::configuration::fsr m_narrowest;
+};
+
+}
+
+#endif
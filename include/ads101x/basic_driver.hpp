@@ -0,0 +1,757 @@
+/// \file ads101x/basic_driver.hpp
+/// \brief Defines the ads101x::basic_driver class.
+#ifndef ADS101X___BASIC_DRIVER_H
+#define ADS101X___BASIC_DRIVER_H
+
+// ads101x
+#include <ads101x/address.hpp>
+#include <ads101x/clock.hpp>
+#include <ads101x/configuration.hpp>
+#include <ads101x/edge.hpp>
+#include <ads101x/event.hpp>
+#include <ads101x/timeout_error.hpp>
+#include <ads101x/variant.hpp>
+
+// std
+#include <atomic>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace ads101x {
+
+/// \brief A statically dispatched driver for interacting with the ADS101X analog to digital converter.
+/// \details The backend is the derived class (CRTP), and provides the following members, which are resolved at
+/// compile time and can therefore be inlined into the read path:
+/// - void open_i2c(uint32_t i2c_bus, uint8_t i2c_address)
+/// - void close_i2c()
+/// - void write_register(uint8_t register_address, uint16_t value) const
+/// - uint16_t read_register(uint8_t register_address) const
+/// - void read_registers(uint8_t register_address, std::span<uint16_t> values) const (optional)
+/// - void attach_interrupt(uint16_t pin) (optional)
+/// - void detach_interrupt(uint16_t pin) (optional)
+/// - void set_watchdog(uint16_t pin, uint32_t timeout_ms) (optional)
+///
+/// If the backend keeps these members non-public, it must declare ads101x::basic_driver<backend> a friend.
+///
+/// Register operations can be bounded by a deadline, either per call or with a default timeout. Operations that are
+/// not expected to complete by their deadline are not issued, and backends read operation_deadline() to bound their
+/// own waits and retries. The deadline in progress is kept per thread and the latency estimate is atomic, so threads
+/// sharing a driver each bound their own operations.
+/// \tparam backend The derived backend class.
+template<class backend>
+class basic_driver
+{
+public:
+    // CONSTRUCTORS
+    /// \brief Constructs a new driver instance.
+    basic_driver()
+        : m_alert_rdy_pin(0),
+          m_alert_rdy_callback(nullptr),
+          m_alert_rdy_batch_callback(nullptr),
+          m_alert_rdy_edge(ads101x::edge::BOTH),
+          m_alert_rdy_attached(false),
+          m_alert_rdy_timestamp(0),
+          m_alert_rdy_stall_callback(nullptr),
+          m_alert_rdy_watchdog(0),
+          m_timeout(0),
+          m_estimate(0)
+    {}
+
+    // CONTROL
+    /// \brief Starts the driver by opening I2C communication with the ADS101X.
+    /// \param i2c_bus The I2C bus to use for communication.
+    /// \param slave_address The slave address assigned to the ADS101X via its ADDR_PIN connection.
+    /// \exception std::runtime_error if the driver fails to open the I2C connection.
+    void start(uint32_t i2c_bus = 0, ads101x::slave_address slave_address = ads101x::slave_address::GND_PIN)
+    {
+        // Close I2C if necessary.
+        basic_driver::get_backend().close_i2c();
+
+        // Open I2C.
+        basic_driver::get_backend().open_i2c(i2c_bus, static_cast<uint8_t>(slave_address));
+    }
+    /// \brief Stops the driver by closing I2C communication with the ADS101X.
+    /// \exception std::runtime_error if the driver fails to close the I2C connection.
+    void stop()
+    {
+        // Close I2C.
+        basic_driver::get_backend().close_i2c();
+    }
+
+    // CONFIGURATION
+    /// \brief Writes a configuration to the ADS101X.
+    /// \param configuration The configuration to write.
+    /// \exception std::runtime_error if the write command fails.
+    void write_config(const ads101x::configuration& configuration) const
+    {
+        basic_driver::write_config(configuration, 0);
+    }
+    /// \brief Writes a configuration to the ADS101X by a deadline.
+    /// \param configuration The configuration to write.
+    /// \param deadline_ns The CLOCK_MONOTONIC deadline in nanoseconds, or zero to apply the default timeout.
+    /// \exception ads101x::timeout_error if the write cannot complete by the deadline.
+    /// \exception std::runtime_error if the write command fails.
+    void write_config(const ads101x::configuration& configuration, uint64_t deadline_ns) const
+    {
+        // Write the configuration bitfield to the config register.
+        basic_driver::bounded(deadline_ns, [&] { basic_driver::get_backend().write_register(static_cast<uint8_t>(ads101x::register_address::CONFIG), configuration.bitfield()); });
+    }
+    /// \brief Reads the configuration from the ADS101X.
+    /// \return The current configuration stored on the ADS101X.
+    /// \exception std::runtime_error if the read command fails.
+    ads101x::configuration read_config() const
+    {
+        return basic_driver::read_config(0);
+    }
+    /// \brief Reads the configuration from the ADS101X by a deadline.
+    /// \param deadline_ns The CLOCK_MONOTONIC deadline in nanoseconds, or zero to apply the default timeout.
+    /// \return The current configuration stored on the ADS101X.
+    /// \exception ads101x::timeout_error if the read cannot complete by the deadline.
+    /// \exception std::runtime_error if the read command fails.
+    ads101x::configuration read_config(uint64_t deadline_ns) const
+    {
+        // Read the config register and return a new configuration instance.
+        return ads101x::configuration(basic_driver::bounded(deadline_ns, [&] { return basic_driver::get_backend().read_register(static_cast<uint8_t>(ads101x::register_address::CONFIG)); }));
+    }
+
+    // CONVERSION
+    /// \brief Reads the conversion value from the ADS101X.
+    /// \return The 12bit conversion value.
+    /// \exception std::runtime_error if the read command fails.
+    uint16_t read_conversion() const
+    {
+        return basic_driver::read_conversion<ads101x::variant::ADS1015>();
+    }
+    /// \brief Reads the conversion value from the ADS101X by a deadline.
+    /// \param deadline_ns The CLOCK_MONOTONIC deadline in nanoseconds, or zero to apply the default timeout.
+    /// \return The 12bit conversion value.
+    /// \exception ads101x::timeout_error if the read cannot complete by the deadline.
+    /// \exception std::runtime_error if the read command fails.
+    uint16_t read_conversion(uint64_t deadline_ns) const
+    {
+        return register_traits::code(basic_driver::bounded(deadline_ns, [&] { return basic_driver::get_backend().read_register(static_cast<uint8_t>(ads101x::register_address::CONVERSION)); }));
+    }
+    /// \brief Reads a block of conversion values from the ADS101X back to back.
+    /// \details The whole block is read by the backend in one call, which lets it batch the bus transactions and
+    /// costs a single dispatch and error check instead of one per value. Values are read as fast as the bus allows,
+    /// so consecutive values repeat the same conversion if the block is read faster than the data rate. Only the
+    /// default timeout bounds the block, since a deadline overload would be ambiguous with the periodic form.
+    /// \param conversions The caller-owned buffer to fill with 12bit conversion values.
+    /// \exception std::runtime_error if a read command fails.
+    void read_conversions(std::span<uint16_t> conversions) const
+    {
+        basic_driver::read_conversions<ads101x::variant::ADS1015>(conversions);
+    }
+    /// \brief Reads a block of conversion values from the ADS101X at a fixed period.
+    /// \details Reads are scheduled on absolute CLOCK_MONOTONIC deadlines, starting immediately, so the period does
+    /// not drift. Nothing is allocated, making this suitable for high-rate logging into preallocated buffers. The
+    /// default timeout bounds each read rather than the whole block.
+    /// \param conversions The caller-owned buffer to fill with 12bit conversion values.
+    /// \param period_ns The period between reads in nanoseconds, typically the conversion period of the data rate.
+    /// \param timestamps An optional caller-owned buffer to fill with the CLOCK_MONOTONIC time each read completed.
+    /// Must be empty or the same size as the conversion buffer.
+    /// \exception std::runtime_error if the timestamp buffer is invalid or a read command fails.
+    void read_conversions(std::span<uint16_t> conversions, uint64_t period_ns, std::span<uint64_t> timestamps = {}) const
+    {
+        basic_driver::read_conversions<ads101x::variant::ADS1015>(conversions, period_ns, timestamps);
+    }
+
+    // THRESHOLDS
+    /// \brief Writes a comparator low threshold value to the ADS101X.
+    /// \param value The 12-bit low threshold value to write.
+    /// \exception std::runtime_error if the write command fails.
+    void write_lo_thresh(uint16_t value) const
+    {
+        basic_driver::write_lo_thresh(value, 0);
+    }
+    /// \brief Writes a comparator low threshold value to the ADS101X by a deadline.
+    /// \param value The 12-bit low threshold value to write.
+    /// \param deadline_ns The CLOCK_MONOTONIC deadline in nanoseconds, or zero to apply the default timeout.
+    /// \exception ads101x::timeout_error if the write cannot complete by the deadline.
+    /// \exception std::runtime_error if the write command fails.
+    void write_lo_thresh(uint16_t value, uint64_t deadline_ns) const
+    {
+        basic_driver::bounded(deadline_ns, [&] { basic_driver::get_backend().write_register(static_cast<uint8_t>(ads101x::register_address::LO_THRESH), register_traits::encode(value)); });
+    }
+    /// \brief Reads the comparator low threshold value from the ADS101X.
+    /// \return The current 12-bit low threshold value.
+    /// \exception std::runtime error if the read command fails.
+    uint16_t read_lo_thresh() const
+    {
+        return basic_driver::read_lo_thresh(0);
+    }
+    /// \brief Reads the comparator low threshold value from the ADS101X by a deadline.
+    /// \param deadline_ns The CLOCK_MONOTONIC deadline in nanoseconds, or zero to apply the default timeout.
+    /// \return The current 12-bit low threshold value.
+    /// \exception ads101x::timeout_error if the read cannot complete by the deadline.
+    /// \exception std::runtime error if the read command fails.
+    uint16_t read_lo_thresh(uint64_t deadline_ns) const
+    {
+        // Threshold is stored as 12bit at MSB. Shift right.
+        return register_traits::code(basic_driver::bounded(deadline_ns, [&] { return basic_driver::get_backend().read_register(static_cast<uint8_t>(ads101x::register_address::LO_THRESH)); }));
+    }
+    /// \brief Writes a comparator high threshold value to the ADS101X.
+    /// \param value The 12-bit high threshold value to write.
+    /// \exception std::runtime_error if the write command fails.
+    void write_hi_thresh(uint16_t value) const
+    {
+        basic_driver::write_hi_thresh(value, 0);
+    }
+    /// \brief Writes a comparator high threshold value to the ADS101X by a deadline.
+    /// \param value The 12-bit high threshold value to write.
+    /// \param deadline_ns The CLOCK_MONOTONIC deadline in nanoseconds, or zero to apply the default timeout.
+    /// \exception ads101x::timeout_error if the write cannot complete by the deadline.
+    /// \exception std::runtime_error if the write command fails.
+    void write_hi_thresh(uint16_t value, uint64_t deadline_ns) const
+    {
+        basic_driver::bounded(deadline_ns, [&] { basic_driver::get_backend().write_register(static_cast<uint8_t>(ads101x::register_address::HI_THRESH), register_traits::encode(value)); });
+    }
+    /// \brief Reads the comparator high threshold value from the ADS101X.
+    /// \return The current 12-bit high threshold value.
+    /// \exception std::runtime error if the read command fails.
+    uint16_t read_hi_thresh() const
+    {
+        return basic_driver::read_hi_thresh(0);
+    }
+    /// \brief Reads the comparator high threshold value from the ADS101X by a deadline.
+    /// \param deadline_ns The CLOCK_MONOTONIC deadline in nanoseconds, or zero to apply the default timeout.
+    /// \return The current 12-bit high threshold value.
+    /// \exception ads101x::timeout_error if the read cannot complete by the deadline.
+    /// \exception std::runtime error if the read command fails.
+    uint16_t read_hi_thresh(uint64_t deadline_ns) const
+    {
+        // Threshold is stored as 12bit at MSB. Shift right.
+        return register_traits::code(basic_driver::bounded(deadline_ns, [&] { return basic_driver::get_backend().read_register(static_cast<uint8_t>(ads101x::register_address::HI_THRESH)); }));
+    }
+
+    // VARIANTS
+    /// \brief Writes a variant-checked configuration to the device.
+    /// \tparam V The device variant.
+    /// \param configuration The configuration to write.
+    /// \exception std::runtime_error if the write command fails.
+    template<ads101x::variant V>
+    void write_config(const ads101x::variant_configuration<V>& configuration) const
+    {
+        basic_driver::write_config(configuration.get());
+    }
+    /// \brief Reads the conversion value from a device variant.
+    /// \details The register shift is a compile-time constant of the variant, so the same code path serves the
+    /// 12-bit ADS101X and the 16-bit ADS111X without a runtime branch.
+    /// \tparam V The device variant.
+    /// \return The right aligned conversion code at the variant's resolution.
+    /// \exception std::runtime_error if the read command fails.
+    template<ads101x::variant V>
+    uint16_t read_conversion() const
+    {
+        return ads101x::traits<V>::code(basic_driver::bounded(0, [&] { return basic_driver::get_backend().read_register(static_cast<uint8_t>(ads101x::register_address::CONVERSION)); }));
+    }
+    /// \brief Reads a block of conversion values from a device variant back to back.
+    /// \tparam V The device variant.
+    /// \param conversions The caller-owned buffer to fill with right aligned conversion codes.
+    /// \exception std::runtime_error if a read command fails.
+    template<ads101x::variant V>
+    void read_conversions(std::span<uint16_t> conversions) const
+    {
+        // Read the raw register values into the caller's buffer. The default timeout bounds the whole block, and the
+        // latency is accounted per value so the estimate stays comparable with single register operations.
+        basic_driver::bounded(0, [&] { basic_driver::get_backend().read_registers(static_cast<uint8_t>(ads101x::register_address::CONVERSION), conversions); }, conversions.size());
+
+        // Right align the codes in place.
+        for(auto& conversion : conversions)
+        {
+            conversion = ads101x::traits<V>::code(conversion);
+        }
+    }
+    /// \brief Reads a block of conversion values from a device variant at a fixed period.
+    /// \tparam V The device variant.
+    /// \param conversions The caller-owned buffer to fill with right aligned conversion codes.
+    /// \param period_ns The period between reads in nanoseconds.
+    /// \param timestamps An optional caller-owned buffer to fill with the CLOCK_MONOTONIC time each read completed.
+    /// \exception std::runtime_error if the timestamp buffer is invalid or a read command fails.
+    template<ads101x::variant V>
+    void read_conversions(std::span<uint16_t> conversions, uint64_t period_ns, std::span<uint64_t> timestamps = {}) const
+    {
+        // Verify the timestamp buffer.
+        if(!timestamps.empty() && timestamps.size() != conversions.size())
+        {
+            throw std::runtime_error("timestamp buffer size does not match conversion buffer size");
+        }
+
+        // Read each value on its deadline.
+        uint64_t deadline = ads101x::monotonic_ns();
+        for(size_t i = 0; i < conversions.size(); ++i)
+        {
+            ads101x::sleep_until_ns(deadline);
+            conversions[i] = ads101x::traits<V>::code(basic_driver::bounded(0, [&] { return basic_driver::get_backend().read_register(static_cast<uint8_t>(ads101x::register_address::CONVERSION)); }));
+            if(!timestamps.empty())
+            {
+                timestamps[i] = ads101x::monotonic_ns();
+            }
+            deadline += period_ns;
+        }
+    }
+    /// \brief Writes a comparator low threshold value to a device variant.
+    /// \tparam V The device variant. Must have a comparator.
+    /// \param value The right aligned threshold code at the variant's resolution.
+    /// \exception std::runtime_error if the write command fails.
+    template<ads101x::variant V>
+    void write_lo_thresh(uint16_t value) const
+    {
+        static_assert(ads101x::traits<V>::has_comparator, "variant does not have a comparator");
+        basic_driver::bounded(0, [&] { basic_driver::get_backend().write_register(static_cast<uint8_t>(ads101x::register_address::LO_THRESH), ads101x::traits<V>::encode(value)); });
+    }
+    /// \brief Writes a comparator high threshold value to a device variant.
+    /// \tparam V The device variant. Must have a comparator.
+    /// \param value The right aligned threshold code at the variant's resolution.
+    /// \exception std::runtime_error if the write command fails.
+    template<ads101x::variant V>
+    void write_hi_thresh(uint16_t value) const
+    {
+        static_assert(ads101x::traits<V>::has_comparator, "variant does not have a comparator");
+        basic_driver::bounded(0, [&] { basic_driver::get_backend().write_register(static_cast<uint8_t>(ads101x::register_address::HI_THRESH), ads101x::traits<V>::encode(value)); });
+    }
+    /// \brief Reads the comparator low threshold value from a device variant.
+    /// \tparam V The device variant. Must have a comparator.
+    /// \return The right aligned threshold code at the variant's resolution.
+    /// \exception std::runtime_error if the read command fails.
+    template<ads101x::variant V>
+    uint16_t read_lo_thresh() const
+    {
+        static_assert(ads101x::traits<V>::has_comparator, "variant does not have a comparator");
+        return ads101x::traits<V>::code(basic_driver::bounded(0, [&] { return basic_driver::get_backend().read_register(static_cast<uint8_t>(ads101x::register_address::LO_THRESH)); }));
+    }
+    /// \brief Reads the comparator high threshold value from a device variant.
+    /// \tparam V The device variant. Must have a comparator.
+    /// \return The right aligned threshold code at the variant's resolution.
+    /// \exception std::runtime_error if the read command fails.
+    template<ads101x::variant V>
+    uint16_t read_hi_thresh() const
+    {
+        static_assert(ads101x::traits<V>::has_comparator, "variant does not have a comparator");
+        return ads101x::traits<V>::code(basic_driver::bounded(0, [&] { return basic_driver::get_backend().read_register(static_cast<uint8_t>(ads101x::register_address::HI_THRESH)); }));
+    }
+
+    // DEADLINES
+    /// \brief Sets the default timeout of register operations that are called without a deadline.
+    /// \details A stuck bus or daemon then fails the operation with ads101x::timeout_error instead of blocking the
+    /// caller indefinitely. Operations that are not expected to complete within the timeout, based on the recent
+    /// latency of bounded operations, fail without being issued.
+    /// \param timeout_ns The timeout in nanoseconds, or zero to leave operations unbounded.
+    void set_timeout(uint64_t timeout_ns)
+    {
+        basic_driver::m_timeout = timeout_ns;
+    }
+    /// \brief Gets the default timeout of register operations that are called without a deadline.
+    /// \return The timeout in nanoseconds, or zero if operations are unbounded.
+    uint64_t get_timeout() const
+    {
+        return basic_driver::m_timeout;
+    }
+
+    // ALERT_RDY
+    /// \brief Attaches to an ALERT_RDY notification using a callback.
+    /// \details Subscribing to a single edge, e.g. the asserting edge of conversion-ready pulses, halves the number
+    /// of callbacks. Backends filter in the kernel or daemon where they can, so the unwanted edges cost no wakeups.
+    /// \param pin The GPIO pin that is attached to the ADS101X ALERT_RDY pin.
+    /// \param callback The callback to raise when the ALERT_RDY pin changes state.
+    /// \param edge The edges to raise the callback for.
+    /// \exception std::runtime_error if attach operation fails.
+    void attach_alert_rdy(uint16_t pin, std::function<void(bool)> callback, ads101x::edge edge = ads101x::edge::BOTH)
+    {
+        // Verify callback.
+        if(!callback)
+        {
+            throw std::runtime_error("alert_rdy callback is invalid");
+        }
+
+        // Attach the interrupt.
+        basic_driver::attach(pin, edge);
+
+        // Store callback, and flag alert_rdy as attached.
+        basic_driver::m_alert_rdy_callback = callback;
+        basic_driver::m_alert_rdy_attached = true;
+    }
+    /// \brief Attaches to an ALERT_RDY notification using a callback that receives edges in batches.
+    /// \details Backends that receive several edges at once, such as from the kernel or a notification pipe, deliver
+    /// them in a single call, letting the consumer amortize its per-call overhead. Other backends deliver batches of
+    /// one edge.
+    /// \param pin The GPIO pin that is attached to the ADS101X ALERT_RDY pin.
+    /// \param callback The callback to raise with each batch of edges, in the order they occurred.
+    /// \param edge The edges to deliver.
+    /// \exception std::runtime_error if attach operation fails.
+    void attach_alert_rdy_batch(uint16_t pin, std::function<void(std::span<const ads101x::edge_event>)> callback, ads101x::edge edge = ads101x::edge::BOTH)
+    {
+        // Verify callback.
+        if(!callback)
+        {
+            throw std::runtime_error("alert_rdy callback is invalid");
+        }
+
+        // Attach the interrupt.
+        basic_driver::attach(pin, edge);
+
+        // Store callback, and flag alert_rdy as attached.
+        basic_driver::m_alert_rdy_batch_callback = callback;
+        basic_driver::m_alert_rdy_attached = true;
+    }
+    /// \brief Attaches to an ALERT_RDY notification using a pollable event.
+    /// \details The event is signalled on every edge to the given level, so an event loop can poll its descriptor
+    /// instead of handling callbacks on the backend's thread. The event counter accumulates the number of edges.
+    /// \param pin The GPIO pin that is attached to the ADS101X ALERT_RDY pin.
+    /// \param event The event to signal. Must outlive the attachment.
+    /// \param level The level whose edges signal the event, e.g. FALSE for active-low conversion-ready pulses.
+    /// \exception std::runtime_error if attach operation fails.
+    void attach_alert_rdy(uint16_t pin, const ads101x::event& event, bool level)
+    {
+        basic_driver::attach_alert_rdy(pin, [&event](bool) { event.signal(); }, level ? ads101x::edge::RISING : ads101x::edge::FALLING);
+    }
+    /// \brief Gets the time of the ALERT_RDY edge currently being delivered.
+    /// \details Backends that timestamp edges where they are detected, such as in the kernel, report that time.
+    /// Otherwise this is the time the edge was raised to the callback. Only valid inside the ALERT_RDY callback.
+    /// \return The CLOCK_MONOTONIC time of the edge in nanoseconds.
+    uint64_t alert_rdy_timestamp() const
+    {
+        return basic_driver::m_alert_rdy_timestamp;
+    }
+    /// \brief Arms a watchdog on the attached ALERT_RDY pin.
+    /// \details The stall callback is raised when no edge has been detected for the timeout, and again after each
+    /// further timeout without an edge, so a conversion-ready signal that stops can be recovered instead of waited on
+    /// forever. Backends time the watchdog where edges are detected, such as in pigpio or the kernel poll. Use
+    /// ads101x::traits::watchdog_timeout_ms() to derive the timeout from the data rate. The watchdog is disarmed on
+    /// detach.
+    /// \param timeout_ms The timeout in milliseconds, or zero to disarm the watchdog.
+    /// \param stall The callback to raise when the timeout expires.
+    /// \exception std::runtime_error if ALERT_RDY is not attached, or the backend does not support watchdogs.
+    void set_alert_rdy_watchdog(uint32_t timeout_ms, std::function<void()> stall)
+    {
+        // Verify attached and callback.
+        if(!basic_driver::m_alert_rdy_attached)
+        {
+            throw std::runtime_error("alert_rdy is not attached");
+        }
+        if(timeout_ms != 0 && !stall)
+        {
+            throw std::runtime_error("alert_rdy stall callback is invalid");
+        }
+
+        // Store the callback, and try to arm the backend watchdog.
+        basic_driver::m_alert_rdy_stall_callback = (timeout_ms != 0) ? stall : nullptr;
+        basic_driver::get_backend().set_watchdog(basic_driver::m_alert_rdy_pin, timeout_ms);
+        basic_driver::m_alert_rdy_watchdog = timeout_ms;
+    }
+    /// \brief Detaches from the ALERT_RDY notification.
+    /// \exception std::runtime_error if the detach operation fails.
+    void detach_alert_rdy()
+    {
+        // Check if attached.
+        if(!basic_driver::m_alert_rdy_attached)
+        {
+            // Not attached, quit.
+            return;
+        }
+
+        // Disarm the watchdog.
+        if(basic_driver::m_alert_rdy_watchdog != 0)
+        {
+            basic_driver::get_backend().set_watchdog(basic_driver::m_alert_rdy_pin, 0);
+            basic_driver::m_alert_rdy_watchdog = 0;
+            basic_driver::m_alert_rdy_stall_callback = nullptr;
+        }
+
+        // Detach the interrupt.
+        basic_driver::get_backend().detach_interrupt(basic_driver::m_alert_rdy_pin);
+
+        // Reset pin and callbacks.
+        basic_driver::m_alert_rdy_pin = 0;
+        basic_driver::m_alert_rdy_callback = nullptr;
+        basic_driver::m_alert_rdy_batch_callback = nullptr;
+        basic_driver::m_alert_rdy_edge = ads101x::edge::BOTH;
+
+        // Flag alert_rdy as not attached.
+        basic_driver::m_alert_rdy_attached = false;
+    }
+
+protected:
+    // I2C
+    /// \brief Default block read for backends that do not batch register reads.
+    /// \param register_address The address of the register to read.
+    /// \param values The buffer to fill with consecutive reads of the register.
+    /// \exception std::runtime_error if a read fails.
+    void read_registers(uint8_t register_address, std::span<uint16_t> values) const
+    {
+        // Read each value individually.
+        for(auto& value : values)
+        {
+            value = basic_driver::get_backend().read_register(register_address);
+        }
+    }
+
+    // DEADLINES
+    /// \brief Gets the deadline of the register operation in progress.
+    /// \details Backends read this inside their register functions to bound waits and retries, and throw
+    /// ads101x::timeout_error once it has passed.
+    /// \return The CLOCK_MONOTONIC deadline in nanoseconds, or zero if the operation is unbounded.
+    uint64_t operation_deadline() const
+    {
+        return basic_driver::current_deadline();
+    }
+
+    // ALERT_RDY
+    /// \brief Default interrupt attachment for backends that do not support interrupts.
+    /// \param pin The GPIO pin to attach the interrupt to.
+    /// \exception std::runtime_error always.
+    void attach_interrupt(uint16_t pin)
+    {
+        // Default / non-overridden function does not support interrupts.
+        throw std::runtime_error("driver does not support interrupts");
+    }
+    /// \brief Default interrupt detachment for backends that do not support interrupts.
+    /// \param pin The GPIO pin to detach the interrupt from.
+    void detach_interrupt(uint16_t pin)
+    {
+        // Default / non-overriden function does nothing.
+    }
+    /// \brief Default watchdog for backends that do not support watchdogs.
+    /// \param pin The GPIO pin to watch.
+    /// \param timeout_ms The timeout in milliseconds, or zero to disarm the watchdog.
+    /// \exception std::runtime_error unless disarming.
+    void set_watchdog(uint16_t pin, uint32_t timeout_ms)
+    {
+        // Default / non-overridden function does not support watchdogs.
+        if(timeout_ms != 0)
+        {
+            throw std::runtime_error("driver does not support watchdogs");
+        }
+    }
+    /// \brief Gets the edges the current ALERT_RDY attachment subscribes to.
+    /// \details Backends read this in attach_interrupt() to filter edges at the source. Edges that are not filtered
+    /// there are dropped by raise_interrupt().
+    /// \return The subscribed edges.
+    ads101x::edge alert_rdy_edge() const
+    {
+        return basic_driver::m_alert_rdy_edge;
+    }
+    /// \brief Raises an interrupt for a GPIO pin state-change.
+    /// \param pin The GPIO pin that has changed state.
+    /// \param level The new level of the GPIO pin.
+    /// \param timestamp The CLOCK_MONOTONIC time the edge was detected in nanoseconds, or zero to use the current time.
+    void raise_interrupt(uint16_t pin, bool level, uint64_t timestamp = 0)
+    {
+        // Validate alert_rdy attached and pin before reading the clock.
+        if(!basic_driver::m_alert_rdy_attached || pin != basic_driver::m_alert_rdy_pin)
+        {
+            return;
+        }
+
+        // Raise as a batch of one edge.
+        ads101x::edge_event event = {level, (timestamp != 0) ? timestamp : ads101x::monotonic_ns()};
+        basic_driver::raise_interrupts(pin, std::span<ads101x::edge_event>(&event, 1));
+    }
+    /// \brief Raises a batch of interrupts for a GPIO pin.
+    /// \details Edges that the attachment does not subscribe to are removed from the batch in place.
+    /// \param pin The GPIO pin that has changed state.
+    /// \param events The edges, in the order they occurred.
+    void raise_interrupts(uint16_t pin, std::span<ads101x::edge_event> events)
+    {
+        // Validate alert_rdy attached and pin.
+        if(!basic_driver::m_alert_rdy_attached || pin != basic_driver::m_alert_rdy_pin)
+        {
+            return;
+        }
+
+        // Remove unsubscribed edges.
+        if(basic_driver::m_alert_rdy_edge != ads101x::edge::BOTH)
+        {
+            bool level = basic_driver::m_alert_rdy_edge == ads101x::edge::RISING;
+            size_t count = 0;
+            for(const auto& event : events)
+            {
+                if(event.level == level)
+                {
+                    events[count++] = event;
+                }
+            }
+            events = events.first(count);
+        }
+        if(events.empty())
+        {
+            return;
+        }
+
+        // Raise the batch callback, or the alert_rdy callback for each edge.
+        if(basic_driver::m_alert_rdy_batch_callback)
+        {
+            basic_driver::m_alert_rdy_batch_callback(events);
+        }
+        else if(basic_driver::m_alert_rdy_callback)
+        {
+            for(const auto& event : events)
+            {
+                // Store the edge time for the callback.
+                basic_driver::m_alert_rdy_timestamp = event.timestamp;
+                basic_driver::m_alert_rdy_callback(event.level);
+            }
+        }
+    }
+
+    /// \brief Raises a watchdog timeout for a GPIO pin.
+    /// \param pin The GPIO pin that has not changed state for the watchdog timeout.
+    void raise_stall(uint16_t pin)
+    {
+        // Validate alert_rdy attached, pin, and callback.
+        if(!basic_driver::m_alert_rdy_attached || pin != basic_driver::m_alert_rdy_pin || !basic_driver::m_alert_rdy_stall_callback)
+        {
+            return;
+        }
+
+        // Raise the stall callback.
+        basic_driver::m_alert_rdy_stall_callback();
+    }
+
+private:
+    // BACKEND
+    /// \brief The register layout shared by the 12-bit ADS101X variants.
+    typedef ads101x::traits<ads101x::variant::ADS1015> register_traits;
+    /// \brief Gets the backend of this driver.
+    backend& get_backend()
+    {
+        return static_cast<backend&>(*this);
+    }
+    /// \brief Gets the backend of this driver.
+    const backend& get_backend() const
+    {
+        return static_cast<const backend&>(*this);
+    }
+
+    // DEADLINES
+    /// \brief Executes a register operation by a deadline.
+    /// \param deadline The CLOCK_MONOTONIC deadline in nanoseconds, or zero to apply the default timeout.
+    /// \param operation The operation to execute.
+    /// \param transactions The number of register transactions the operation performs.
+    /// \return The result of the operation.
+    /// \exception ads101x::timeout_error if the operation is not expected to complete by the deadline.
+    template<class function>
+    auto bounded(uint64_t deadline, function&& operation, uint64_t transactions = 1) const
+    {
+        // Apply the default timeout, and take the fast path when the operation is unbounded.
+        if(deadline == 0)
+        {
+            if(basic_driver::m_timeout == 0)
+            {
+                return operation();
+            }
+            deadline = ads101x::monotonic_ns() + basic_driver::m_timeout;
+        }
+
+        // Refuse to issue an operation that is not expected to complete by the deadline. The estimate is the latency
+        // of a single transaction, so block reads and single register operations are judged alike. Each refusal
+        // shrinks the estimate, so a bus that has recovered is eventually measured again.
+        uint64_t start = ads101x::monotonic_ns();
+        uint64_t estimate = basic_driver::m_estimate.load(std::memory_order_relaxed);
+        if(start + estimate * transactions > deadline)
+        {
+            basic_driver::m_estimate.store(estimate - estimate / 8, std::memory_order_relaxed);
+            throw ads101x::timeout_error("deadline expires before the operation can complete");
+        }
+
+        // Execute the operation with its deadline visible to the backend on this thread, and fold its latency into
+        // the estimate.
+        uint64_t& current = basic_driver::current_deadline();
+        uint64_t previous = current;
+        current = deadline;
+        try
+        {
+            if constexpr(std::is_void_v<decltype(operation())>)
+            {
+                operation();
+                current = previous;
+                basic_driver::complete(start, transactions);
+            }
+            else
+            {
+                auto result = operation();
+                current = previous;
+                basic_driver::complete(start, transactions);
+                return result;
+            }
+        }
+        catch(...)
+        {
+            current = previous;
+            throw;
+        }
+    }
+    /// \brief Completes a bounded register operation.
+    /// \param start The CLOCK_MONOTONIC time the operation was issued in nanoseconds.
+    /// \param transactions The number of register transactions the operation performed.
+    void complete(uint64_t start, uint64_t transactions) const
+    {
+        // Update the moving average of the latency per transaction. Concurrent updates may drop a sample, which only
+        // slows the average.
+        uint64_t latency = (ads101x::monotonic_ns() - start) / (transactions ? transactions : 1);
+        uint64_t estimate = basic_driver::m_estimate.load(std::memory_order_relaxed);
+        basic_driver::m_estimate.store((7 * estimate + latency) / 8, std::memory_order_relaxed);
+    }
+    /// \brief Gets the deadline of the register operation in progress on the calling thread.
+    /// \details The deadline is per thread, so threads sharing a driver each bound their own operations.
+    /// \return The deadline, or zero if no bounded operation is in progress.
+    static uint64_t& current_deadline()
+    {
+        thread_local uint64_t deadline = 0;
+        return deadline;
+    }
+
+    // ALERT_RDY
+    /// \brief Attaches the backend interrupt for a new ALERT_RDY attachment.
+    /// \details The caller stores its callback and then flags alert_rdy as attached.
+    /// \param pin The GPIO pin that is attached to the ADS101X ALERT_RDY pin.
+    /// \param edge The edges to subscribe to.
+    void attach(uint16_t pin, ads101x::edge edge)
+    {
+        // Detach any prior attachment.
+        basic_driver::detach_alert_rdy();
+
+        // Try to attach interrupt, letting the backend filter the subscribed edges.
+        basic_driver::m_alert_rdy_edge = edge;
+        try
+        {
+            basic_driver::get_backend().attach_interrupt(pin);
+        }
+        catch(...)
+        {
+            basic_driver::m_alert_rdy_edge = ads101x::edge::BOTH;
+            throw;
+        }
+
+        // Store pin.
+        basic_driver::m_alert_rdy_pin = pin;
+    }
+    /// \brief The GPIO pin connected to the ADS101X ALERT_RDY pin.
+    uint32_t m_alert_rdy_pin;
+    /// \brief The user callback for ALERT_RDY state-change interrupts.
+    std::function<void(bool)> m_alert_rdy_callback;
+    /// \brief The user callback for batches of ALERT_RDY edges.
+    std::function<void(std::span<const ads101x::edge_event>)> m_alert_rdy_batch_callback;
+    /// \brief The ALERT_RDY edges subscribed to.
+    ads101x::edge m_alert_rdy_edge;
+    /// \brief Indicates if the alert_rdy interrupt is attached.
+    bool m_alert_rdy_attached;
+    /// \brief The time of the ALERT_RDY edge being delivered.
+    uint64_t m_alert_rdy_timestamp;
+    /// \brief The user callback for ALERT_RDY watchdog timeouts.
+    std::function<void()> m_alert_rdy_stall_callback;
+    /// \brief The ALERT_RDY watchdog timeout in milliseconds, or zero if disarmed.
+    uint32_t m_alert_rdy_watchdog;
+
+    // DEADLINES
+    /// \brief The default timeout of register operations in nanoseconds, or zero if unbounded.
+    uint64_t m_timeout;
+    /// \brief The moving average latency of a register transaction in bounded operations, in nanoseconds.
+    mutable std::atomic<uint64_t> m_estimate;
+};
+
+}
+
+#endif
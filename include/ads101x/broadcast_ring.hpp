@@ -0,0 +1,276 @@
+/// \file ads101x/broadcast_ring.hpp
+/// \brief Defines the ads101x::broadcast_ring class.
+#ifndef ADS101X___BROADCAST_RING_H
+#define ADS101X___BROADCAST_RING_H
+
+// std
+#include <atomic>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <stdint.h>
+#include <vector>
+
+namespace ads101x {
+
+/// \brief A single-writer, multiple-reader ring of fixed-size blocks.
+/// \details The writer fills blocks in place and publishes them without ever waiting for readers. Each reader keeps its
+/// own cursor and receives read-only views directly into the ring, so no data is copied. A reader that falls more
+/// than the ring's capacity behind skips ahead to the oldest intact block and counts the blocks it lost as overruns,
+/// leaving the writer and all other readers unaffected. Each block carries a sequence number, in the manner of a
+/// seqlock, so a reader can verify that a block it was viewing was not overwritten while in use.
+/// \tparam T The trivially copyable element type.
+template<typename T>
+class broadcast_ring
+{
+public:
+    // CONSTRUCTORS
+    /// \brief Creates a new broadcast ring.
+    /// \param block_count The number of blocks in the ring.
+    /// \param block_size The number of elements in each block.
+    /// \exception std::runtime_error if the block count or size is zero.
+    broadcast_ring(uint32_t block_count, uint32_t block_size)
+        : m_block_count(block_count),
+          m_block_size(block_size),
+          m_data(static_cast<size_t>(block_count) * block_size),
+          m_blocks(new broadcast_ring::block[block_count]),
+          m_published(0),
+          m_generation(0),
+          m_closed(false)
+    {
+        if(block_count == 0 || block_size == 0)
+        {
+            throw std::runtime_error("broadcast_ring must have at least one block of one element");
+        }
+    }
+
+    // PROPERTIES
+    /// \brief Gets the number of blocks in the ring.
+    /// \return The number of blocks.
+    uint32_t block_count() const
+    {
+        return broadcast_ring::m_block_count;
+    }
+    /// \brief Gets the number of elements in each block.
+    /// \return The number of elements.
+    uint32_t block_size() const
+    {
+        return broadcast_ring::m_block_size;
+    }
+    /// \brief Gets the number of blocks published since creation.
+    /// \return The number of published blocks.
+    uint64_t published() const
+    {
+        return broadcast_ring::m_published.load(std::memory_order_acquire);
+    }
+
+    // WRITER
+    /// \brief Touches every page of the ring so that no page faults occur once writing starts.
+    /// \details Contents are left unchanged, so readers are unaffected. Must only be called by the writer.
+    void prefault()
+    {
+        volatile uint8_t* data = reinterpret_cast<volatile uint8_t*>(broadcast_ring::m_data.data());
+        size_t size = broadcast_ring::m_data.size() * sizeof(T);
+        // Step by the smallest page size.
+        for(size_t i = 0; i < size; i += 4096)
+        {
+            data[i] = data[i];
+        }
+        for(uint32_t i = 0; i < broadcast_ring::m_block_count; ++i)
+        {
+            broadcast_ring::m_blocks[i].count.fetch_add(0, std::memory_order_relaxed);
+        }
+    }
+    /// \brief Claims the next block for writing. Must only be called by the single writer.
+    /// \details The block is marked as being written, so readers still viewing its previous contents will detect the
+    /// overwrite. The claim is completed with publish().
+    /// \return A writable view of the block.
+    std::span<T> claim()
+    {
+        uint64_t number = broadcast_ring::m_published.load(std::memory_order_relaxed);
+        broadcast_ring::block& block = broadcast_ring::m_blocks[number % broadcast_ring::m_block_count];
+        block.sequence.store(2 * number + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return std::span<T>(broadcast_ring::m_data.data() + (number % broadcast_ring::m_block_count) * broadcast_ring::m_block_size, broadcast_ring::m_block_size);
+    }
+    /// \brief Publishes the claimed block to all readers. Must only be called by the single writer.
+    /// \param count The number of valid elements in the block.
+    void publish(uint32_t count)
+    {
+        uint64_t number = broadcast_ring::m_published.load(std::memory_order_relaxed);
+        broadcast_ring::block& block = broadcast_ring::m_blocks[number % broadcast_ring::m_block_count];
+        block.count.store((count < broadcast_ring::m_block_size) ? count : broadcast_ring::m_block_size, std::memory_order_relaxed);
+        block.sequence.store(2 * number + 2, std::memory_order_release);
+        broadcast_ring::m_published.store(number + 1, std::memory_order_release);
+        broadcast_ring::m_generation.fetch_add(1, std::memory_order_release);
+        broadcast_ring::m_generation.notify_all();
+    }
+    /// \brief Closes the ring, waking all waiting readers.
+    void close()
+    {
+        broadcast_ring::m_closed.store(true, std::memory_order_release);
+        broadcast_ring::m_generation.fetch_add(1, std::memory_order_release);
+        broadcast_ring::m_generation.notify_all();
+    }
+    /// \brief Reopens a closed ring.
+    void open()
+    {
+        broadcast_ring::m_closed.store(false, std::memory_order_release);
+    }
+
+    // READERS
+    /// \brief An independent reader of a broadcast ring.
+    class reader
+    {
+    public:
+        // CONSTRUCTORS
+        /// \brief Creates a reader starting at the ring's next block.
+        /// \param ring The ring to read.
+        reader(const broadcast_ring& ring)
+            : m_ring(&ring),
+              m_cursor(ring.published()),
+              m_viewing(0),
+              m_overruns(0)
+        {}
+
+        // READ
+        /// \brief Gets a view of the next block without blocking.
+        /// \details The view remains valid until the writer wraps around the ring. Call release() after processing
+        /// the view to verify that it was not overwritten.
+        /// \param view The view to store the block in.
+        /// \return TRUE if a block was available, otherwise FALSE.
+        bool next(std::span<const T>& view)
+        {
+            while(true)
+            {
+                // Check if the cursor has data.
+                uint64_t published = reader::m_ring->published();
+                if(reader::m_cursor >= published)
+                {
+                    return false;
+                }
+
+                // Skip ahead if the writer has lapped the cursor.
+                uint64_t oldest = (published > reader::m_ring->m_block_count) ? published - reader::m_ring->m_block_count : 0;
+                if(reader::m_cursor < oldest)
+                {
+                    reader::m_overruns += oldest - reader::m_cursor;
+                    reader::m_cursor = oldest;
+                }
+
+                // Read the block's sequence.
+                uint32_t index = reader::m_cursor % reader::m_ring->m_block_count;
+                const broadcast_ring::block& block = reader::m_ring->m_blocks[index];
+                uint64_t sequence = block.sequence.load(std::memory_order_acquire);
+                if(sequence != 2 * reader::m_cursor + 2)
+                {
+                    // The writer has claimed the block for a newer number. Count it as lost and move on.
+                    reader::m_overruns++;
+                    reader::m_cursor++;
+                    continue;
+                }
+
+                // Provide view.
+                view = std::span<const T>(reader::m_ring->m_data.data() + static_cast<size_t>(index) * reader::m_ring->m_block_size, block.count.load(std::memory_order_relaxed));
+                reader::m_viewing = sequence;
+                reader::m_cursor++;
+                return true;
+            }
+        }
+        /// \brief Waits until a new block is published or the ring is closed.
+        /// \return TRUE if a block may be available, FALSE if the ring is closed and this reader is caught up.
+        bool wait() const
+        {
+            while(true)
+            {
+                uint64_t generation = reader::m_ring->m_generation.load(std::memory_order_acquire);
+                if(reader::m_cursor < reader::m_ring->published())
+                {
+                    return true;
+                }
+                if(reader::m_ring->m_closed.load(std::memory_order_acquire))
+                {
+                    return false;
+                }
+                reader::m_ring->m_generation.wait(generation, std::memory_order_acquire);
+            }
+        }
+        /// \brief Verifies that the last viewed block was not overwritten while in use.
+        /// \return TRUE if the view was intact, FALSE if it was overwritten and must be discarded.
+        bool release()
+        {
+            // Verify the block still holds the viewed sequence.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const broadcast_ring::block& block = reader::m_ring->m_blocks[(reader::m_cursor - 1) % reader::m_ring->m_block_count];
+            if(block.sequence.load(std::memory_order_relaxed) != reader::m_viewing)
+            {
+                reader::m_overruns++;
+                return false;
+            }
+            return true;
+        }
+
+        // METRICS
+        /// \brief Gets the number of published blocks this reader has not yet read.
+        /// \return The reader's lag in blocks.
+        uint64_t lag() const
+        {
+            uint64_t published = reader::m_ring->published();
+            return (published > reader::m_cursor) ? published - reader::m_cursor : 0;
+        }
+        /// \brief Gets the number of blocks this reader lost to the writer.
+        /// \return The number of overrun blocks.
+        uint64_t overruns() const
+        {
+            return reader::m_overruns;
+        }
+
+    private:
+        /// \brief The ring being read.
+        const broadcast_ring* m_ring;
+        /// \brief The number of the next block to read.
+        uint64_t m_cursor;
+        /// \brief The sequence of the block being viewed.
+        uint64_t m_viewing;
+        /// \brief The number of blocks lost to the writer.
+        uint64_t m_overruns;
+    };
+    /// \brief Creates a reader starting at the next published block.
+    /// \return The new reader.
+    broadcast_ring::reader subscribe() const
+    {
+        return broadcast_ring::reader(*this);
+    }
+
+private:
+    /// \brief The publication state of a block.
+    struct block
+    {
+        /// \brief Twice the block number plus one while being written, plus two once published.
+        std::atomic<uint64_t> sequence{0};
+        /// \brief The number of valid elements in the block.
+        std::atomic<uint32_t> count{0};
+    };
+
+    // STORAGE
+    /// \brief The number of blocks in the ring.
+    uint32_t m_block_count;
+    /// \brief The number of elements in each block.
+    uint32_t m_block_size;
+    /// \brief The element storage of all blocks.
+    std::vector<T> m_data;
+    /// \brief The publication state of all blocks.
+    std::unique_ptr<broadcast_ring::block[]> m_blocks;
+
+    // PUBLICATION
+    /// \brief The number of published blocks.
+    std::atomic<uint64_t> m_published;
+    /// \brief Incremented on every publish and close, for waiting readers.
+    mutable std::atomic<uint64_t> m_generation;
+    /// \brief Indicates if the ring is closed.
+    std::atomic<bool> m_closed;
+};
+
+}
+
+#endif
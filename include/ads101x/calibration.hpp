@@ -0,0 +1,116 @@
+/// \file ads101x/calibration.hpp
+/// \brief Defines the ads101x::calibration class.
+#ifndef ADS101X___CALIBRATION_H
+#define ADS101X___CALIBRATION_H
+
+// ads101x
+#include <ads101x/configuration.hpp>
+#include <ads101x/sample.hpp>
+
+// std
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ads101x {
+
+/// \brief Applies per-channel, per-FSR calibration to conversions using precomputed lookup tables.
+/// \details Every 12-bit conversion code maps to exactly one calibrated value, so each transform is evaluated once
+/// per code into a 4096-entry table for its (multiplexer, fsr) pair. Applying calibration is then a single table
+/// lookup per conversion. Selecting a configuration builds the tables for every full-scale range of its multiplexer,
+/// so applying calibration never builds or allocates, and tables are rebuilt only when the transform for their pair
+/// changes. Pairs without a transform calibrate to volts.
+class calibration
+{
+public:
+    // CONSTRUCTORS
+    /// \brief Creates a new calibration with no transforms.
+    calibration();
+
+    // TYPES
+    /// \brief The number of entries in a lookup table, one per 12-bit conversion code.
+    static constexpr uint32_t table_size = 4096;
+    /// \brief A lookup table mapping 12-bit conversion codes to calibrated values.
+    typedef std::array<float, table_size> table;
+
+    // TRANSFORMS
+    /// \brief Sets a polynomial transform for a multiplexer and full-scale range.
+    /// \param multiplexer The multiplexer setting to calibrate.
+    /// \param fsr The full-scale range to calibrate.
+    /// \param coefficients The polynomial coefficients in ascending order, applied to the conversion voltage.
+    void set_polynomial(ads101x::configuration::multiplexer multiplexer, ads101x::configuration::fsr fsr, const std::vector<double>& coefficients);
+    /// \brief Sets an arbitrary transform, such as a thermistor curve, for a multiplexer and full-scale range.
+    /// \param multiplexer The multiplexer setting to calibrate.
+    /// \param fsr The full-scale range to calibrate.
+    /// \param transform The transform from conversion voltage to calibrated value.
+    void set_transform(ads101x::configuration::multiplexer multiplexer, ads101x::configuration::fsr fsr, std::function<double(double)> transform);
+    /// \brief Loads polynomial coefficients from a calibration file.
+    /// \details Each non-empty line that does not start with '#' has the form "<multiplexer> <fsr> <c0> [c1 ...]",
+    /// where multiplexer and fsr are enumeration names such as AIN0_GND and FSR_4_096. An fsr of '*' applies the
+    /// coefficients to all full-scale ranges. The whole file is parsed before any transform is set, so a file that
+    /// fails to load leaves the calibration unchanged.
+    /// \param path The path of the calibration file.
+    /// \exception std::runtime_error if the file cannot be opened or contains an invalid line.
+    void load(const std::string& path);
+
+    // TABLES
+    /// \brief Selects the lookup table used by apply().
+    /// \details Builds the tables for every full-scale range of the configuration's multiplexer if necessary.
+    /// \param configuration The configuration whose multiplexer and full-scale range select the table.
+    void select(const ads101x::configuration& configuration);
+    /// \brief Gets the lookup table for a multiplexer and full-scale range, building it if necessary.
+    /// \param multiplexer The multiplexer setting of the table.
+    /// \param fsr The full-scale range of the table.
+    /// \return The lookup table.
+    const calibration::table& get_table(ads101x::configuration::multiplexer multiplexer, ads101x::configuration::fsr fsr);
+
+    // APPLY
+    /// \brief Calibrates a conversion using the selected table.
+    /// \param conversion The 12-bit conversion value read from the ADS101X.
+    /// \return The calibrated value.
+    float apply(uint16_t conversion) const
+    {
+        return (*calibration::m_selected)[conversion & 0x0FFF];
+    }
+    /// \brief Calibrates a block of conversions using the selected table.
+    /// \param conversions The 12-bit conversion values read from the ADS101X.
+    /// \param output The buffer to store the calibrated values in.
+    /// \param count The number of conversions to calibrate.
+    void apply(const uint16_t* conversions, float* output, uint32_t count) const;
+    /// \brief Calibrates a sample using the selected multiplexer and the sample's own full-scale range.
+    /// \details Use this with auto_range, where the full-scale range can change from sample to sample.
+    /// \param sample The sample to calibrate.
+    /// \return The calibrated value.
+    float apply(const ads101x::sample& sample) const;
+
+private:
+    // ENTRIES
+    /// \brief A transform and its lookup table for one (multiplexer, fsr) pair.
+    struct entry
+    {
+        /// \brief The transform from conversion voltage to calibrated value.
+        std::function<double(double)> transform;
+        /// \brief The lookup table, or nullptr if it has not been built.
+        std::unique_ptr<calibration::table> table;
+    };
+    /// \brief The entries for all 8 multiplexer settings and 6 full-scale ranges.
+    std::array<calibration::entry, 48> m_entries;
+    /// \brief Gets the entry for a multiplexer and full-scale range.
+    calibration::entry& get_entry(ads101x::configuration::multiplexer multiplexer, ads101x::configuration::fsr fsr);
+    /// \brief Gets the entry for a multiplexer and full-scale range.
+    const calibration::entry& get_entry(ads101x::configuration::multiplexer multiplexer, ads101x::configuration::fsr fsr) const;
+    /// \brief Builds the lookup table for an entry.
+    static void build(calibration::entry& entry, ads101x::configuration::fsr fsr);
+
+    // SELECTION
+    /// \brief The selected lookup table.
+    const calibration::table* m_selected;
+    /// \brief The selected multiplexer.
+    ads101x::configuration::multiplexer m_selected_multiplexer;
+};
+
+}
+
+#endif
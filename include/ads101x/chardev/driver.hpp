@@ -0,0 +1,91 @@
+/// \file ads101x/chardev/driver.hpp
+/// \brief Defines the ads101x::chardev::driver class.
+#ifndef ADS101X___CHARDEV___DRIVER_H
+#define ADS101X___CHARDEV___DRIVER_H
+
+// ads101x
+#include <ads101x/chardev/io.hpp>
+#include <ads101x/driver.hpp>
+#include <ads101x/event.hpp>
+
+// std
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace ads101x {
+/// \brief Contains all code for ADS101X drivers built on the Linux character-device interfaces.
+namespace chardev {
+
+/// \brief An ADS101X driver implemented on the Linux i2c-dev and GPIO character-device interfaces.
+/// \details Register accesses are I2C_RDWR transactions on /dev/i2c-N, with block reads batched into a single
+/// transaction. ALERT/RDY is requested from the GPIO chip through the v2 uAPI with edge detection on the subscribed
+/// edges only, so the kernel wakes the event thread on each edge instead of the GPIO being sampled, and each edge
+/// carries the kernel's CLOCK_MONOTONIC timestamp, which is reported through alert_rdy_timestamp(). Edges queued
+/// together are delivered together to batch callbacks. Pins are line offsets on the chip. Register operations with a
+/// deadline retry transient I2C failures, such as lost arbitration, until the deadline passes.
+class driver
+    : public ads101x::driver
+{
+public:
+    // CONSTRUCTORS
+    /// \brief Constructs a new ADS101X driver instance.
+    /// \param gpio_chip The path of the GPIO chip that ALERT/RDY is connected to.
+    /// \param io The system calls to use. Must outlive the driver.
+    driver(const std::string& gpio_chip = "/dev/gpiochip0", ads101x::chardev::io& io = ads101x::chardev::io::kernel());
+    ~driver();
+
+    // METRICS
+    /// \brief Gets the number of ALERT/RDY edges the kernel dropped because its event buffer overflowed.
+    /// \return The number of lost edges.
+    uint64_t lost_edges() const;
+
+private:
+    // I2C
+    void open_i2c(uint32_t i2c_bus, uint8_t i2c_address) override;
+    void close_i2c() override;
+    void write_register(uint8_t register_address, uint16_t value) const override;
+    uint16_t read_register(uint8_t register_address) const override;
+    void read_registers(uint8_t register_address, std::span<uint16_t> values) const override;
+
+    // ALERT_RDY
+    void attach_interrupt(uint16_t pin) override;
+    void detach_interrupt(uint16_t pin) override;
+    void set_watchdog(uint16_t pin, uint32_t timeout_ms) override;
+    /// \brief Reads batches of edge events from the line request and raises them.
+    void run_events();
+
+    // SYSTEM CALLS
+    /// \brief The system calls to use.
+    ads101x::chardev::io& m_io;
+    /// \brief The path of the GPIO chip.
+    std::string m_gpio_chip;
+
+    // I2C
+    /// \brief The descriptor of the open I2C adapter, or -1.
+    int32_t m_i2c_descriptor;
+    /// \brief The address of the ADS101X on the I2C bus.
+    uint8_t m_i2c_address;
+
+    // ALERT_RDY
+    /// \brief The descriptor of the ALERT/RDY line request, or -1.
+    int32_t m_line_descriptor;
+    /// \brief The line offset of ALERT/RDY.
+    uint16_t m_line_offset;
+    /// \brief Wakes the event thread to stop.
+    ads101x::event m_stop;
+    /// \brief The event thread.
+    std::thread m_thread;
+    /// \brief The line sequence number of the last edge, used to detect lost edges.
+    uint32_t m_line_sequence;
+    /// \brief The watchdog timeout in milliseconds, or zero if disarmed. Applied as the event thread's poll timeout.
+    std::atomic<uint32_t> m_watchdog;
+    /// \brief Wakes the event thread to apply a new watchdog timeout.
+    ads101x::event m_watchdog_changed;
+    /// \brief The number of lost edges.
+    std::atomic<uint64_t> m_lost_edges;
+};
+
+}}
+
+#endif
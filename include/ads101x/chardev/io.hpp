@@ -0,0 +1,45 @@
+/// \file ads101x/chardev/io.hpp
+/// \brief Defines the ads101x::chardev::io class.
+#ifndef ADS101X___CHARDEV___IO_H
+#define ADS101X___CHARDEV___IO_H
+
+// std
+#include <stdint.h>
+
+// posix
+#include <poll.h>
+#include <sys/types.h>
+
+namespace ads101x {
+namespace chardev {
+
+/// \brief The system calls used by the character-device driver.
+/// \details The default implementation forwards each call to the kernel. Override it to run the driver against
+/// simulated I2C adapters and GPIO chips, e.g. in tests.
+class io
+{
+public:
+    // CONSTRUCTORS
+    virtual ~io() = default;
+
+    // SYSTEM CALLS
+    /// \brief Opens a device file, as open(2).
+    virtual int32_t open(const char* path, int32_t flags);
+    /// \brief Closes a descriptor, as close(2).
+    virtual int32_t close(int32_t descriptor);
+    /// \brief Issues a device request, as ioctl(2).
+    virtual int32_t ioctl(int32_t descriptor, unsigned long request, void* argument);
+    /// \brief Reads from a descriptor, as read(2).
+    virtual ssize_t read(int32_t descriptor, void* buffer, size_t size);
+    /// \brief Waits for events on descriptors, as poll(2).
+    virtual int32_t poll(pollfd* descriptors, nfds_t count, int32_t timeout);
+
+    // DEFAULT
+    /// \brief Gets the shared instance that forwards to the kernel.
+    /// \return The kernel instance.
+    static io& kernel();
+};
+
+}}
+
+#endif
@@ -0,0 +1,21 @@
+/// \file ads101x/clock.hpp
+/// \brief Defines the ads101x monotonic clock functions.
+#ifndef ADS101X___CLOCK_H
+#define ADS101X___CLOCK_H
+
+// std
+#include <stdint.h>
+
+namespace ads101x {
+
+/// \brief Gets the current CLOCK_MONOTONIC time.
+/// \return The current time in nanoseconds.
+uint64_t monotonic_ns();
+/// \brief Sleeps until an absolute CLOCK_MONOTONIC time.
+/// \details Sleeping to absolute deadlines keeps periodic loops free of drift.
+/// \param deadline The time to sleep until, in nanoseconds.
+void sleep_until_ns(uint64_t deadline);
+
+}
+
+#endif
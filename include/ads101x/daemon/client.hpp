@@ -0,0 +1,96 @@
+/// \file ads101x/daemon/client.hpp
+/// \brief Defines the ads101x::daemon::client class.
+#ifndef ADS101X___DAEMON___CLIENT_H
+#define ADS101X___DAEMON___CLIENT_H
+
+// ads101x
+#include <ads101x/configuration.hpp>
+#include <ads101x/daemon/protocol.hpp>
+#include <ads101x/sample.hpp>
+
+// std
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace ads101x {
+namespace daemon {
+
+/// \brief A connection to the ads101x daemon.
+/// \details Requests are synchronous. Sample blocks pushed by the daemon while waiting for a response are queued and
+/// returned by later calls to receive().
+class client
+{
+public:
+    // CONSTRUCTORS
+    /// \brief Connects to the daemon.
+    /// \param path The path of the daemon's socket.
+    /// \exception std::runtime_error if the connection fails.
+    client(const std::string& path = daemon::default_socket_path);
+    ~client();
+    client(const client&) = delete;
+    client& operator=(const client&) = delete;
+
+    // REQUESTS
+    /// \brief Starts receiving a device's sample blocks.
+    /// \param device The device index.
+    /// \exception std::runtime_error if the request fails.
+    void subscribe(uint16_t device);
+    /// \brief Stops receiving a device's sample blocks.
+    /// \param device The device index.
+    /// \exception std::runtime_error if the request fails.
+    void unsubscribe(uint16_t device);
+    /// \brief Sets the configuration of a device's sample stream.
+    /// \details The configuration applies to every subscriber of the device.
+    /// \param device The device index.
+    /// \param configuration The configuration.
+    /// \exception std::runtime_error if the request fails.
+    void configure(uint16_t device, const ads101x::configuration& configuration);
+    /// \brief Takes a single conversion.
+    /// \param device The device index.
+    /// \param configuration The configuration to convert with.
+    /// \return The converted sample.
+    /// \exception std::runtime_error if the request fails, or the device is streaming on a different channel or range.
+    ads101x::sample singleshot(uint16_t device, const ads101x::configuration& configuration);
+
+    // STREAM
+    /// \brief Receives the next pushed sample block.
+    /// \param device Set to the index of the device the block came from.
+    /// \param samples Set to the samples of the block.
+    /// \param timeout The maximum time to wait.
+    /// \return TRUE if a block was received, otherwise FALSE.
+    /// \exception std::runtime_error if the connection is lost, or the daemon stopped the stream because it could not
+    /// be restarted. The client is no longer subscribed to the device in that case.
+    bool receive(uint16_t& device, std::vector<ads101x::sample>& samples, std::chrono::milliseconds timeout);
+    /// \brief Gets the socket descriptor, for use with poll() or similar.
+    /// \return The socket descriptor.
+    int32_t descriptor() const;
+
+private:
+    // MESSAGES
+    /// \brief Sends a request and waits for its response.
+    /// \exception std::runtime_error if the request fails.
+    daemon::response transact(daemon::command command, uint16_t device, uint16_t configuration);
+    /// \brief Reads one message, queueing blocks and storing responses.
+    /// \param timeout The maximum time to wait in milliseconds, or -1 to wait indefinitely.
+    /// \return TRUE if a message was read, otherwise FALSE.
+    bool read_message(int32_t timeout);
+
+    /// \brief The connected socket.
+    int32_t m_socket;
+    /// \brief The identifier of the next request.
+    uint32_t m_next_id;
+    /// \brief The receive buffer.
+    std::vector<uint8_t> m_buffer;
+    /// \brief The blocks received but not yet returned.
+    std::deque<std::pair<uint16_t, std::vector<ads101x::sample>>> m_blocks;
+    /// \brief The most recent response.
+    daemon::response m_response;
+    /// \brief Indicates if m_response holds an unconsumed response.
+    bool m_has_response;
+};
+
+}}
+
+#endif
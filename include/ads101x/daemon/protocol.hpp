@@ -0,0 +1,89 @@
+/// \file ads101x/daemon/protocol.hpp
+/// \brief Defines the messages exchanged between the ads101x daemon and its clients.
+#ifndef ADS101X___DAEMON___PROTOCOL_H
+#define ADS101X___DAEMON___PROTOCOL_H
+
+// ads101x
+#include <ads101x/sample.hpp>
+
+// std
+#include <stdint.h>
+#include <type_traits>
+
+namespace ads101x {
+/// \brief Contains all code for the local acquisition daemon and its clients.
+namespace daemon {
+
+/// \brief The default path of the daemon's Unix domain socket.
+constexpr const char* default_socket_path = "/run/ads101x.sock";
+/// \brief The largest number of samples carried in one block message.
+constexpr uint32_t max_block_size = 1024;
+
+/// \brief Enumerates the requests a client can send.
+enum class command : uint16_t
+{
+    SUBSCRIBE       = 1,    ///< Start receiving the device's sample blocks.
+    UNSUBSCRIBE     = 2,    ///< Stop receiving the device's sample blocks.
+    CONFIGURE       = 3,    ///< Set the configuration used for the device's sample stream.
+    SINGLESHOT      = 4     ///< Take one conversion with the given configuration.
+};
+/// \brief Enumerates the kinds of message the daemon sends.
+enum class message : uint16_t
+{
+    RESPONSE        = 1,    ///< The response to a request.
+    BLOCK           = 2,    ///< A block of streamed samples.
+    STOPPED         = 3     ///< The device's stream stopped and its subscribers were removed, sent as an empty block.
+};
+/// \brief Enumerates the result of a request.
+enum class status : int16_t
+{
+    OK              = 0,    ///< The request succeeded.
+    INVALID         = -1,   ///< The request or device index was invalid.
+    BUSY            = -2,   ///< The device is streaming with a conflicting configuration.
+    FAILED          = -3    ///< The device reported an error.
+};
+
+/// \brief A request sent by a client.
+struct request
+{
+    /// \brief The requested command.
+    daemon::command command;
+    /// \brief The index of the device the request applies to.
+    uint16_t device;
+    /// \brief The configuration bitfield for CONFIGURE and SINGLESHOT.
+    uint16_t configuration;
+    /// \brief Reserved for alignment.
+    uint16_t reserved;
+    /// \brief An identifier chosen by the client and echoed in the response.
+    uint32_t id;
+};
+/// \brief The response to a request.
+struct response
+{
+    /// \brief Always message::RESPONSE.
+    daemon::message type;
+    /// \brief The result of the request.
+    daemon::status status;
+    /// \brief The identifier of the request.
+    uint32_t id;
+    /// \brief The converted sample for SINGLESHOT requests.
+    ads101x::sample sample;
+};
+/// \brief The header of a block message, followed by count samples.
+struct block_header
+{
+    /// \brief Always message::BLOCK.
+    daemon::message type;
+    /// \brief The index of the device the samples came from.
+    uint16_t device;
+    /// \brief The number of samples following the header.
+    uint32_t count;
+};
+
+// Messages are exchanged between processes on the same host as raw structures.
+static_assert(std::is_trivially_copyable_v<ads101x::sample>, "samples must be trivially copyable to be sent");
+static_assert(sizeof(daemon::block_header) % alignof(ads101x::sample) == 0, "samples must be aligned after the block header");
+
+}}
+
+#endif
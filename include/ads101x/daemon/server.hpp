@@ -0,0 +1,193 @@
+/// \file ads101x/daemon/server.hpp
+/// \brief Defines the ads101x::daemon::server class.
+#ifndef ADS101X___DAEMON___SERVER_H
+#define ADS101X___DAEMON___SERVER_H
+
+// ads101x
+#include <ads101x/acquisition.hpp>
+#include <ads101x/daemon/protocol.hpp>
+#include <ads101x/driver.hpp>
+#include <ads101x/variant.hpp>
+
+// std
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ads101x {
+namespace daemon {
+
+/// \brief Serves one or more ADS101X devices to many local clients over a Unix domain socket.
+/// \details Each device has a single shared acquisition stream, started when the first client subscribes and stopped
+/// when the last unsubscribes, and its sample blocks are pushed to every subscriber as they are published. Single-shot
+/// requests for the same device and configuration that arrive together, or while its conversion is in progress, share
+/// one conversion, which completes on a timer so the event loop keeps serving other clients. Single-shot requests
+/// matching a running stream are answered with its next sample instead of interrupting it.
+class server
+{
+public:
+    // CONSTRUCTORS
+    /// \brief Creates a new server listening on a Unix domain socket.
+    /// \details Any existing socket file at the path is replaced.
+    /// \param path The path of the socket.
+    /// \exception std::runtime_error if the socket cannot be created.
+    server(const std::string& path = daemon::default_socket_path);
+    ~server();
+    server(const server&) = delete;
+    server& operator=(const server&) = delete;
+
+    // DEVICES
+    /// \brief Adds a device to serve. Devices are indexed in the order they are added.
+    /// \param driver The started driver for the device. It must outlive the server.
+    /// \param alert_rdy_pin The GPIO pin connected to ALERT/RDY, or -1 to poll on a timer.
+    /// \param block_size The number of samples in each pushed block.
+    /// \param variant The variant of the device, which determines the conversion time of each data rate.
+    /// \return The index of the device.
+    /// \exception std::runtime_error if the server is running or the block size is invalid.
+    uint16_t add_device(ads101x::driver& driver, int32_t alert_rdy_pin = -1, uint32_t block_size = 32, ads101x::variant variant = ads101x::variant::ADS1015);
+
+    /// \brief Sets the real-time profile applied to each device's acquisition thread.
+    /// \param profile The real-time profile.
+    void set_realtime(const ads101x::realtime_profile& profile);
+
+    // CONTROL
+    /// \brief Runs the server on the calling thread until stop() is called.
+    /// \details Returns immediately if stop() was already called.
+    void run();
+    /// \brief Stops the server. May be called from any thread or a signal handler.
+    void stop();
+
+    // METRICS
+    /// \brief Gets the number of clients currently connected.
+    /// \return The number of clients.
+    uint32_t clients() const;
+    /// \brief Gets the number of single-shot conversions taken.
+    /// \return The number of conversions.
+    uint64_t conversions() const;
+    /// \brief Gets the number of single-shot requests answered by a shared conversion or stream sample.
+    /// \return The number of requests.
+    uint64_t coalesced() const;
+    /// \brief Gets the number of blocks that could not be pushed because a subscriber's socket was full.
+    /// \return The number of blocks.
+    uint64_t dropped() const;
+
+private:
+    // DEVICES
+    /// \brief A single-shot request waiting for the next streamed sample.
+    struct waiter
+    {
+        /// \brief The client socket.
+        int32_t client;
+        /// \brief The request identifier.
+        uint32_t id;
+    };
+    /// \brief A received request and the client it came from.
+    struct pending
+    {
+        /// \brief The client socket.
+        int32_t client;
+        /// \brief The request.
+        daemon::request request;
+    };
+    /// \brief A served device.
+    struct device
+    {
+        /// \brief The index of the device.
+        uint16_t index;
+        /// \brief The device driver.
+        ads101x::driver* driver;
+        /// \brief The ALERT/RDY pin, or -1.
+        int32_t alert_rdy_pin;
+        /// \brief The number of samples in each pushed block.
+        uint32_t block_size;
+        /// \brief The variant of the device.
+        ads101x::variant variant;
+        /// \brief The shared acquisition stream.
+        std::unique_ptr<ads101x::acquisition> acquisition;
+        /// \brief The configuration of the stream.
+        ads101x::configuration configuration;
+        /// \brief Guards the subscribers and waiters against the acquisition thread.
+        std::mutex mutex;
+        /// \brief The sockets of subscribed clients.
+        std::vector<int32_t> subscribers;
+        /// \brief The single-shot requests waiting for the next streamed sample.
+        std::vector<server::waiter> waiters;
+        /// \brief Indicates if waiters are waiting, checked on the acquisition thread for every sample.
+        std::atomic<bool> waiting;
+        /// \brief The timerfd that expires when the single-shot conversion in progress completes.
+        int32_t timer;
+        /// \brief Indicates if a single-shot conversion is in progress.
+        bool converting;
+        /// \brief The configuration of the single-shot conversion in progress.
+        ads101x::configuration conversion;
+        /// \brief The requests answered by the single-shot conversion in progress.
+        std::vector<server::waiter> requests;
+        /// \brief The single-shot requests with other settings, queued until the conversion in progress completes.
+        std::vector<server::pending> queued;
+        /// \brief The buffer for building block messages.
+        std::vector<uint8_t> message;
+    };
+    /// \brief The served devices.
+    std::vector<std::unique_ptr<server::device>> m_devices;
+    /// \brief The real-time profile of acquisition threads.
+    ads101x::realtime_profile m_realtime_profile;
+
+    // REQUESTS
+    /// \brief Accepts new clients.
+    void accept_clients();
+    /// \brief Reads all available requests from a client.
+    /// \return FALSE if the client disconnected, otherwise TRUE.
+    bool receive(int32_t client, std::vector<server::pending>& singleshots);
+    /// \brief Handles a subscribe, unsubscribe, or configure request.
+    daemon::status handle(int32_t client, const daemon::request& request);
+    /// \brief Serves a batch of single-shot requests, sharing conversions where possible.
+    void serve_singleshots(std::vector<server::pending>& singleshots);
+    /// \brief Starts a single-shot conversion on an idle device, and arms its timer for the conversion time.
+    void begin_conversion(server::device& device, ads101x::configuration configuration);
+    /// \brief Answers the requests of a completed single-shot conversion, then serves the requests queued behind it.
+    void complete_conversion(server::device& device);
+    /// \brief Removes a client from all devices and closes its socket.
+    void disconnect(int32_t client);
+    /// \brief Starts or restarts a device's stream with its current configuration.
+    void start_stream(server::device& device);
+    /// \brief Stops a device's stream.
+    void stop_stream(server::device& device);
+    /// \brief Stops a device's stream that could not be restarted, and tells its subscribers it has stopped.
+    void drop_stream(server::device& device);
+    /// \brief Pushes a published block to a device's subscribers. Called on the acquisition thread.
+    void push(server::device& device, std::span<const ads101x::sample> block);
+    /// \brief Answers the single-shot requests waiting on a device's stream. Called on the acquisition thread.
+    void answer(server::device& device, const ads101x::sample& sample);
+    /// \brief Sends a response to a client.
+    static void respond(int32_t client, uint32_t id, daemon::status status, const ads101x::sample& sample = ads101x::sample());
+
+    // SOCKETS
+    /// \brief The path of the listening socket.
+    std::string m_path;
+    /// \brief The listening socket.
+    int32_t m_listener;
+    /// \brief The eventfd used to wake the event loop for stop().
+    int32_t m_wake;
+    /// \brief The connected client sockets.
+    std::vector<int32_t> m_clients;
+    /// \brief The number of connected clients, readable from any thread.
+    std::atomic<uint32_t> m_client_count;
+    /// \brief Indicates if the event loop is running.
+    std::atomic<bool> m_running;
+    /// \brief Indicates if stop() was requested.
+    std::atomic<bool> m_stopping;
+
+    // METRICS
+    /// \brief The number of single-shot conversions taken.
+    std::atomic<uint64_t> m_conversions;
+    /// \brief The number of coalesced single-shot requests.
+    std::atomic<uint64_t> m_coalesced;
+    /// \brief The number of dropped blocks.
+    std::atomic<uint64_t> m_dropped;
+};
+
+}}
+
+#endif
@@ -0,0 +1,40 @@
+/// \file ads101x/edge.hpp
+/// \brief Defines the ads101x::edge enumeration and the ads101x::edge_event structure.
+#ifndef ADS101X___EDGE_H
+#define ADS101X___EDGE_H
+
+// ads101x
+#include <ads101x/configuration.hpp>
+
+// std
+#include <stdint.h>
+
+namespace ads101x {
+
+/// \brief Enumerates the ALERT_RDY edges delivered to a callback.
+enum class edge
+{
+    BOTH,       ///< Both edges.
+    RISING,     ///< Rising edges only.
+    FALLING     ///< Falling edges only.
+};
+/// \brief Gets the edge that asserts ALERT_RDY for a comparator polarity.
+/// \param polarity The comparator polarity.
+/// \return RISING for ACTIVE_HIGH, otherwise FALLING.
+inline ads101x::edge asserting_edge(ads101x::configuration::comparator_polarity polarity)
+{
+    return (polarity == ads101x::configuration::comparator_polarity::ACTIVE_HIGH) ? ads101x::edge::RISING : ads101x::edge::FALLING;
+}
+
+/// \brief An ALERT_RDY edge and the time it was detected.
+struct edge_event
+{
+    /// \brief The level of the pin after the edge.
+    bool level;
+    /// \brief The CLOCK_MONOTONIC time the edge was detected, in nanoseconds.
+    uint64_t timestamp;
+};
+
+}
+
+#endif
@@ -0,0 +1,44 @@
+/// \file ads101x/event.hpp
+/// \brief Defines the ads101x::event class.
+#ifndef ADS101X___EVENT_H
+#define ADS101X___EVENT_H
+
+// std
+#include <stdint.h>
+
+namespace ads101x {
+
+/// \brief A pollable event counter backed by a Linux eventfd.
+/// \details The descriptor becomes readable once the event is signalled, so it can be registered with epoll, poll, or
+/// io_uring to integrate ALERT/RDY edges and sample availability into a single-threaded event loop. Signalling is a
+/// single non-blocking write that never allocates, so it is safe from callback and acquisition threads.
+class event
+{
+public:
+    // CONSTRUCTORS
+    /// \brief Creates a new event.
+    /// \exception std::runtime_error if the eventfd cannot be created.
+    event();
+    ~event();
+    event(const event&) = delete;
+    event& operator=(const event&) = delete;
+
+    // EVENT
+    /// \brief Gets the descriptor to poll for readability.
+    /// \return The eventfd descriptor.
+    int32_t descriptor() const;
+    /// \brief Signals the event, making the descriptor readable.
+    /// \param count The amount to add to the event counter.
+    void signal(uint64_t count = 1) const;
+    /// \brief Consumes all pending signals without blocking.
+    /// \return The number of signals since the last call, or zero if none are pending.
+    uint64_t consume() const;
+
+private:
+    /// \brief The eventfd descriptor.
+    int32_t m_descriptor;
+};
+
+}
+
+#endif
@@ -0,0 +1,78 @@
+/// \file ads101x/histogram.hpp
+/// \brief Defines the ads101x::histogram class.
+#ifndef ADS101X___HISTOGRAM_H
+#define ADS101X___HISTOGRAM_H
+
+// std
+#include <array>
+#include <ostream>
+#include <stdint.h>
+
+namespace ads101x {
+
+/// \brief A fixed-size histogram of durations with bounded relative error.
+/// \details Values below 32 are counted exactly. Larger values are counted in buckets that are 1/16 of their power of
+/// two wide, so percentiles are accurate to within about 6%. Recording never allocates, so it is safe on real-time
+/// threads. The histogram is not synchronized; read it only after recording has stopped.
+class histogram
+{
+public:
+    // CONSTRUCTORS
+    /// \brief Creates an empty histogram.
+    histogram();
+
+    // RECORDING
+    /// \brief Records a value.
+    /// \param value The value to record.
+    void record(uint64_t value);
+    /// \brief Removes all recorded values.
+    void reset();
+
+    // STATISTICS
+    /// \brief Gets the number of recorded values.
+    /// \return The number of values.
+    uint64_t count() const;
+    /// \brief Gets the smallest recorded value.
+    /// \return The smallest value, or zero if empty.
+    uint64_t min() const;
+    /// \brief Gets the largest recorded value.
+    /// \return The largest value, or zero if empty.
+    uint64_t max() const;
+    /// \brief Gets the mean of the recorded values.
+    /// \return The mean, or zero if empty.
+    double mean() const;
+    /// \brief Gets a percentile of the recorded values.
+    /// \param percentile The percentile, from 0 to 100.
+    /// \return The upper bound of the bucket holding the percentile, limited to the largest value.
+    uint64_t percentile(double percentile) const;
+    /// \brief Prints every non-empty bucket as a line of "lower upper count".
+    /// \param stream The stream to print to.
+    /// \param scale The divisor applied to printed bounds, such as 1000 to print nanoseconds as microseconds.
+    void print(std::ostream& stream, double scale = 1.0) const;
+
+private:
+    // BUCKETS
+    /// \brief The number of buckets needed for 64-bit values.
+    static constexpr uint32_t bucket_count = 32 + 59 * 16;
+    /// \brief Gets the bucket index of a value.
+    static uint32_t index(uint64_t value);
+    /// \brief Gets the smallest value of a bucket.
+    static uint64_t lower_bound(uint32_t index);
+    /// \brief Gets the largest value of a bucket.
+    static uint64_t upper_bound(uint32_t index);
+
+    /// \brief The bucket counts.
+    std::array<uint64_t, histogram::bucket_count> m_buckets;
+    /// \brief The number of recorded values.
+    uint64_t m_count;
+    /// \brief The sum of recorded values.
+    double m_sum;
+    /// \brief The smallest recorded value.
+    uint64_t m_min;
+    /// \brief The largest recorded value.
+    uint64_t m_max;
+};
+
+}
+
+#endif
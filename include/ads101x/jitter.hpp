@@ -0,0 +1,61 @@
+/// \file ads101x/jitter.hpp
+/// \brief Defines the ads101x::jitter class.
+#ifndef ADS101X___JITTER_H
+#define ADS101X___JITTER_H
+
+// ads101x
+#include <ads101x/acquisition.hpp>
+#include <ads101x/histogram.hpp>
+
+// std
+#include <ostream>
+
+namespace ads101x {
+
+/// \brief Measures the sampling jitter and ready-to-read latency of an acquisition.
+/// \details Records the interval between consecutive conversion reads, and the latency from each conversion becoming
+/// ready to its read. A conversion becomes ready on its ALERT/RDY edge when a pin is used, or at its timer deadline
+/// otherwise. Recording happens on the acquisition thread and never allocates; read the results after stopping it.
+class jitter
+{
+public:
+    // CONSTRUCTORS
+    /// \brief Creates a new jitter measurement.
+    jitter();
+
+    // RECORDING
+    /// \brief Records the timing of every conversion read by an acquisition.
+    /// \details Replaces the acquisition's timing probe. The measurement must outlive the acquisition's thread.
+    /// \param acquisition The acquisition to measure.
+    void attach(ads101x::acquisition& acquisition);
+    /// \brief Records the timing of one conversion read.
+    /// \param ready The time the conversion became ready, in CLOCK_MONOTONIC nanoseconds.
+    /// \param read The time the read started, in CLOCK_MONOTONIC nanoseconds.
+    void record(uint64_t ready, uint64_t read);
+    /// \brief Removes all recorded timings.
+    void reset();
+
+    // RESULTS
+    /// \brief Gets the histogram of intervals between consecutive reads, in nanoseconds.
+    /// \return The interval histogram.
+    const ads101x::histogram& intervals() const;
+    /// \brief Gets the histogram of latencies from conversion ready to read, in nanoseconds.
+    /// \return The latency histogram.
+    const ads101x::histogram& latencies() const;
+    /// \brief Prints a summary with p50, p99, p99.9, and max of both histograms, in microseconds.
+    /// \param stream The stream to print to.
+    /// \param histograms Also prints the non-empty buckets of both histograms.
+    void print(std::ostream& stream, bool histograms = false) const;
+
+private:
+    /// \brief The interval histogram.
+    ads101x::histogram m_intervals;
+    /// \brief The latency histogram.
+    ads101x::histogram m_latencies;
+    /// \brief The time of the previous read, or zero.
+    uint64_t m_last_read;
+};
+
+}
+
+#endif
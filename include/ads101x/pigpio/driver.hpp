@@ -6,6 +6,12 @@
 // ads101x
 #include <ads101x/driver.hpp>
 
+// pigpio
+#include <pigpio.h>
+
+// std
+#include <atomic>
+
 namespace ads101x {
 /// \brief Contains all code for ADS101X drivers built on the pigpio library.
 namespace pigpio {
@@ -23,32 +29,73 @@ public:
     // PIGPIO
     /// \brief Initializes the pigpio library for use.
     /// \details Use this convenience function to initialize pigpio if not already done elsewhere in the application.
+    /// pigpio samples the GPIOs with DMA at the sample period, which sets the resolution of SAMPLED interrupts and its
+    /// background CPU use. Drivers using ISR interrupts can raise the period to reduce the CPU use.
+    /// \param sample_period_us The GPIO sample period in microseconds: 1, 2, 4, 5, 8, or 10.
     /// \exception std::runtime_error if initialization fails.
-    void pigpio_initialize();
+    void pigpio_initialize(uint32_t sample_period_us = 5);
     /// \brief Terminates the pigpio library and frees resources.
     /// \details Use this convenience function to terminate pigpio if not already done elsewhere in the application.
     void pigpio_terminate();
 
+    // ALERT_RDY
+    /// \brief Enumerates the ways ALERT/RDY edges are detected.
+    enum class interrupt_mode
+    {
+        SAMPLED,    ///< pigpio alert functions, detecting edges from the DMA GPIO samples one callback at a time.
+        ISR,        ///< pigpio ISR functions, woken by the kernel on the subscribed edges only.
+        BATCHED     ///< pigpio sample functions, delivering the edges detected from the DMA GPIO samples each
+                    ///< millisecond as one batch.
+    };
+    /// \brief Sets how ALERT/RDY edges are detected. Applies to the next attach_alert_rdy().
+    /// \details ISR mode asks the kernel for the edge passed to attach_alert_rdy(), so the other edge causes no
+    /// wakeups. BATCHED mode coalesces the edges of a millisecond into one batch callback. pigpio supports a single
+    /// sample function per process, so only one driver may attach in BATCHED mode at a time. In all modes the
+    /// ALERT_RDY watchdog is timed by pigpio: through gpioSetWatchdog(), the ISR timeout, or the sample function.
+    /// \param mode The interrupt mode.
+    void set_interrupt_mode(driver::interrupt_mode mode);
+
 private:
     // I2C
     void open_i2c(uint32_t i2c_bus, uint8_t i2c_address) override;
     void close_i2c() override;
     void write_register(uint8_t register_address, uint16_t value) const override;
     uint16_t read_register(uint8_t register_address) const override;
+    void read_registers(uint8_t register_address, std::span<uint16_t> values) const override;
 
     // ALERT_RDY
     void attach_interrupt(uint16_t pin) override;
     void detach_interrupt(uint16_t pin) override;
-    /// \brief The callback for pigpio alert interrupts.
+    void set_watchdog(uint16_t pin, uint32_t timeout_ms) override;
+    /// \brief The callback for pigpio alert and ISR interrupts.
     /// \param pin The GPIO pin associated with the alert.
     /// \param level The level change.
     /// \param tick The timestamp of the alert.
     /// \param data User data to pass into the callback.
     static void interrupt_callback(int32_t pin, int32_t level, uint32_t tick, void* data);
+    /// \brief The callback for pigpio GPIO samples in BATCHED mode.
+    /// \param samples The GPIO samples since the last callback.
+    /// \param count The number of samples.
+    /// \param data User data to pass into the callback.
+    static void samples_callback(const gpioSample_t* samples, int32_t count, void* data);
 
     // HANDLES
     /// \brief Stores the handle for an open I2C connection.
     int32_t m_i2c_handle;
+
+    // INTERRUPTS
+    /// \brief The interrupt mode for the next attachment.
+    driver::interrupt_mode m_interrupt_mode;
+    /// \brief The interrupt mode of the current attachment.
+    driver::interrupt_mode m_attached_mode;
+    /// \brief The watchdog timeout of the current attachment in milliseconds, or zero if disarmed.
+    std::atomic<uint32_t> m_watchdog;
+    /// \brief The ALERT/RDY pin in BATCHED mode.
+    uint16_t m_sampled_pin;
+    /// \brief The last sampled level of ALERT/RDY in BATCHED mode.
+    bool m_sampled_level;
+    /// \brief The tick of the last sampled edge or watchdog timeout in BATCHED mode.
+    uint32_t m_sampled_tick;
 };
 
 }}
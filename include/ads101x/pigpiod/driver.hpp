@@ -15,6 +15,14 @@ namespace ads101x {
 namespace pigpiod {
 
 /// \brief An ADS101X driver implemented via pigpiod.
+/// \details Deadlines are checked before each round trip to the daemon, so an operation that cannot complete in time
+/// is not sent and block reads stop between batches. pigpiod_if2 blocks on its socket without a timeout, so a round
+/// trip that is already in flight cannot be abandoned.
+///
+/// When the driver opened the daemon connection itself, it reconnects automatically if the connection drops. The
+/// I2C session is reopened, the last CONFIG, LO_THRESH and HI_THRESH values written are restored in a single I2C zip
+/// command with the OS bit cleared so no single-shot conversion is started, and the ALERT_RDY callbacks and watchdogs
+/// are reattached, before the failed operation is retried once.
 class driver
     : public ads101x::driver
 {
@@ -35,20 +43,44 @@ public:
     void pigpiod_connect(const std::string& ip_address = "localhost", uint16_t port = 8888);
     /// \brief Disconnects from the pigpio daemon.
     void pigpiod_disconnect();
+    /// \brief Replaces the daemon connection and restores the session from its snapshot.
+    /// \details Called automatically when an operation finds the connection dropped, if automatic reconnects are
+    /// enabled.
+    /// \exception std::runtime_error if the driver did not open the connection, or the session cannot be restored.
+    void pigpiod_reconnect();
+    /// \brief Enables or disables automatic reconnects. Enabled by default.
+    /// \param enabled TRUE to reconnect automatically when the connection drops, otherwise FALSE.
+    void set_auto_reconnect(bool enabled);
     /// \brief Gets the handle for the driver's pigpio daemon connection.
     /// \return If connected, returns the handle. If not connected, returns PI_NO_HANDLE.
     int32_t pigpiod_handle() const;
 
+    // METRICS
+    /// \brief Gets the number of times the driver reconnected to the daemon.
+    /// \return The number of reconnects.
+    uint64_t reconnects() const;
+    /// \brief Gets the duration of the latest reconnect, from closing the dropped connection until the session was
+    /// restored.
+    /// \return The duration in nanoseconds, or zero if the driver has not reconnected.
+    uint64_t reconnect_latency() const;
+
 private:
     // OVERRIDES
     void open_i2c(uint32_t i2c_bus, uint8_t i2c_address) override;
     void close_i2c() override;
     void write_register(uint8_t register_address, uint16_t value) const override;
     uint16_t read_register(uint8_t register_address) const override;
+    void read_registers(uint8_t register_address, std::span<uint16_t> values) const override;
 
     // ALERT_RDY
     void attach_interrupt(uint16_t pin) override;
     void detach_interrupt(uint16_t pin) override;
+    void set_watchdog(uint16_t pin, uint32_t timeout_ms) override;
+    /// \brief Configures a pin for ALERT_RDY and registers its daemon callback.
+    /// \param pin The GPIO pin.
+    /// \return The callback handle.
+    /// \exception std::runtime_error if the daemon rejects a command.
+    int32_t subscribe(uint16_t pin);
     /// \brief The callback for pigpio alert interrupts.
     /// \param daemon_handle The handle for the pigpio daemon connection raising the callback.
     /// \param pin The GPIO pin associated with the alert.
@@ -57,6 +89,15 @@ private:
     /// \param data User data to pass into the callback.
     static void interrupt_callback(int32_t daemon_handle, uint32_t pin, uint32_t level, uint32_t tick, void* data);
 
+    // RECONNECT
+    /// \brief Reconnects if a result indicates the daemon connection dropped.
+    /// \param result The result of a daemon command.
+    /// \return TRUE if the driver reconnected and the command should be retried, otherwise FALSE.
+    bool recover(int32_t result) const;
+    /// \brief Restores the snapshot registers in one I2C zip command.
+    /// \exception std::runtime_error if the zip command fails.
+    void restore();
+
     // HANDLES
     /// \brief Stores the handle for an open pigpio daemon connection.
     int32_t m_daemon_handle;
@@ -64,6 +105,30 @@ private:
     int32_t m_i2c_handle;
     /// \brief Stores the interrupt callback handles.
     std::unordered_map<uint16_t, int32_t> m_callback_handles;
+
+    // SNAPSHOT
+    /// \brief The IP address of the daemon, or empty if the connection was provided by the application.
+    std::string m_ip_address;
+    /// \brief The port of the daemon.
+    uint16_t m_port;
+    /// \brief The I2C bus of the open session.
+    uint32_t m_i2c_bus;
+    /// \brief The I2C address of the open session.
+    uint8_t m_i2c_address;
+    /// \brief The last values written to the CONFIG, LO_THRESH and HI_THRESH registers.
+    mutable uint16_t m_registers[3];
+    /// \brief Flags the registers written since I2C was opened, by bit index of register address less one.
+    mutable uint8_t m_registers_written;
+    /// \brief The armed watchdog timeouts in milliseconds, by pin.
+    std::unordered_map<uint16_t, uint32_t> m_watchdogs;
+    /// \brief Indicates if the driver reconnects automatically.
+    bool m_auto_reconnect;
+
+    // METRICS
+    /// \brief The number of reconnects.
+    uint64_t m_reconnects;
+    /// \brief The duration of the latest reconnect in nanoseconds.
+    uint64_t m_reconnect_latency;
 };
 
 }}
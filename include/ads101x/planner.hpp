@@ -0,0 +1,127 @@
+/// \file ads101x/planner.hpp
+/// \brief Defines the ads101x::planner class.
+#ifndef ADS101X___PLANNER_H
+#define ADS101X___PLANNER_H
+
+// ads101x
+#include <ads101x/driver.hpp>
+#include <ads101x/variant.hpp>
+
+// std
+#include <vector>
+
+namespace ads101x {
+
+/// \brief Estimates whether an acquisition plan fits on an I2C bus, and admits it before any bus traffic starts.
+/// \details A plan lists the channels to acquire on the devices sharing one bus, each at a requested rate. The
+/// planner estimates the bus time of every sample from a cost model of the I2C wire time at the bus clock plus a fixed
+/// per-transaction overhead for the system call or daemon round trip, which is calibrated from measured transaction
+/// latencies. Single-shot channels cost a configuration write and a conversion read per sample, and occupy their
+/// device for the conversion time. Continuous channels cost a conversion read per sample and are limited to the data
+/// rate. Plans that would overrun the bus or a device are either rejected, or degraded by scaling rates down the same
+/// way every time: first per device, then uniformly across the bus.
+class planner
+{
+public:
+    // COST MODEL
+    /// \brief The cost of register transactions on a bus.
+    struct cost_model
+    {
+        /// \brief The I2C clock in Hz.
+        uint32_t clock_hz;
+        /// \brief The fixed overhead of each transaction in nanoseconds, such as the system call or daemon round trip.
+        uint64_t overhead_ns;
+
+        /// \brief Gets the time of a register write: address, pointer, and two data bytes.
+        /// \return The time in nanoseconds.
+        uint64_t write_ns() const;
+        /// \brief Gets the time of a register read: address and pointer, repeated start, address, and two data bytes.
+        /// \return The time in nanoseconds.
+        uint64_t read_ns() const;
+        /// \brief Calibrates the per-transaction overhead from measured conversion reads.
+        /// \details The median latency of the reads less their wire time at the bus clock is taken as the overhead.
+        /// \param driver The started driver to measure.
+        /// \param clock_hz The I2C clock of the bus in Hz.
+        /// \param transactions The number of reads to measure.
+        /// \return The calibrated cost model.
+        /// \exception std::runtime_error if a read fails.
+        static cost_model calibrate(ads101x::driver& driver, uint32_t clock_hz, uint32_t transactions = 64);
+    };
+
+    // PLAN
+    /// \brief A channel to acquire.
+    struct request
+    {
+        /// \brief The index of the device on the bus. Requests with the same index share a device.
+        uint32_t device;
+        /// \brief The multiplexer setting to acquire.
+        ads101x::configuration::multiplexer channel;
+        /// \brief The data rate to convert at.
+        ads101x::configuration::data_rate data_rate;
+        /// \brief CONTINUOUS to read a device's only channel as it converts, or SINGLESHOT to start each conversion.
+        ads101x::configuration::mode mode;
+        /// \brief The requested rate in samples per second.
+        double rate;
+        /// \brief The variant of the device, which determines the conversion time of the data rate.
+        ads101x::variant variant = ads101x::variant::ADS1015;
+    };
+    /// \brief The estimated load of a plan.
+    struct report
+    {
+        /// \brief The fraction of bus time used at the requested rates.
+        double bus_utilisation;
+        /// \brief The fraction of each device's time used at the requested rates, indexed by device.
+        std::vector<double> device_utilisation;
+        /// \brief The achievable rate of each request in samples per second, after degrading.
+        std::vector<double> rates;
+        /// \brief Indicates if every request can run at its requested rate.
+        bool feasible;
+    };
+    /// \brief Enumerates how admission treats plans that are not feasible.
+    enum class policy
+    {
+        REJECT,     ///< Reject the plan.
+        DEGRADE     ///< Admit the plan at its achievable rates.
+    };
+
+    // CONSTRUCTORS
+    /// \brief Creates a new planner for a bus.
+    /// \param model The cost model of the bus.
+    /// \param max_utilisation The largest fraction of bus time a plan may use, leaving headroom for jitter and other
+    /// traffic.
+    planner(const planner::cost_model& model, double max_utilisation = 0.8);
+
+    // PLANNING
+    /// \brief Estimates the load of a plan.
+    /// \param plan The requests of the plan.
+    /// \return The estimated load and achievable rates.
+    /// \exception std::runtime_error if the plan is invalid, e.g. a continuous channel shares its device.
+    planner::report evaluate(const std::vector<planner::request>& plan) const;
+    /// \brief Admits a plan.
+    /// \param plan The requests of the plan.
+    /// \param policy How to treat a plan that is not feasible.
+    /// \return The rate to run each request at in samples per second.
+    /// \exception std::runtime_error if the plan is invalid, or not feasible and the policy is REJECT.
+    std::vector<double> admit(const std::vector<planner::request>& plan, planner::policy policy) const;
+
+private:
+    // COSTS
+    /// \brief Gets the bus time of one sample of a request.
+    /// \param request The request.
+    /// \return The time in seconds.
+    double bus_time(const planner::request& request) const;
+    /// \brief Gets the device time of one sample of a single-shot request.
+    /// \param request The request.
+    /// \return The time in seconds.
+    double device_time(const planner::request& request) const;
+
+    // SETTINGS
+    /// \brief The cost model of the bus.
+    planner::cost_model m_model;
+    /// \brief The largest fraction of bus time a plan may use.
+    double m_max_utilisation;
+};
+
+}
+
+#endif
@@ -0,0 +1,50 @@
+/// \file ads101x/realtime.hpp
+/// \brief Defines the ads101x real-time thread profile.
+#ifndef ADS101X___REALTIME_H
+#define ADS101X___REALTIME_H
+
+// std
+#include <stddef.h>
+#include <stdint.h>
+
+namespace ads101x {
+
+/// \brief The real-time settings requested for a thread.
+/// \details Every setting is opt-in. Settings that require privileges (typically CAP_SYS_NICE for scheduling and
+/// CAP_IPC_LOCK or a sufficient RLIMIT_MEMLOCK for memory locking) may be refused; see realtime_report.
+struct realtime_profile
+{
+    /// \brief The SCHED_FIFO priority (1-99), or 0 to keep the default scheduling policy.
+    int32_t priority = 0;
+    /// \brief The CPU to pin the thread to, or -1 to leave the affinity unchanged.
+    int32_t cpu = -1;
+    /// \brief Locks all current and future process memory into RAM with mlockall.
+    bool lock_memory = false;
+    /// \brief Touches the thread's stack and all preallocated buffers before work starts.
+    bool prefault = false;
+    /// \brief The number of bytes of stack to prefault.
+    size_t stack_size = 64 * 1024;
+};
+
+/// \brief Reports which real-time settings were actually granted.
+struct realtime_report
+{
+    /// \brief Indicates if SCHED_FIFO at the requested priority was granted.
+    bool scheduling = false;
+    /// \brief Indicates if the CPU affinity was granted.
+    bool affinity = false;
+    /// \brief Indicates if memory was locked.
+    bool memory_locked = false;
+    /// \brief Indicates if the stack and buffers were prefaulted.
+    bool prefaulted = false;
+};
+
+/// \brief Applies a real-time profile to the calling thread.
+/// \details Never throws. Each setting that is not requested is reported as not granted.
+/// \param profile The settings to apply.
+/// \return The settings that were granted. prefaulted covers only the stack; callers prefault their own buffers.
+ads101x::realtime_report apply_realtime(const ads101x::realtime_profile& profile);
+
+}
+
+#endif
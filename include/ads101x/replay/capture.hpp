@@ -0,0 +1,85 @@
+/// \file ads101x/replay/capture.hpp
+/// \brief Defines the ads101x::replay::capture class.
+#ifndef ADS101X___REPLAY___CAPTURE_H
+#define ADS101X___REPLAY___CAPTURE_H
+
+// ads101x
+#include <ads101x/sample.hpp>
+
+// std
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ads101x {
+/// \brief Contains all code for replaying recorded captures through the driver API.
+namespace replay {
+
+/// \brief A recorded sequence of conversions and ALERT/RDY edges.
+/// \details Captures are stored as text, one event per line, with times in nanoseconds from the start of the capture:
+/// \code
+/// # Comments start with '#'.
+/// <time_ns> <value>           A conversion with a signed 12-bit value.
+/// <time_ns> alert <0|1>       An explicit ALERT/RDY level, such as a comparator edge.
+/// \endcode
+/// Events must be in time order.
+class capture
+{
+public:
+    // EVENTS
+    /// \brief A captured event.
+    struct event
+    {
+        /// \brief The time of the event in nanoseconds from the start of the capture.
+        uint64_t time;
+        /// \brief The conversion value, if the event is a conversion.
+        int16_t value;
+        /// \brief Indicates if the event is an explicit ALERT/RDY level instead of a conversion.
+        bool alert;
+        /// \brief The ALERT/RDY level, if the event is an explicit edge.
+        bool level;
+    };
+    /// \brief Adds a conversion.
+    /// \param time The time of the conversion in nanoseconds from the start of the capture.
+    /// \param value The signed 12-bit conversion value.
+    /// \exception std::runtime_error if the time is before the previous event.
+    void add_conversion(uint64_t time, int16_t value);
+    /// \brief Adds an explicit ALERT/RDY level change.
+    /// \param time The time of the edge in nanoseconds from the start of the capture.
+    /// \param level The new ALERT/RDY level.
+    /// \exception std::runtime_error if the time is before the previous event.
+    void add_alert(uint64_t time, bool level);
+    /// \brief Adds acquired samples as conversions, timed relative to the first sample added.
+    /// \param samples The samples to add.
+    void add_samples(std::span<const ads101x::sample> samples);
+    /// \brief Gets the captured events.
+    /// \return The events in time order.
+    const std::vector<capture::event>& events() const;
+    /// \brief Gets the number of conversions in the capture.
+    /// \return The number of conversions.
+    uint64_t conversions() const;
+
+    // FILES
+    /// \brief Appends the events of a capture file.
+    /// \param path The path of the file.
+    /// \exception std::runtime_error if the file cannot be read or is invalid.
+    void load(const std::string& path);
+    /// \brief Writes the capture to a file.
+    /// \param path The path of the file.
+    /// \exception std::runtime_error if the file cannot be written.
+    void save(const std::string& path) const;
+
+private:
+    /// \brief The captured events.
+    std::vector<capture::event> m_events;
+    /// \brief The number of conversions.
+    uint64_t m_conversions = 0;
+    /// \brief The timestamp of the first sample added by add_samples().
+    uint64_t m_sample_epoch = 0;
+    /// \brief Indicates if m_sample_epoch is set.
+    bool m_has_sample_epoch = false;
+};
+
+}}
+
+#endif
@@ -0,0 +1,129 @@
+/// \file ads101x/replay/driver.hpp
+/// \brief Defines the ads101x::replay::driver class.
+#ifndef ADS101X___REPLAY___DRIVER_H
+#define ADS101X___REPLAY___DRIVER_H
+
+// ads101x
+#include <ads101x/driver.hpp>
+#include <ads101x/replay/capture.hpp>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace ads101x {
+namespace replay {
+
+/// \brief An ADS101X driver that serves conversions and ALERT/RDY edges from a recorded capture.
+/// \details At a positive speed, the capture plays back on its own timeline, scaled by the speed factor, from the time
+/// the driver is started: read_conversion() returns the latest conversion, and a conversion-ready pulse is raised for
+/// each conversion while the comparator is enabled. At speed zero the capture plays as fast as possible: each
+/// conversion read advances to the next conversion and immediately signals it as ready. Explicit alert events drive
+/// ALERT/RDY directly in both modes. Playback is deterministic, so pipelines can be benchmarked well beyond real-time
+/// rates against real-world signals.
+class driver
+    : public ads101x::driver
+{
+public:
+    // CONSTRUCTORS
+    /// \brief Creates a replay driver for a capture.
+    /// \param capture The capture to replay. It is copied.
+    /// \exception std::runtime_error if the capture has no conversions.
+    driver(const replay::capture& capture);
+    ~driver();
+
+    // PLAYBACK
+    /// \brief Sets the playback speed. Takes effect the next time the driver is started.
+    /// \param speed The speed factor relative to real time, or zero to play as fast as possible.
+    /// \exception std::runtime_error if the speed is negative.
+    void set_speed(double speed);
+    /// \brief Sets whether playback restarts from the beginning after the last event.
+    /// \param loop TRUE to loop, FALSE to hold the last conversion once finished.
+    void set_loop(bool loop);
+    /// \brief Indicates if playback reached the end of a non-looping capture.
+    /// \return TRUE if finished, otherwise FALSE.
+    bool finished() const;
+    /// \brief Gets the number of conversions played back.
+    /// \return The number of conversions.
+    uint64_t played() const;
+
+private:
+    // OVERRIDES
+    void open_i2c(uint32_t i2c_bus, uint8_t i2c_address) override;
+    void close_i2c() override;
+    void write_register(uint8_t register_address, uint16_t value) const override;
+    uint16_t read_register(uint8_t register_address) const override;
+    void attach_interrupt(uint16_t pin) override;
+    void detach_interrupt(uint16_t pin) override;
+
+    // PLAYBACK
+    /// \brief The ALERT/RDY activity produced by playing an event.
+    struct activity
+    {
+        /// \brief Indicates if a conversion-ready pulse should be raised.
+        bool pulse;
+        /// \brief Indicates if the level should be driven.
+        bool drive;
+        /// \brief The level to drive.
+        bool level;
+        /// \brief The configuration when the event played.
+        uint16_t config;
+    };
+    /// \brief Runs the timed playback thread.
+    void run();
+    /// \brief Plays events up to and including the next conversion. Requires m_mutex.
+    /// \param activity Accumulates the ALERT/RDY activity of the played events.
+    /// \return FALSE if the capture is finished, otherwise TRUE.
+    bool play_next(driver::activity& activity) const;
+    /// \brief Drives ALERT/RDY for played events. Must be called without m_mutex.
+    void drive(const driver::activity& activity) const;
+    /// \brief Raises an ALERT/RDY edge if the pin level changed.
+    void drive_alert_rdy(bool level) const;
+
+    // CAPTURE
+    /// \brief The events of the capture.
+    std::vector<replay::capture::event> m_events;
+    /// \brief The duration of one pass through the capture, used when looping.
+    uint64_t m_duration;
+    /// \brief The playback speed.
+    double m_speed;
+    /// \brief Indicates if playback loops.
+    bool m_loop;
+
+    // STATE
+    /// \brief Protects the playback state.
+    mutable std::mutex m_mutex;
+    /// \brief Wakes the playback thread when stopping.
+    mutable std::condition_variable m_wake;
+    /// \brief The playback thread.
+    std::thread m_thread;
+    /// \brief Indicates if the playback thread should run.
+    bool m_running;
+    /// \brief The index of the next event to play.
+    mutable size_t m_cursor;
+    /// \brief The number of completed passes through the capture.
+    mutable uint64_t m_passes;
+    /// \brief The device registers.
+    mutable uint16_t m_registers[4];
+    /// \brief The time playback started.
+    std::chrono::steady_clock::time_point m_epoch;
+    /// \brief Indicates if playback finished.
+    mutable std::atomic<bool> m_finished;
+    /// \brief The number of conversions played.
+    mutable std::atomic<uint64_t> m_played;
+
+    // ALERT_RDY
+    /// \brief Serializes interrupt delivery with interrupt detachment.
+    mutable std::recursive_mutex m_interrupt_mutex;
+    /// \brief The attached ALERT_RDY pin, or -1 if not attached.
+    int32_t m_interrupt_pin;
+    /// \brief The current ALERT_RDY pin level.
+    mutable bool m_alert_rdy_level;
+};
+
+}}
+
+#endif
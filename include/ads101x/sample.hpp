@@ -0,0 +1,50 @@
+/// \file ads101x/sample.hpp
+/// \brief Defines the ads101x::sample structure.
+#ifndef ADS101X___SAMPLE_H
+#define ADS101X___SAMPLE_H
+
+// ads101x
+#include <ads101x/configuration.hpp>
+
+// std
+#include <stdint.h>
+
+namespace ads101x {
+
+/// \brief A conversion value tagged with the full-scale range, channel, and time it was taken at.
+struct sample
+{
+    // CONSTRUCTORS
+    /// \brief Creates a zero-valued sample at the default full-scale range.
+    sample();
+    /// \brief Creates a sample from a 12-bit conversion value.
+    /// \param conversion The 12-bit two's complement conversion value, as returned by driver::read_conversion().
+    /// \param fsr The full-scale range the conversion was taken at.
+    sample(uint16_t conversion, ads101x::configuration::fsr fsr);
+
+    // VALUES
+    /// \brief The sign-extended conversion value, in the range [-2048, 2047].
+    int16_t value;
+    /// \brief The full-scale range the conversion was taken at.
+    ads101x::configuration::fsr fsr;
+    /// \brief The multiplexer setting the conversion was taken on.
+    ads101x::configuration::multiplexer channel;
+    /// \brief The CLOCK_MONOTONIC time the conversion was read, in nanoseconds.
+    uint64_t timestamp;
+    /// \brief The sequence number of the sample within its stream.
+    uint64_t sequence;
+
+    // CONVERSION
+    /// \brief Converts the sample to a voltage using its full-scale range.
+    /// \return The sample voltage in volts.
+    double voltage() const;
+};
+
+/// \brief Gets the positive full-scale voltage of a full-scale range.
+/// \param fsr The full-scale range.
+/// \return The positive full-scale voltage in volts.
+double fsr_voltage(ads101x::configuration::fsr fsr);
+
+}
+
+#endif
@@ -0,0 +1,145 @@
+/// \file ads101x/sampler.hpp
+/// \brief Defines the ads101x::sampler class.
+#ifndef ADS101X___SAMPLER_H
+#define ADS101X___SAMPLER_H
+
+// ads101x
+#include <ads101x/driver.hpp>
+#include <ads101x/event.hpp>
+#include <ads101x/sample.hpp>
+#include <ads101x/variant.hpp>
+
+// std
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace ads101x {
+
+/// \brief Samples many devices and channels at arbitrary low rates from a single thread.
+/// \details Each task takes one SINGLESHOT conversion per period, so channels that only need a few samples per second
+/// cost a few bus transactions per second instead of a continuous conversion stream, and the devices power down
+/// between conversions. The thread sleeps on a timerfd armed with absolute CLOCK_MONOTONIC deadlines, so the
+/// schedule does not drift with wake-up latency: a task's conversions start at exactly start + n * period. Tasks on
+/// the same device take turns, earliest deadline first. A task that cannot start before its next deadline skips the
+/// missed periods, which are reported as overruns.
+class sampler
+{
+public:
+    // CONSTRUCTORS
+    /// \brief Creates a new sampler.
+    /// \exception std::runtime_error if the timerfd cannot be created.
+    sampler();
+    ~sampler();
+
+    // TASKS
+    /// \brief Adds a periodic conversion. Must be called before the sampler starts.
+    /// \details The operation, mode, and multiplexer fields of the configuration are managed by the sampler.
+    /// \param driver The started driver of the device. Must outlive the sampler's thread.
+    /// \param configuration The configuration to convert with.
+    /// \param channel The multiplexer setting to convert.
+    /// \param period_ns The period between conversions in nanoseconds. Must exceed the conversion time.
+    /// \param callback The callback raised on the sampler thread with each sample. It must not block.
+    /// \param variant The variant of the device, which determines the conversion time of the data rate.
+    /// \return The index of the task.
+    /// \exception std::runtime_error if the sampler is running or the period is too short.
+    uint32_t add(ads101x::driver& driver, const ads101x::configuration& configuration, ads101x::configuration::multiplexer channel, uint64_t period_ns, std::function<void(const ads101x::sample&)> callback, ads101x::variant variant = ads101x::variant::ADS1015);
+
+    // CONTROL
+    /// \brief Starts the sampler thread. The first conversion of every task starts immediately.
+    /// \exception std::runtime_error if the sampler is already running or has no tasks.
+    void start();
+    /// \brief Stops the sampler thread, abandoning conversions in progress.
+    void stop();
+    /// \brief Indicates if the sampler thread is running.
+    /// \return TRUE if running, otherwise FALSE.
+    bool running() const;
+
+    // METRICS
+    /// \brief Gets the number of samples a task has delivered.
+    /// \param task The index of the task.
+    /// \return The number of samples.
+    uint64_t samples(uint32_t task) const;
+    /// \brief Gets the number of periods a task skipped because it could not start in time.
+    /// \param task The index of the task.
+    /// \return The number of overruns.
+    uint64_t overruns(uint32_t task) const;
+    /// \brief Gets the number of failed conversions of a task.
+    /// \param task The index of the task.
+    /// \return The number of errors.
+    uint64_t errors(uint32_t task) const;
+    /// \brief Gets the longest delay between a task's deadline and the start of its conversion.
+    /// \param task The index of the task.
+    /// \return The delay in nanoseconds.
+    uint64_t max_latency(uint32_t task) const;
+
+private:
+    // TASKS
+    /// \brief A periodic conversion.
+    struct task
+    {
+        /// \brief The index of the task's device.
+        uint32_t device;
+        /// \brief The configuration that starts the conversion.
+        ads101x::configuration configuration;
+        /// \brief The period between conversions in nanoseconds.
+        uint64_t period;
+        /// \brief The time to wait for a conversion in nanoseconds.
+        uint64_t conversion;
+        /// \brief The sample callback.
+        std::function<void(const ads101x::sample&)> callback;
+        /// \brief The next scheduled conversion start.
+        uint64_t deadline;
+        /// \brief The time the conversion in progress started, or zero if none is.
+        uint64_t started;
+        /// \brief The number of samples delivered.
+        std::atomic<uint64_t> samples;
+        /// \brief The number of skipped periods.
+        std::atomic<uint64_t> overruns;
+        /// \brief The number of failed conversions.
+        std::atomic<uint64_t> errors;
+        /// \brief The longest start delay.
+        std::atomic<uint64_t> max_latency;
+    };
+    /// \brief A device shared by tasks.
+    struct device
+    {
+        /// \brief The driver of the device.
+        ads101x::driver* driver;
+        /// \brief Indicates if a conversion is in progress on the device.
+        bool busy;
+    };
+
+    // THREAD
+    /// \brief The sampler thread function.
+    void run();
+    /// \brief Completes the conversions that are due.
+    /// \param now The current time.
+    void complete(uint64_t now);
+    /// \brief Starts the conversions that are due on idle devices.
+    /// \param now The current time.
+    void begin(uint64_t now);
+    /// \brief Gets the time the thread must next wake.
+    /// \return The wake time, in CLOCK_MONOTONIC nanoseconds.
+    uint64_t next_wake() const;
+
+    // STATE
+    /// \brief The tasks.
+    std::vector<std::unique_ptr<sampler::task>> m_tasks;
+    /// \brief The devices.
+    std::vector<sampler::device> m_devices;
+    /// \brief The timerfd the thread sleeps on.
+    int32_t m_timer;
+    /// \brief Wakes the thread to stop.
+    ads101x::event m_stop;
+    /// \brief The sampler thread.
+    std::thread m_thread;
+    /// \brief Indicates if the sampler thread is running.
+    std::atomic<bool> m_running;
+};
+
+}
+
+#endif
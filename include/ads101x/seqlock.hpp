@@ -0,0 +1,112 @@
+/// \file ads101x/seqlock.hpp
+/// \brief Defines the ads101x::seqlock class.
+#ifndef ADS101X___SEQLOCK_H
+#define ADS101X___SEQLOCK_H
+
+// std
+#include <atomic>
+#include <cstring>
+#include <stdint.h>
+#include <type_traits>
+
+namespace ads101x {
+
+/// \brief A single-writer slot holding the latest value, which any number of threads can read without locks.
+/// \details The writer never waits, and readers never block the writer or each other and make no system calls. The
+/// slot's sequence is odd while a value is being stored, and readers retry a read that overlapped a store, so a
+/// torn value is never returned. The value is copied through relaxed atomic words, which keeps concurrent access
+/// free of data races. Each slot occupies its own cache line, so slots in an array do not share lines.
+/// \tparam T The trivially copyable value type.
+template<typename T>
+class alignas(64) seqlock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "seqlock value type must be trivially copyable");
+
+public:
+    // CONSTRUCTORS
+    /// \brief Creates an empty slot.
+    seqlock()
+        : m_sequence(0)
+    {
+        for(auto& word : seqlock::m_words)
+        {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // WRITER
+    /// \brief Stores a new value. Must only be called by one thread at a time.
+    /// \param value The value to store.
+    void store(const T& value)
+    {
+        // Copy the value into words.
+        uint64_t words[seqlock::word_count] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        // Flag the store in progress, ordering the flag before the words.
+        uint64_t sequence = seqlock::m_sequence.load(std::memory_order_relaxed);
+        seqlock::m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        // Store the words, and publish them.
+        for(uint32_t i = 0; i < seqlock::word_count; ++i)
+        {
+            seqlock::m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+        seqlock::m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // READERS
+    /// \brief Loads the latest value.
+    /// \param value The value to store the latest value in. Unchanged if the slot is empty.
+    /// \return TRUE if a value has been stored, otherwise FALSE.
+    bool load(T& value) const
+    {
+        uint64_t words[seqlock::word_count];
+        while(true)
+        {
+            // Read the sequence, retrying while a store is in progress.
+            uint64_t sequence = seqlock::m_sequence.load(std::memory_order_acquire);
+            if(sequence == 0)
+            {
+                return false;
+            }
+            if(sequence & 1)
+            {
+                continue;
+            }
+
+            // Copy the words, and verify no store overlapped the copy.
+            for(uint32_t i = 0; i < seqlock::word_count; ++i)
+            {
+                words[i] = seqlock::m_words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(seqlock::m_sequence.load(std::memory_order_relaxed) == sequence)
+            {
+                break;
+            }
+        }
+        std::memcpy(&value, words, sizeof(T));
+        return true;
+    }
+    /// \brief Gets the number of values stored, letting a reader check for a new value without copying it.
+    /// \return The number of values stored.
+    uint64_t version() const
+    {
+        return seqlock::m_sequence.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    /// \brief The number of 64-bit words holding the value.
+    static constexpr uint32_t word_count = (sizeof(T) + 7) / 8;
+
+    /// \brief The sequence, odd while a store is in progress.
+    std::atomic<uint64_t> m_sequence;
+    /// \brief The words holding the value.
+    std::atomic<uint64_t> m_words[seqlock::word_count];
+};
+
+}
+
+#endif
@@ -0,0 +1,223 @@
+/// \file ads101x/serialized_driver.hpp
+/// \brief Defines the ads101x::serialized_driver class.
+#ifndef ADS101X___SERIALIZED_DRIVER_H
+#define ADS101X___SERIALIZED_DRIVER_H
+
+// ads101x
+#include <ads101x/driver.hpp>
+#include <ads101x/histogram.hpp>
+
+// std
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <span>
+
+namespace ads101x {
+
+/// \brief A thread-safe front end that serializes all bus operations of a driver through one queue.
+/// \details Any number of threads may call into a serialized_driver concurrently. Each call enqueues an operation on
+/// a lock-free multi-producer queue. Whichever caller finds the bus free becomes the bus owner and executes every
+/// queued operation in FIFO order, including those of other threads, while the other callers sleep until their
+/// operation completes. Reads of the same register that are queued together without an intervening write are
+/// served by a single bus transaction. The most recent CONFIG, LO_THRESH and HI_THRESH values are cached and can be
+/// read without touching the queue.
+///
+/// Each operation belongs to a priority class with its own queue. The bus owner checks the HIGH queue at every
+/// preemption point between transactions and executes it before the next LOW operation, so a control loop's reads
+/// wait for at most one transaction of a busy logger. LOW block reads can be split into chunks with
+/// set_preemption_interval() to add preemption points inside them.
+class serialized_driver
+{
+public:
+    // PRIORITIES
+    /// \brief Enumerates the priority classes of operations.
+    enum class priority
+    {
+        HIGH,   ///< Time-critical operations, such as the reads of a control loop.
+        LOW     ///< Background operations, such as logging, which yield to queued HIGH operations.
+    };
+
+    // CONSTRUCTORS
+    /// \brief Creates a new serialized front end for a driver.
+    /// \param driver The driver to serialize. All bus access must go through this front end while it exists.
+    serialized_driver(ads101x::driver& driver);
+
+    // CONFIGURATION
+    /// \brief Writes a configuration to the ADS101X.
+    /// \param configuration The configuration to write.
+    /// \param priority The priority class of the operation.
+    /// \exception std::runtime_error if the write command fails.
+    void write_config(const ads101x::configuration& configuration, serialized_driver::priority priority = serialized_driver::priority::HIGH);
+    /// \brief Reads the configuration from the ADS101X.
+    /// \param priority The priority class of the operation.
+    /// \return The current configuration stored on the ADS101X.
+    /// \exception std::runtime_error if the read command fails.
+    ads101x::configuration read_config(serialized_driver::priority priority = serialized_driver::priority::HIGH);
+
+    // CONVERSION
+    /// \brief Reads the conversion value from the ADS101X.
+    /// \param priority The priority class of the operation.
+    /// \return The 12bit conversion value.
+    /// \exception std::runtime_error if the read command fails.
+    uint16_t read_conversion(serialized_driver::priority priority = serialized_driver::priority::HIGH);
+    /// \brief Reads a block of conversion values from the ADS101X back to back.
+    /// \details The block is read as one queued operation, so it is not interleaved with other operations. LOW blocks
+    /// are split into chunks at the preemption interval, and other operations may run between the chunks. Block reads
+    /// only touch the conversion register, so they leave the register cache intact.
+    /// \param conversions The caller-owned buffer to fill with 12bit conversion values.
+    /// \param priority The priority class of the operation.
+    /// \exception std::runtime_error if a read command fails.
+    void read_conversions(std::span<uint16_t> conversions, serialized_driver::priority priority = serialized_driver::priority::HIGH);
+
+    // THRESHOLDS
+    /// \brief Writes a comparator low threshold value to the ADS101X.
+    /// \param value The 12-bit low threshold value to write.
+    /// \param priority The priority class of the operation.
+    /// \exception std::runtime_error if the write command fails.
+    void write_lo_thresh(uint16_t value, serialized_driver::priority priority = serialized_driver::priority::HIGH);
+    /// \brief Reads the comparator low threshold value from the ADS101X.
+    /// \param priority The priority class of the operation.
+    /// \return The current 12-bit low threshold value.
+    /// \exception std::runtime_error if the read command fails.
+    uint16_t read_lo_thresh(serialized_driver::priority priority = serialized_driver::priority::HIGH);
+    /// \brief Writes a comparator high threshold value to the ADS101X.
+    /// \param value The 12-bit high threshold value to write.
+    /// \param priority The priority class of the operation.
+    /// \exception std::runtime_error if the write command fails.
+    void write_hi_thresh(uint16_t value, serialized_driver::priority priority = serialized_driver::priority::HIGH);
+    /// \brief Reads the comparator high threshold value from the ADS101X.
+    /// \param priority The priority class of the operation.
+    /// \return The current 12-bit high threshold value.
+    /// \exception std::runtime_error if the read command fails.
+    uint16_t read_hi_thresh(serialized_driver::priority priority = serialized_driver::priority::HIGH);
+
+    // SEQUENCES
+    /// \brief Executes a sequence of driver operations atomically with respect to all other operations.
+    /// \param sequence The sequence to execute with exclusive access to the driver.
+    /// \param priority The priority class of the operation.
+    /// \exception Rethrows any exception thrown by the sequence.
+    void execute(const std::function<void(ads101x::driver&)>& sequence, serialized_driver::priority priority = serialized_driver::priority::HIGH);
+
+    // CACHE
+    /// \brief Gets the last configuration written to or read from the ADS101X without a bus transaction.
+    /// \param configuration The configuration to store the cached value in.
+    /// \return TRUE if a cached value was available, otherwise FALSE.
+    bool cached_config(ads101x::configuration& configuration) const;
+    /// \brief Gets the last low threshold written to or read from the ADS101X without a bus transaction.
+    /// \param value The value to store the cached threshold in.
+    /// \return TRUE if a cached value was available, otherwise FALSE.
+    bool cached_lo_thresh(uint16_t& value) const;
+    /// \brief Gets the last high threshold written to or read from the ADS101X without a bus transaction.
+    /// \param value The value to store the cached threshold in.
+    /// \return TRUE if a cached value was available, otherwise FALSE.
+    bool cached_hi_thresh(uint16_t& value) const;
+    /// \brief Invalidates the cached register values, e.g. after the device was reset externally.
+    void invalidate_cache();
+
+    // PREEMPTION
+    /// \brief Sets the number of values after which LOW block reads reach a preemption point.
+    /// \details Smaller chunks bound the wait of HIGH operations more tightly, at the cost of a queue round trip per
+    /// chunk.
+    /// \param values The number of values per chunk, or zero to read LOW blocks as one operation.
+    void set_preemption_interval(uint32_t values);
+
+    // METRICS
+    /// \brief Gets the number of bus transactions that were saved by coalescing queued reads.
+    /// \return The number of coalesced reads.
+    uint64_t coalesced_reads() const;
+    /// \brief Gets the number of times queued HIGH operations ran at a preemption point after a LOW operation.
+    /// \return The number of preemptions.
+    uint64_t preemptions() const;
+    /// \brief Gets the latency of a priority class, from submitting each operation until it completed.
+    /// \details The histogram is recorded by the bus owner, so read it only while no operations are in flight.
+    /// \param priority The priority class.
+    /// \return The latency histogram in nanoseconds.
+    const ads101x::histogram& latency(serialized_driver::priority priority) const;
+
+private:
+    // OPERATIONS
+    /// \brief Enumerates the kinds of queued operations.
+    enum class kind
+    {
+        WRITE,      ///< Write a register.
+        READ,       ///< Read a register.
+        BLOCK,      ///< Read a block of conversion values.
+        SEQUENCE    ///< Execute a sequence.
+    };
+    /// \brief A queued operation, stored on the stack of the calling thread.
+    struct operation
+    {
+        /// \brief The kind of operation.
+        serialized_driver::kind kind;
+        /// \brief The priority class of the operation.
+        serialized_driver::priority priority;
+        /// \brief The CLOCK_MONOTONIC time the operation was submitted in nanoseconds.
+        uint64_t submitted;
+        /// \brief The register address to read or write.
+        ads101x::register_address address;
+        /// \brief The value to write, or the value read.
+        uint16_t value;
+        /// \brief The buffer to read a block of conversion values into.
+        std::span<uint16_t> block;
+        /// \brief The sequence to execute.
+        const std::function<void(ads101x::driver&)>* sequence;
+        /// \brief Any exception raised while executing the operation.
+        std::exception_ptr exception;
+        /// \brief Set once the operation has been executed.
+        std::atomic<bool> done;
+        /// \brief The next operation in the queue.
+        serialized_driver::operation* next;
+    };
+    /// \brief Submits an operation and waits for it to complete, becoming the bus owner if the bus is free.
+    /// \param operation The operation to submit.
+    void submit(serialized_driver::operation& operation);
+    /// \brief Executes all queued operations, HIGH first at every preemption point. Must only be called by the bus
+    /// owner.
+    void drain();
+    /// \brief Takes the queued operations of a priority class.
+    /// \param priority The priority class.
+    /// \return The operations in submission order.
+    serialized_driver::operation* take(serialized_driver::priority priority);
+    /// \brief Executes an operation, records its latency, and releases its caller.
+    /// \param operation The operation to execute.
+    /// \param read_valid Flags the registers read by the current batch.
+    /// \param read_value The register values read by the current batch.
+    void dispatch(serialized_driver::operation& operation, bool (&read_valid)[4], uint16_t (&read_value)[4]);
+    /// \brief Executes a register read or write on the bus.
+    void transact(serialized_driver::operation& operation);
+    /// \brief Updates the register cache.
+    void cache(ads101x::register_address address, uint16_t value);
+
+    // DRIVER
+    /// \brief The driver being serialized.
+    ads101x::driver& m_driver;
+
+    // QUEUE
+    /// \brief The heads of the lock-free submission stacks, indexed by priority class.
+    std::atomic<serialized_driver::operation*> m_head[2];
+    /// \brief Indicates if a thread currently owns the bus.
+    std::atomic<bool> m_owned;
+    /// \brief Counts completed operations. Callers waiting for the bus owner sleep on it.
+    std::atomic<uint32_t> m_completions;
+
+    // CACHE
+    /// \brief The cached CONFIG, LO_THRESH, and HI_THRESH register values, with bit 16 flagging validity.
+    std::atomic<uint32_t> m_cache[3];
+
+    // METRICS
+    /// \brief The number of reads served by a coalesced bus transaction.
+    std::atomic<uint64_t> m_coalesced_reads;
+    /// \brief The number of times HIGH operations ran at a preemption point after a LOW operation.
+    std::atomic<uint64_t> m_preemptions;
+    /// \brief The latency histograms, indexed by priority class.
+    ads101x::histogram m_latency[2];
+
+    // PREEMPTION
+    /// \brief The number of values per chunk of LOW block reads, or zero.
+    std::atomic<uint32_t> m_preemption_interval;
+};
+
+}
+
+#endif
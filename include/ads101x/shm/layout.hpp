@@ -0,0 +1,76 @@
+/// \file ads101x/shm/layout.hpp
+/// \brief Defines the shared memory layout of the ads101x sample bus.
+#ifndef ADS101X___SHM___LAYOUT_H
+#define ADS101X___SHM___LAYOUT_H
+
+// ads101x
+#include <ads101x/sample.hpp>
+
+// std
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+
+namespace ads101x {
+/// \brief Contains all code for sharing the sample stream between processes.
+namespace shm {
+
+/// \brief The magic number at the start of every sample bus ("ADSB").
+constexpr uint32_t magic = 0x41445342;
+/// \brief The version of the sample bus layout.
+constexpr uint32_t version = 1;
+
+/// \brief The header at the start of the shared memory object.
+/// \details The shared memory object holds this header, followed by block_count block headers, followed by
+/// block_count blocks of block_size samples.
+struct alignas(64) header
+{
+    /// \brief The magic number identifying the sample bus.
+    uint32_t magic;
+    /// \brief The layout version.
+    uint32_t version;
+    /// \brief The number of blocks in the ring.
+    uint32_t block_count;
+    /// \brief The number of samples in each block.
+    uint32_t block_size;
+    /// \brief The number of blocks published.
+    std::atomic<uint64_t> published;
+    /// \brief Incremented with each publish or close. Used as a process-shared futex.
+    std::atomic<uint32_t> generation;
+    /// \brief The number of readers waiting on the generation futex.
+    std::atomic<uint32_t> waiters;
+    /// \brief Set when the publisher closes the bus.
+    std::atomic<uint32_t> closed;
+};
+
+/// \brief The header of each block in the ring.
+/// \details The sequence of the block holding publish index n is 2n+1 while it is written and 2n+2 once published.
+struct block
+{
+    /// \brief The seqlock sequence of the block.
+    std::atomic<uint64_t> sequence;
+    /// \brief The number of samples in the block.
+    std::atomic<uint32_t> count;
+    /// \brief Reserved for alignment.
+    uint32_t reserved;
+};
+
+/// \brief Gets the total size of a sample bus.
+/// \param block_count The number of blocks in the ring.
+/// \param block_size The number of samples in each block.
+/// \return The size of the shared memory object in bytes.
+constexpr size_t size(uint32_t block_count, uint32_t block_size)
+{
+    return sizeof(shm::header) + sizeof(shm::block) * block_count + sizeof(ads101x::sample) * block_count * block_size;
+}
+
+// Every process must agree on the layout, and must be able to access it without locks.
+static_assert(std::is_trivially_copyable_v<ads101x::sample>, "samples must be trivially copyable to be shared");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "the sample bus requires lock-free 64-bit atomics");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "the sample bus requires lock-free 32-bit atomics");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "the generation futex must be a plain 32-bit word");
+
+}}
+
+#endif
@@ -0,0 +1,85 @@
+/// \file ads101x/shm/publisher.hpp
+/// \brief Defines the ads101x::shm::publisher class.
+#ifndef ADS101X___SHM___PUBLISHER_H
+#define ADS101X___SHM___PUBLISHER_H
+
+// ads101x
+#include <ads101x/acquisition.hpp>
+#include <ads101x/sample.hpp>
+#include <ads101x/shm/layout.hpp>
+
+// std
+#include <span>
+#include <string>
+
+namespace ads101x {
+namespace shm {
+
+/// \brief Publishes a sample stream into a POSIX shared memory ring for other processes.
+/// \details The ring uses the same seqlock block scheme as ads101x::broadcast_ring, so publishing never waits for
+/// readers and readers never block the publisher. Only one process can own the I2C device, so this lets other
+/// processes consume its acquisition through ads101x::shm::reader instead of opening their own sessions.
+class publisher
+{
+public:
+    // CONSTRUCTORS
+    /// \brief Creates a new sample bus.
+    /// \details The publisher owns the bus through a lock on its shared memory object. A bus left by a publisher that
+    /// exited without removing it is replaced, but a bus owned by a running publisher is not. The object is readable
+    /// and writable by the owner and group, so readers must run as the same user or group.
+    /// \param name The POSIX shared memory name, beginning with '/'.
+    /// \param block_count The number of blocks in the ring.
+    /// \param block_size The maximum number of samples in each block.
+    /// \exception std::runtime_error if the bus is owned by a running publisher, or cannot be created.
+    publisher(const std::string& name, uint32_t block_count = 64, uint32_t block_size = 32);
+    /// \brief Closes the sample bus and removes its shared memory object.
+    /// \details Readers that already mapped the bus can finish reading it.
+    ~publisher();
+    publisher(const publisher&) = delete;
+    publisher& operator=(const publisher&) = delete;
+
+    // PUBLISHING
+    /// \brief Publishes samples to the bus.
+    /// \details Samples are split into blocks of at most block_size samples.
+    /// \param samples The samples to publish.
+    void publish(std::span<const ads101x::sample> samples);
+    /// \brief Publishes every block acquired by an acquisition.
+    /// \details Adds a sink to the acquisition. The publisher must outlive the acquisition's thread.
+    /// \param acquisition The acquisition to publish.
+    void attach(ads101x::acquisition& acquisition);
+    /// \brief Marks the bus closed and wakes all waiting readers.
+    void close();
+
+    // PROPERTIES
+    /// \brief Gets the name of the shared memory object.
+    /// \return The name.
+    const std::string& name() const;
+    /// \brief Gets the number of blocks published.
+    /// \return The number of blocks.
+    uint64_t published() const;
+
+private:
+    // SHARED MEMORY
+    /// \brief Creates and locks the shared memory object, replacing a stale one.
+    /// \param name The POSIX shared memory name.
+    /// \return The locked descriptor.
+    /// \exception std::runtime_error if the bus is owned by a running publisher, or cannot be created.
+    static int create(const std::string& name);
+
+    /// \brief The name of the shared memory object.
+    std::string m_name;
+    /// \brief The descriptor of the shared memory object, holding the ownership lock.
+    int m_descriptor;
+    /// \brief The size of the mapping in bytes.
+    size_t m_size;
+    /// \brief The header of the mapping.
+    shm::header* m_header;
+    /// \brief The block headers of the mapping.
+    shm::block* m_blocks;
+    /// \brief The samples of the mapping.
+    ads101x::sample* m_samples;
+};
+
+}}
+
+#endif
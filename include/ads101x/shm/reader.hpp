@@ -0,0 +1,80 @@
+/// \file ads101x/shm/reader.hpp
+/// \brief Defines the ads101x::shm::reader class.
+#ifndef ADS101X___SHM___READER_H
+#define ADS101X___SHM___READER_H
+
+// ads101x
+#include <ads101x/sample.hpp>
+#include <ads101x/shm/layout.hpp>
+
+// std
+#include <chrono>
+#include <span>
+#include <string>
+
+namespace ads101x {
+namespace shm {
+
+/// \brief Reads a sample stream published into shared memory by ads101x::shm::publisher.
+/// \details Reading is done entirely in user space: each block is copied out of the mapping and validated against its
+/// sequence number, so no system call is made per sample or per block. Only wait() enters the kernel, and only when
+/// no block is available. A reader that falls more than the ring's capacity behind skips to the oldest intact block
+/// and counts the lost blocks as overruns.
+class reader
+{
+public:
+    // CONSTRUCTORS
+    /// \brief Maps an existing sample bus, starting at the next published block.
+    /// \param name The POSIX shared memory name, beginning with '/'.
+    /// \exception std::runtime_error if the bus does not exist or is not a compatible sample bus.
+    reader(const std::string& name);
+    ~reader();
+    reader(const reader&) = delete;
+    reader& operator=(const reader&) = delete;
+
+    // READING
+    /// \brief Copies the next published block.
+    /// \param buffer The buffer to copy into, which must hold at least block_size() samples.
+    /// \return The number of samples copied, or zero if no new block is available.
+    /// \exception std::runtime_error if the buffer is too small.
+    uint32_t read(std::span<ads101x::sample> buffer);
+    /// \brief Waits until a new block is available or the bus is closed.
+    /// \param timeout The maximum time to wait.
+    /// \return TRUE if a new block is available, otherwise FALSE.
+    bool wait(std::chrono::nanoseconds timeout);
+
+    // PROPERTIES
+    /// \brief Gets the maximum number of samples in each block.
+    /// \return The number of samples.
+    uint32_t block_size() const;
+    /// \brief Gets the number of published blocks not yet read.
+    /// \return The number of blocks.
+    uint64_t lag() const;
+    /// \brief Gets the number of blocks lost because the reader fell behind.
+    /// \return The number of blocks.
+    uint64_t overruns() const;
+    /// \brief Indicates if the publisher closed the bus.
+    /// \return TRUE if closed, otherwise FALSE.
+    bool closed() const;
+
+private:
+    // SHARED MEMORY
+    /// \brief The size of the mapping in bytes.
+    size_t m_size;
+    /// \brief The header of the mapping.
+    shm::header* m_header;
+    /// \brief The block headers of the mapping.
+    shm::block* m_blocks;
+    /// \brief The samples of the mapping.
+    const ads101x::sample* m_samples;
+
+    // CURSOR
+    /// \brief The publish index of the next block to read.
+    uint64_t m_cursor;
+    /// \brief The number of blocks lost.
+    uint64_t m_overruns;
+};
+
+}}
+
+#endif
@@ -0,0 +1,167 @@
+/// \file ads101x/simulator/driver.hpp
+/// \brief Defines the ads101x::simulator::driver class.
+#ifndef ADS101X___SIMULATOR___DRIVER_H
+#define ADS101X___SIMULATOR___DRIVER_H
+
+// ads101x
+#include <ads101x/driver.hpp>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ads101x {
+/// \brief Contains all code for the simulated ADS101X.
+namespace simulator {
+
+class pigpiod_server;
+
+/// \brief An ADS101X driver backed by a software model of the device.
+/// \details The model runs conversions at the configured data rate in continuous and single-shot mode, reports
+/// conversion status through the OS bit, and drives a simulated ALERT/RDY pin in conversion-ready and comparator
+/// modes (including polarity, latching, and queue). Analog inputs are provided per multiplexer setting as constant
+/// voltages or as a signal function of time. Use it to exercise acquisition code without hardware.
+class driver
+    : public ads101x::driver
+{
+public:
+    // CONSTRUCTORS
+    /// \brief Constructs a new simulated ADS101X in its power-on state.
+    driver();
+    ~driver();
+
+    // INPUTS
+    /// \brief Sets a constant input voltage for a multiplexer setting.
+    /// \param multiplexer The multiplexer setting.
+    /// \param voltage The differential input voltage in volts.
+    void set_input(ads101x::configuration::multiplexer multiplexer, double voltage);
+    /// \brief Sets an input signal that is evaluated at the end of each conversion.
+    /// \details Replaces any constant input voltages.
+    /// \param signal The signal, taking the multiplexer setting and seconds since the driver started, returning volts.
+    void set_signal(std::function<double(ads101x::configuration::multiplexer, double)> signal);
+
+    // BUS
+    /// \brief Sets an artificial latency added to every register transaction.
+    /// \details A transaction whose latency would outlast its deadline fails with ads101x::timeout_error when the
+    /// deadline passes, without touching the registers.
+    /// \param latency The latency of each transaction.
+    void set_latency(std::chrono::nanoseconds latency);
+    /// \brief Gets the number of register transactions performed.
+    /// \return The number of transactions.
+    uint64_t transactions() const;
+    /// \brief Gets the number of conversions completed.
+    /// \return The number of conversions.
+    uint64_t conversions() const;
+
+    // FAULTS
+    /// \brief Resets the device registers to their power-on state, as a brown-out would.
+    /// \details Stops any conversions and releases ALERT/RDY, so an acquisition waiting for conversion-ready edges
+    /// stalls until it reconfigures the device.
+    void reset();
+
+private:
+    // SERVERS
+    /// \brief Allows the pigpiod protocol server to access the registers directly, as the bus would.
+    friend class ads101x::simulator::pigpiod_server;
+
+    // OVERRIDES
+    void open_i2c(uint32_t i2c_bus, uint8_t i2c_address) override;
+    void close_i2c() override;
+    void write_register(uint8_t register_address, uint16_t value) const override;
+    uint16_t read_register(uint8_t register_address) const override;
+    void attach_interrupt(uint16_t pin) override;
+    void detach_interrupt(uint16_t pin) override;
+    void set_watchdog(uint16_t pin, uint32_t timeout_ms) override;
+
+    // MODEL
+    /// \brief The ALERT/RDY activity produced by advancing the model.
+    struct activity
+    {
+        /// \brief Indicates if a conversion completed.
+        bool completed;
+        /// \brief Indicates if ALERT/RDY should pulse for conversion-ready.
+        bool pulse;
+        /// \brief The ALERT/RDY level after the conversion.
+        bool level;
+        /// \brief The configuration the conversion was taken with.
+        uint16_t config;
+    };
+    /// \brief Runs the conversion model thread.
+    void run();
+    /// \brief Completes the current conversion if it is due, and schedules the next. Requires m_mutex.
+    /// \details Register reads advance the model too, so results never depend on the model thread's wake-up latency.
+    /// \param now The current time.
+    /// \return The resulting ALERT/RDY activity.
+    driver::activity advance(std::chrono::steady_clock::time_point now) const;
+    /// \brief Completes a conversion and updates the conversion register and comparator. Requires m_mutex.
+    /// \param time The time the conversion completed.
+    /// \param pulse Set to TRUE if ALERT/RDY should pulse for conversion-ready.
+    /// \return The ALERT/RDY pin level after the conversion.
+    bool complete_conversion(std::chrono::steady_clock::time_point time, bool& pulse) const;
+    /// \brief Gets the idle ALERT/RDY pin level for a configuration.
+    static bool idle_level(uint16_t config);
+    /// \brief Drives ALERT/RDY for model activity. Must be called without m_mutex.
+    void drive(const driver::activity& activity) const;
+    /// \brief Raises an ALERT/RDY edge if the pin level changed.
+    void drive_alert_rdy(bool level) const;
+    /// \brief Raises an ALERT/RDY watchdog timeout if the interrupt is attached.
+    void drive_stall() const;
+    /// \brief Applies the transaction latency.
+    void delay() const;
+
+    // STATE
+    /// \brief Protects the model state.
+    mutable std::mutex m_mutex;
+    /// \brief Wakes the model thread when the schedule changes.
+    mutable std::condition_variable m_wake;
+    /// \brief The model thread.
+    std::thread m_thread;
+    /// \brief Indicates if the model thread should run.
+    bool m_running;
+    /// \brief The device registers.
+    mutable uint16_t m_registers[4];
+    /// \brief Indicates if a conversion is in progress.
+    mutable bool m_converting;
+    /// \brief The time the current conversion completes.
+    mutable std::chrono::steady_clock::time_point m_conversion_end;
+    /// \brief The time the driver was started.
+    std::chrono::steady_clock::time_point m_epoch;
+    /// \brief The input signal.
+    std::function<double(ads101x::configuration::multiplexer, double)> m_signal;
+    /// \brief The constant input voltages.
+    double m_inputs[8];
+
+    // COMPARATOR
+    /// \brief Indicates if the comparator is asserted.
+    mutable bool m_asserted;
+    /// \brief The number of consecutive conversions beyond the thresholds.
+    mutable uint32_t m_queue_count;
+
+    // ALERT_RDY
+    /// \brief Serializes interrupt delivery with interrupt detachment.
+    mutable std::recursive_mutex m_interrupt_mutex;
+    /// \brief The attached ALERT_RDY pin, or -1 if not attached.
+    int32_t m_interrupt_pin;
+    /// \brief The current ALERT_RDY pin level.
+    mutable bool m_alert_rdy_level;
+    /// \brief The ALERT_RDY watchdog timeout, or zero if disarmed. Requires m_mutex.
+    std::chrono::milliseconds m_watchdog;
+    /// \brief The time the ALERT_RDY watchdog expires without an edge. Requires m_mutex.
+    mutable std::chrono::steady_clock::time_point m_watchdog_deadline;
+
+    // BUS
+    /// \brief The artificial transaction latency.
+    std::chrono::nanoseconds m_latency;
+    /// \brief The number of transactions.
+    mutable std::atomic<uint64_t> m_transactions;
+    /// \brief The number of conversions.
+    mutable std::atomic<uint64_t> m_conversions;
+};
+
+}}
+
+#endif
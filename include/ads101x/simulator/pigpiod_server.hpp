@@ -0,0 +1,200 @@
+/// \file ads101x/simulator/pigpiod_server.hpp
+/// \brief Defines the ads101x::simulator::pigpiod_server class.
+#ifndef ADS101X___SIMULATOR___PIGPIOD_SERVER_H
+#define ADS101X___SIMULATOR___PIGPIOD_SERVER_H
+
+// ads101x
+#include <ads101x/simulator/driver.hpp>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace ads101x {
+namespace simulator {
+
+/// \brief A TCP server speaking the pigpiod socket protocol, backed by a simulated ADS101X.
+/// \details Serves the commands the pigpiod backend uses: I2C open, close, word read and write, and zip, GPIO mode and
+/// pull, watchdogs, the tick, and edge notifications on the ALERT/RDY pin. Commands are handled in order on the server
+/// thread after their configured latency, as a busy daemon would, so the pigpiod backend's throughput, batching, and
+/// reconnects can be exercised and benchmarked without a Raspberry Pi.
+class pigpiod_server
+{
+public:
+    // COMMANDS
+    /// \brief Enumerates the pigpiod commands served.
+    enum class command : uint32_t
+    {
+        MODES = 0,      ///< Sets a GPIO mode.
+        PUD = 2,        ///< Sets a GPIO pull.
+        WDOG = 9,       ///< Arms or disarms a GPIO watchdog.
+        BR1 = 10,       ///< Reads the levels of GPIO 0 to 31.
+        TICK = 16,      ///< Gets the current tick.
+        HWVER = 17,     ///< Gets the hardware revision.
+        NB = 19,        ///< Begins notifications on a set of GPIOs.
+        NC = 21,        ///< Closes notifications.
+        PIGPV = 26,     ///< Gets the pigpio version.
+        I2CO = 54,      ///< Opens an I2C handle.
+        I2CC = 55,      ///< Closes an I2C handle.
+        I2CRW = 63,     ///< Reads an SMBus word.
+        I2CWW = 64,     ///< Writes an SMBus word.
+        I2CZ = 92,      ///< Executes a sequence of I2C operations.
+        NOIB = 99       ///< Turns the connection into a notification stream.
+    };
+
+    // CONSTRUCTORS
+    /// \brief Creates a new server listening on a local TCP port.
+    /// \param driver The started simulated device. It must outlive the server.
+    /// \param i2c_bus The I2C bus the device answers on.
+    /// \param i2c_address The I2C address the device answers on.
+    /// \param alert_rdy_pin The GPIO pin reporting the device's ALERT/RDY edges.
+    /// \param port The port to listen on, or zero to pick a free port.
+    /// \exception std::runtime_error if the socket cannot be created.
+    pigpiod_server(ads101x::simulator::driver& driver, uint32_t i2c_bus = 1, uint8_t i2c_address = 0x48, uint16_t alert_rdy_pin = 25, uint16_t port = 0);
+    ~pigpiod_server();
+    pigpiod_server(const pigpiod_server&) = delete;
+    pigpiod_server& operator=(const pigpiod_server&) = delete;
+
+    /// \brief Gets the port the server is listening on.
+    /// \return The port.
+    uint16_t port() const;
+
+    // LATENCY
+    /// \brief Sets an artificial latency added before answering a command.
+    /// \details Must be set before the server runs.
+    /// \param command The command to delay.
+    /// \param latency The latency of each command.
+    void set_latency(pigpiod_server::command command, std::chrono::nanoseconds latency);
+    /// \brief Sets an artificial latency added before answering every command.
+    /// \details Must be set before the server runs.
+    /// \param latency The latency of each command.
+    void set_latency(std::chrono::nanoseconds latency);
+
+    // CONTROL
+    /// \brief Runs the server on the calling thread until stop() is called.
+    /// \details Returns immediately if stop() was already called.
+    void run();
+    /// \brief Stops the server. May be called from any thread or a signal handler.
+    void stop();
+    /// \brief Closes every client connection, as a daemon restart or network fault would. May be called from any thread.
+    /// \details I2C handles and notifications opened by the clients are closed with them.
+    void drop();
+
+    // METRICS
+    /// \brief Gets the number of command and notification connections currently open.
+    /// \return The number of connections.
+    uint32_t clients() const;
+    /// \brief Gets the number of times a command was served.
+    /// \param command The command.
+    /// \return The number of commands.
+    uint64_t commands(pigpiod_server::command command) const;
+
+private:
+    // CLIENTS
+    /// \brief A client connection.
+    struct client
+    {
+        /// \brief The client socket.
+        int32_t socket;
+        /// \brief The bytes received that do not yet form a whole command.
+        std::vector<uint8_t> buffer;
+        /// \brief Indicates if the connection is a notification stream.
+        bool notify;
+        /// \brief The GPIOs notified, as a bitmask.
+        uint32_t bits;
+        /// \brief The sequence number of the next notification report.
+        uint16_t sequence;
+    };
+    /// \brief An open I2C handle.
+    struct handle
+    {
+        /// \brief The socket of the client that opened the handle, or -1 if closed.
+        int32_t owner;
+        /// \brief The I2C bus.
+        uint32_t i2c_bus;
+        /// \brief The I2C address.
+        uint32_t i2c_address;
+        /// \brief The register the device's pointer selects.
+        uint8_t pointer;
+    };
+    /// \brief Accepts a new client.
+    void accept_client();
+    /// \brief Receives and serves the whole commands available from a client.
+    /// \param client The client.
+    /// \return TRUE if the client is still connected, otherwise FALSE.
+    bool receive(pigpiod_server::client& client);
+    /// \brief Closes a client and the handles it opened. Requires the client to be removed from m_clients.
+    /// \param socket The client socket.
+    void close_client(int32_t socket);
+
+    // COMMANDS
+    /// \brief Serves a single command.
+    /// \param client The client sending the command.
+    /// \param words The command, its parameters, and the extension length.
+    /// \param extension The extension bytes.
+    /// \param reply The extra bytes to send after the result.
+    /// \return The result.
+    int32_t serve(pigpiod_server::client& client, const uint32_t words[4], const uint8_t* extension, std::vector<uint8_t>& reply);
+    /// \brief Executes an I2C zip command.
+    /// \param handle The I2C handle.
+    /// \param operations The zip operations.
+    /// \param length The length of the operations.
+    /// \param reply The bytes read.
+    /// \return The number of bytes read, or a pigpio error.
+    int32_t zip(pigpiod_server::handle& handle, const uint8_t* operations, uint32_t length, std::vector<uint8_t>& reply);
+    /// \brief Gets an open handle.
+    /// \param number The handle number.
+    /// \return The handle, or nullptr if it is not open.
+    pigpiod_server::handle* find_handle(uint32_t number);
+    /// \brief The number of command codes tracked.
+    static constexpr uint32_t command_count = 128;
+
+    // DEVICE
+    /// \brief Reports an ALERT/RDY edge or watchdog timeout to the notification streams.
+    /// \param flags The report flags.
+    void notify(uint16_t flags);
+
+    // STATE
+    /// \brief The simulated device.
+    ads101x::simulator::driver& m_driver;
+    /// \brief The I2C bus the device answers on.
+    uint32_t m_i2c_bus;
+    /// \brief The I2C address the device answers on.
+    uint8_t m_i2c_address;
+    /// \brief The ALERT/RDY pin.
+    uint16_t m_alert_rdy_pin;
+    /// \brief The current ALERT/RDY level.
+    std::atomic<bool> m_alert_rdy_level;
+    /// \brief The time the server was created, from which ticks count.
+    std::chrono::steady_clock::time_point m_epoch;
+    /// \brief The listening socket.
+    int32_t m_listener;
+    /// \brief The port the server is listening on.
+    uint16_t m_port;
+    /// \brief The eventfd used to wake the server for stop() and drop().
+    int32_t m_wake;
+    /// \brief Protects the clients, which notifications are sent to from the driver's thread.
+    mutable std::mutex m_mutex;
+    /// \brief The connected clients.
+    std::vector<pigpiod_server::client> m_clients;
+    /// \brief The I2C handles, indexed by handle number.
+    std::vector<pigpiod_server::handle> m_handles;
+    /// \brief The latency of each command, indexed by command.
+    std::chrono::nanoseconds m_latency[pigpiod_server::command_count];
+    /// \brief Indicates if the server has been asked to stop.
+    std::atomic<bool> m_stopping;
+    /// \brief Indicates if the clients should be dropped.
+    std::atomic<bool> m_dropping;
+
+    // METRICS
+    /// \brief The number of connections.
+    std::atomic<uint32_t> m_client_count;
+    /// \brief The number of commands served, indexed by command.
+    std::atomic<uint64_t> m_commands[pigpiod_server::command_count];
+};
+
+}}
+
+#endif
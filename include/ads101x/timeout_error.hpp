@@ -0,0 +1,23 @@
+/// \file ads101x/timeout_error.hpp
+/// \brief Defines the ads101x::timeout_error class.
+#ifndef ADS101X___TIMEOUT_ERROR_H
+#define ADS101X___TIMEOUT_ERROR_H
+
+// std
+#include <stdexcept>
+
+namespace ads101x {
+
+/// \brief The error thrown when a driver operation cannot complete by its deadline.
+/// \details Derives from std::runtime_error, so existing handlers still catch it, while a control loop can catch it
+/// separately to skip a cycle instead of treating the device as failed.
+class timeout_error
+    : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+}
+
+#endif
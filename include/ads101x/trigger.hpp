@@ -0,0 +1,156 @@
+/// \file ads101x/trigger.hpp
+/// \brief Defines the ads101x::trigger class.
+#ifndef ADS101X___TRIGGER_H
+#define ADS101X___TRIGGER_H
+
+// ads101x
+#include <ads101x/acquisition.hpp>
+
+// std
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace ads101x {
+
+/// \brief Captures the samples around a trigger event in a continuous acquisition.
+/// \details While armed, the acquisition's broadcast ring serves as the pre-trigger buffer: the trigger only keeps
+/// views of the most recent blocks, and nothing is copied until it fires. It fires on the first sample outside a
+/// software threshold window, or on the first sample read after an ALERT/RDY comparator assertion. The pre-trigger
+/// samples are then copied out of the ring, and the post-trigger samples are collected as they are published, into a
+/// record that was allocated when the trigger was created. Processing happens on the acquisition thread.
+class trigger
+{
+public:
+    // CONSTRUCTORS
+    /// \brief Creates a new trigger.
+    /// \param pre_samples The number of samples to capture before the trigger sample.
+    /// \param post_samples The number of samples to capture from the trigger sample on, including it.
+    /// \exception std::runtime_error if no post-trigger samples are requested.
+    trigger(uint32_t pre_samples, uint32_t post_samples);
+    ~trigger();
+
+    // RECORD
+    /// \brief Enumerates the events that can fire a trigger.
+    enum class source
+    {
+        THRESHOLD,  ///< A sample was outside the software threshold window.
+        ALERT_RDY   ///< The ALERT/RDY comparator asserted.
+    };
+    /// \brief The samples captured around a trigger event.
+    struct record
+    {
+        /// \brief The pre-trigger samples, followed by the post-trigger samples.
+        std::vector<ads101x::sample> samples;
+        /// \brief The index of the trigger sample. Fewer pre-trigger samples are captured if the acquisition had not
+        /// yet published enough when the trigger fired.
+        uint32_t trigger_index;
+        /// \brief The event that fired the trigger.
+        trigger::source source;
+    };
+
+    // SOURCES
+    /// \brief Fires the trigger on samples outside a window.
+    /// \param low The lowest sample value inside the window.
+    /// \param high The highest sample value inside the window.
+    void set_threshold(int16_t low, int16_t high);
+    /// \brief Fires the trigger on ALERT/RDY comparator assertions.
+    /// \details The comparator thresholds and mode are configured on the device as usual. The acquisition must not use
+    /// the pin itself, so it is normally run in POLLING mode.
+    /// \param driver The driver the comparator belongs to. Must outlive the attachment.
+    /// \param pin The GPIO pin connected to ALERT/RDY.
+    /// \param polarity The comparator polarity configured on the device.
+    /// \exception std::runtime_error if the attach operation fails.
+    void attach_alert_rdy(ads101x::driver& driver, uint16_t pin, ads101x::configuration::comparator_polarity polarity);
+    /// \brief Stops firing the trigger on ALERT/RDY comparator assertions.
+    /// \exception std::runtime_error if the detach operation fails.
+    void detach_alert_rdy();
+
+    // CAPTURE
+    /// \brief Processes every block published by an acquisition.
+    /// \details Must be called before the acquisition starts. The trigger must outlive the acquisition's thread.
+    /// \param acquisition The acquisition to capture from.
+    /// \exception std::runtime_error if the pre-trigger samples do not fit in the acquisition's broadcast ring.
+    void attach(ads101x::acquisition& acquisition);
+    /// \brief Arms the trigger for a new capture, discarding the previous record.
+    /// \exception std::runtime_error if a capture is already in progress.
+    void arm();
+    /// \brief Indicates if the trigger is armed or collecting post-trigger samples.
+    /// \return TRUE if a capture is in progress, otherwise FALSE.
+    bool armed() const;
+    /// \brief Waits for the current capture to complete.
+    /// \param timeout_ns The longest time to wait, in nanoseconds.
+    /// \return TRUE if a completed record is available, otherwise FALSE.
+    bool wait(uint64_t timeout_ns) const;
+    /// \brief Gets the completed record.
+    /// \details Only valid once wait() has returned TRUE, until the trigger is armed again.
+    /// \return The record.
+    const trigger::record& capture() const;
+    /// \brief Gets the number of captures completed.
+    /// \return The number of captures.
+    uint64_t captures() const;
+
+private:
+    // STATE
+    /// \brief Enumerates the capture states.
+    enum class state
+    {
+        IDLE,       ///< Not armed.
+        ARMED,      ///< Waiting for a trigger event.
+        TRIGGERED,  ///< Collecting post-trigger samples.
+        COMPLETE    ///< The record is complete.
+    };
+
+    // PROCESSING
+    /// \brief Processes a published block on the acquisition thread.
+    void process(std::span<const ads101x::sample> block);
+    /// \brief Finds the trigger sample in a block.
+    /// \param block The block to search.
+    /// \param source The source of the trigger event found.
+    /// \return The index of the trigger sample, or the block size if none was found.
+    size_t find(std::span<const ads101x::sample> block, trigger::source& source) const;
+    /// \brief Copies the pre-trigger samples preceding a trigger sample into the record.
+    void copy_pre(std::span<const ads101x::sample> block, size_t index);
+    /// \brief Copies post-trigger samples into the record, completing it once enough have been collected.
+    void copy_post(std::span<const ads101x::sample> samples);
+
+    // SETTINGS
+    /// \brief The number of pre-trigger samples.
+    uint32_t m_pre_samples;
+    /// \brief The number of post-trigger samples.
+    uint32_t m_post_samples;
+    /// \brief Indicates if the threshold window is enabled.
+    bool m_threshold;
+    /// \brief The lowest value inside the threshold window.
+    int16_t m_threshold_low;
+    /// \brief The highest value inside the threshold window.
+    int16_t m_threshold_high;
+
+    // ALERT_RDY
+    /// \brief The driver whose ALERT/RDY is attached, or nullptr.
+    ads101x::driver* m_driver;
+    /// \brief The time of the first comparator assertion while armed, or zero.
+    std::atomic<uint64_t> m_alert_time;
+
+    // CAPTURE
+    /// \brief The capture state.
+    std::atomic<trigger::state> m_state;
+    /// \brief Views of the most recently published blocks, which hold the pre-trigger samples.
+    std::vector<std::span<const ads101x::sample>> m_history;
+    /// \brief The number of blocks viewed since the trigger was attached.
+    uint64_t m_history_count;
+    /// \brief The record being captured.
+    trigger::record m_record;
+    /// \brief The number of captures completed.
+    std::atomic<uint64_t> m_captures;
+    /// \brief Guards waiting for completion.
+    mutable std::mutex m_mutex;
+    /// \brief Signals completion.
+    mutable std::condition_variable m_complete;
+};
+
+}
+
+#endif
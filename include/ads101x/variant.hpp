@@ -0,0 +1,306 @@
+/// \file ads101x/variant.hpp
+/// \brief Defines the ads101x::variant enumeration, the ads101x::traits structures, and the ads101x::variant_configuration class.
+#ifndef ADS101X___VARIANT_H
+#define ADS101X___VARIANT_H
+
+// ads101x
+#include <ads101x/configuration.hpp>
+
+// std
+#include <array>
+#include <stdint.h>
+
+namespace ads101x {
+
+/// \brief An enumeration of the supported pin-compatible ADC variants.
+enum class variant
+{
+    ADS1013,    ///< 12-bit, single channel, fixed +/- 2.048V range, no comparator.
+    ADS1014,    ///< 12-bit, single channel, PGA and comparator.
+    ADS1015,    ///< 12-bit, four channel multiplexer, PGA and comparator.
+    ADS1113,    ///< 16-bit, single channel, fixed +/- 2.048V range, no comparator.
+    ADS1114,    ///< 16-bit, single channel, PGA and comparator.
+    ADS1115     ///< 16-bit, four channel multiplexer, PGA and comparator.
+};
+
+/// \brief Traits shared by variants of the same resolution.
+/// \tparam R The conversion resolution in bits.
+template<uint8_t R>
+struct resolution_traits
+{
+    /// \brief The conversion resolution in bits.
+    static constexpr uint8_t resolution = R;
+    /// \brief The left shift of conversions and thresholds within their 16-bit registers.
+    static constexpr uint8_t shift = 16 - R;
+    /// \brief The largest positive conversion code.
+    static constexpr int16_t max_code = (1 << (R - 1)) - 1;
+    /// \brief The most negative conversion code.
+    static constexpr int16_t min_code = -(1 << (R - 1));
+
+    /// \brief Extracts the unsigned conversion code from a register value.
+    /// \param value The register value.
+    /// \return The R-bit two's complement code, right aligned.
+    static constexpr uint16_t code(uint16_t value)
+    {
+        return value >> shift;
+    }
+    /// \brief Extracts the signed conversion value from a register value.
+    /// \param value The register value.
+    /// \return The sign-extended conversion value.
+    static constexpr int16_t decode(uint16_t value)
+    {
+        return static_cast<int16_t>(value) >> shift;
+    }
+    /// \brief Places a right aligned code into its register position.
+    /// \param code The R-bit code.
+    /// \return The register value.
+    static constexpr uint16_t encode(uint16_t code)
+    {
+        return static_cast<uint16_t>(code << shift);
+    }
+};
+
+/// \brief The data rate table of the 12-bit ADS101X variants, indexed by the data_rate field.
+struct ads101x_data_rates
+{
+    /// \brief The samples per second for each data_rate field value.
+    static constexpr std::array<uint32_t, 8> data_rates = {128, 250, 490, 920, 1600, 2400, 3300, 3300};
+};
+/// \brief The data rate table of the 16-bit ADS111X variants, indexed by the data_rate field.
+/// \details The ADS111X uses the same field codes as the ADS101X, so configuration::data_rate::SPS_128 selects 8 SPS.
+struct ads111x_data_rates
+{
+    /// \brief The samples per second for each data_rate field value.
+    static constexpr std::array<uint32_t, 8> data_rates = {8, 16, 32, 64, 128, 250, 475, 860};
+};
+
+/// \brief Traits shared by every variant.
+/// \tparam R The conversion resolution in bits.
+/// \tparam D The data rate table.
+/// \tparam PGA Indicates if the variant has a programmable gain amplifier.
+/// \tparam MUX Indicates if the variant has an input multiplexer.
+/// \tparam COMP Indicates if the variant has a comparator and ALERT/RDY pin.
+template<uint8_t R, typename D, bool PGA, bool MUX, bool COMP>
+struct variant_traits
+    : public resolution_traits<R>,
+      public D
+{
+    /// \brief Indicates if the variant has a programmable gain amplifier.
+    static constexpr bool has_pga = PGA;
+    /// \brief Indicates if the variant has an input multiplexer.
+    static constexpr bool has_multiplexer = MUX;
+    /// \brief Indicates if the variant has a comparator and ALERT/RDY pin.
+    static constexpr bool has_comparator = COMP;
+
+    /// \brief Gets the samples per second of a data rate setting.
+    /// \param data_rate The data rate setting.
+    /// \return The samples per second.
+    static constexpr uint32_t samples_per_second(configuration::data_rate data_rate)
+    {
+        return D::data_rates[static_cast<uint16_t>(data_rate) >> 5];
+    }
+    /// \brief Gets the conversion period of a data rate setting.
+    /// \param data_rate The data rate setting.
+    /// \return The conversion period in microseconds, rounded up.
+    static constexpr uint32_t conversion_period_us(configuration::data_rate data_rate)
+    {
+        return (1000000 + samples_per_second(data_rate) - 1) / samples_per_second(data_rate);
+    }
+    /// \brief Gets an ALERT/RDY watchdog timeout for a data rate setting.
+    /// \details Allows for the +/- 10% tolerance of the internal oscillator over the given number of periods.
+    /// \param data_rate The data rate setting.
+    /// \param periods The number of conversion periods without an edge that count as a stall.
+    /// \return The timeout in milliseconds, rounded up.
+    static constexpr uint32_t watchdog_timeout_ms(configuration::data_rate data_rate, uint32_t periods = 4)
+    {
+        return (conversion_period_us(data_rate) * periods * 11 / 10 + 999) / 1000;
+    }
+    /// \brief Checks if a multiplexer setting is supported.
+    /// \param value The multiplexer setting.
+    /// \return TRUE if supported, otherwise FALSE.
+    static constexpr bool supports(configuration::multiplexer value)
+    {
+        return MUX || value == configuration::multiplexer::AIN0_AIN1;
+    }
+    /// \brief Checks if a full-scale range is supported.
+    /// \param value The full-scale range.
+    /// \return TRUE if supported, otherwise FALSE.
+    static constexpr bool supports(configuration::fsr value)
+    {
+        return PGA || value == configuration::fsr::FSR_2_048;
+    }
+};
+
+/// \brief Compile-time traits of an ADC variant.
+/// \tparam V The variant.
+template<ads101x::variant V>
+struct traits;
+/// \brief Traits of the ADS1013.
+template<>
+struct traits<ads101x::variant::ADS1013>
+    : public variant_traits<12, ads101x_data_rates, false, false, false>
+{};
+/// \brief Traits of the ADS1014.
+template<>
+struct traits<ads101x::variant::ADS1014>
+    : public variant_traits<12, ads101x_data_rates, true, false, true>
+{};
+/// \brief Traits of the ADS1015.
+template<>
+struct traits<ads101x::variant::ADS1015>
+    : public variant_traits<12, ads101x_data_rates, true, true, true>
+{};
+/// \brief Traits of the ADS1113.
+template<>
+struct traits<ads101x::variant::ADS1113>
+    : public variant_traits<16, ads111x_data_rates, false, false, false>
+{};
+/// \brief Traits of the ADS1114.
+template<>
+struct traits<ads101x::variant::ADS1114>
+    : public variant_traits<16, ads111x_data_rates, true, false, true>
+{};
+/// \brief Traits of the ADS1115.
+template<>
+struct traits<ads101x::variant::ADS1115>
+    : public variant_traits<16, ads111x_data_rates, true, true, true>
+{};
+
+/// \brief Gets the samples per second of a data rate setting on a variant chosen at runtime.
+/// \param variant The variant.
+/// \param data_rate The data rate setting.
+/// \return The samples per second.
+constexpr uint32_t samples_per_second(ads101x::variant variant, configuration::data_rate data_rate)
+{
+    return (variant >= ads101x::variant::ADS1113) ? traits<ads101x::variant::ADS1115>::samples_per_second(data_rate) : traits<ads101x::variant::ADS1015>::samples_per_second(data_rate);
+}
+/// \brief Gets the conversion period of a data rate setting on a variant chosen at runtime.
+/// \details Lets timing code serve any variant without being templated on it. Only the data rate table differs
+/// between the variants' timing, and it follows the resolution.
+/// \param variant The variant.
+/// \param data_rate The data rate setting.
+/// \return The conversion period in microseconds, rounded up.
+constexpr uint32_t conversion_period_us(ads101x::variant variant, configuration::data_rate data_rate)
+{
+    return (variant >= ads101x::variant::ADS1113) ? traits<ads101x::variant::ADS1115>::conversion_period_us(data_rate) : traits<ads101x::variant::ADS1015>::conversion_period_us(data_rate);
+}
+/// \brief Gets an ALERT/RDY watchdog timeout for a data rate setting on a variant chosen at runtime.
+/// \param variant The variant.
+/// \param data_rate The data rate setting.
+/// \param periods The number of conversion periods without an edge that count as a stall.
+/// \return The timeout in milliseconds, rounded up.
+constexpr uint32_t watchdog_timeout_ms(ads101x::variant variant, configuration::data_rate data_rate, uint32_t periods = 4)
+{
+    return (variant >= ads101x::variant::ADS1113) ? traits<ads101x::variant::ADS1115>::watchdog_timeout_ms(data_rate, periods) : traits<ads101x::variant::ADS1015>::watchdog_timeout_ms(data_rate, periods);
+}
+
+/// \brief A configuration restricted to the settings supported by a variant.
+/// \details Settings that a variant does not have fail to compile. Values known at compile time can be checked with
+/// the templated setters, e.g. set_fsr<configuration::fsr::FSR_4_096>() fails to compile for the ADS1013.
+/// \tparam V The variant.
+template<ads101x::variant V>
+class variant_configuration
+{
+public:
+    /// \brief The traits of the configuration's variant.
+    typedef ads101x::traits<V> traits_type;
+
+    // CONSTRUCTORS
+    /// \brief Creates a default configuration, which is valid for every variant.
+    variant_configuration()
+    {}
+
+    // PROPERTIES
+    /// \brief Sets the operation status.
+    /// \param value The value to set.
+    void set_operation(configuration::operation value)
+    {
+        variant_configuration::m_configuration.set_operation(value);
+    }
+    /// \brief Sets the measurement mode.
+    /// \param value The measurement mode to set.
+    void set_mode(configuration::mode value)
+    {
+        variant_configuration::m_configuration.set_mode(value);
+    }
+    /// \brief Sets the data rate.
+    /// \param value The data rate to set.
+    void set_data_rate(configuration::data_rate value)
+    {
+        variant_configuration::m_configuration.set_data_rate(value);
+    }
+    /// \brief Sets a multiplexer mode that is checked at compile time.
+    /// \tparam M The multiplexer mode to set.
+    template<configuration::multiplexer M>
+    void set_multiplexer()
+    {
+        static_assert(traits_type::supports(M), "multiplexer setting is not supported by this variant");
+        variant_configuration::m_configuration.set_multiplexer(M);
+    }
+    /// \brief Sets the multiplexer mode. Only available on variants with a multiplexer.
+    /// \param value The multiplexer mode to set.
+    void set_multiplexer(configuration::multiplexer value)
+    {
+        static_assert(traits_type::has_multiplexer, "variant does not have a multiplexer");
+        variant_configuration::m_configuration.set_multiplexer(value);
+    }
+    /// \brief Sets a full-scale range that is checked at compile time.
+    /// \tparam F The full-scale range to set.
+    template<configuration::fsr F>
+    void set_fsr()
+    {
+        static_assert(traits_type::supports(F), "full-scale range is not supported by this variant");
+        variant_configuration::m_configuration.set_fsr(F);
+    }
+    /// \brief Sets the full-scale range. Only available on variants with a PGA.
+    /// \param value The full-scale range to set.
+    void set_fsr(configuration::fsr value)
+    {
+        static_assert(traits_type::has_pga, "variant does not have a programmable gain amplifier");
+        variant_configuration::m_configuration.set_fsr(value);
+    }
+    /// \brief Sets the comparator mode. Only available on variants with a comparator.
+    /// \param value The comparator mode to set.
+    void set_comparator_mode(configuration::comparator_mode value)
+    {
+        static_assert(traits_type::has_comparator, "variant does not have a comparator");
+        variant_configuration::m_configuration.set_comparator_mode(value);
+    }
+    /// \brief Sets the comparator polarity. Only available on variants with a comparator.
+    /// \param value The comparator polarity to set.
+    void set_comparator_polarity(configuration::comparator_polarity value)
+    {
+        static_assert(traits_type::has_comparator, "variant does not have a comparator");
+        variant_configuration::m_configuration.set_comparator_polarity(value);
+    }
+    /// \brief Sets the comparator latch mode. Only available on variants with a comparator.
+    /// \param value The comparator latch mode to set.
+    void set_comparator_latch(configuration::comparator_latch value)
+    {
+        static_assert(traits_type::has_comparator, "variant does not have a comparator");
+        variant_configuration::m_configuration.set_comparator_latch(value);
+    }
+    /// \brief Sets the comparator queue mode. Only available on variants with a comparator.
+    /// \param value The comparator queue mode to set.
+    void set_comparator_queue(configuration::comparator_queue value)
+    {
+        static_assert(traits_type::has_comparator, "variant does not have a comparator");
+        variant_configuration::m_configuration.set_comparator_queue(value);
+    }
+
+    // CONFIGURATION
+    /// \brief Gets the underlying configuration.
+    /// \return The configuration.
+    const ads101x::configuration& get() const
+    {
+        return variant_configuration::m_configuration;
+    }
+
+private:
+    /// \brief The underlying configuration.
+    ads101x::configuration m_configuration;
+};
+
+}
+
+#endif
@@ -0,0 +1,442 @@
+#include <ads101x/acquisition.hpp>
+
+// ads101x
+#include <ads101x/clock.hpp>
+
+// std
+#include <stdexcept>
+
+using namespace ads101x;
+
+// CONSTRUCTORS
+acquisition::acquisition(ads101x::driver& driver, uint32_t block_size, uint32_t block_count)
+    : m_driver(driver),
+      m_mode(acquisition::mode::POLLING),
+      m_variant(ads101x::variant::ADS1015),
+      m_channels{ads101x::configuration::multiplexer::AIN0_GND},
+      m_alert_rdy_pin(-1),
+      m_watchdog(0),
+      m_event(nullptr),
+      m_running(false),
+      m_ready(0),
+      m_stalled(false),
+      m_ready_time(0),
+      m_started(false),
+      m_ring(block_count, block_size),
+      m_block_fill(0),
+      m_samples(0),
+      m_errors(0),
+      m_stalls(0),
+      m_last_read(0),
+      m_max_interval(0)
+{}
+acquisition::~acquisition()
+{
+    // Stop the acquisition if necessary.
+    try
+    {
+        acquisition::stop();
+    }
+    catch(...)
+    {}
+}
+
+// SETTINGS
+void acquisition::set_mode(acquisition::mode mode)
+{
+    acquisition::m_mode = mode;
+}
+void acquisition::set_configuration(const ads101x::configuration& configuration)
+{
+    acquisition::m_configuration = configuration;
+}
+void acquisition::set_variant(ads101x::variant variant)
+{
+    acquisition::m_variant = variant;
+}
+void acquisition::set_channels(const std::vector<ads101x::configuration::multiplexer>& channels)
+{
+    if(channels.empty())
+    {
+        throw std::runtime_error("acquisition requires at least one channel");
+    }
+    acquisition::m_channels = channels;
+}
+void acquisition::set_alert_rdy_pin(uint16_t pin)
+{
+    acquisition::m_alert_rdy_pin = pin;
+}
+void acquisition::set_watchdog(uint32_t periods)
+{
+    acquisition::m_watchdog = periods;
+}
+void acquisition::set_realtime(const ads101x::realtime_profile& profile)
+{
+    acquisition::m_realtime_profile = profile;
+}
+void acquisition::set_timing_probe(std::function<void(uint64_t, uint64_t)> probe)
+{
+    acquisition::m_timing_probe = probe;
+}
+void acquisition::add_sink(std::function<void(std::span<const ads101x::sample>)> sink)
+{
+    acquisition::m_sinks.push_back(sink);
+}
+void acquisition::add_sample_sink(std::function<void(const ads101x::sample&)> sink)
+{
+    acquisition::m_sample_sinks.push_back(sink);
+}
+void acquisition::set_event(const ads101x::event* event)
+{
+    acquisition::m_event = event;
+}
+
+// CONTROL
+void acquisition::start()
+{
+    // Verify state.
+    if(acquisition::m_running)
+    {
+        throw std::runtime_error("acquisition is already running");
+    }
+    if(acquisition::m_mode == acquisition::mode::DATA_READY && acquisition::m_alert_rdy_pin < 0)
+    {
+        throw std::runtime_error("acquisition data ready mode requires an alert_rdy pin");
+    }
+
+    // Put ALERT/RDY into conversion-ready mode if it is used.
+    ads101x::configuration config = acquisition::m_configuration;
+    bool attached = false;
+    try
+    {
+        if(acquisition::m_alert_rdy_pin >= 0 && acquisition::m_mode != acquisition::mode::POLLING)
+        {
+            acquisition::m_driver.write_hi_thresh(0x0800);
+            acquisition::m_driver.write_lo_thresh(0x0000);
+            if(config.get_comparator_queue() == ads101x::configuration::comparator_queue::DISABLED)
+            {
+                config.set_comparator_queue(ads101x::configuration::comparator_queue::AFTER_1);
+            }
+
+            // Count conversion-ready assertions. Only the asserting edge is subscribed to, and edges delivered together
+            // are counted with a single wakeup of the acquisition thread.
+            acquisition::m_ready = 0;
+            acquisition::m_driver.attach_alert_rdy_batch(acquisition::m_alert_rdy_pin, [this](std::span<const ads101x::edge_event> edges)
+            {
+                acquisition::m_ready_time.store(edges.back().timestamp, std::memory_order_relaxed);
+                acquisition::m_ready.fetch_add(static_cast<uint32_t>(edges.size()), std::memory_order_release);
+                acquisition::m_ready.notify_one();
+            }, ads101x::asserting_edge(config.get_comparator_polarity()));
+            attached = true;
+
+            // Wake the thread to recover when edges stop.
+            acquisition::m_stalled = false;
+            if(acquisition::m_watchdog != 0)
+            {
+                acquisition::m_driver.set_alert_rdy_watchdog(ads101x::watchdog_timeout_ms(acquisition::m_variant, config.get_data_rate(), acquisition::m_watchdog), [this]()
+                {
+                    acquisition::m_stalled.store(true, std::memory_order_relaxed);
+                    acquisition::m_ready.fetch_add(1, std::memory_order_release);
+                    acquisition::m_ready.notify_one();
+                });
+            }
+        }
+        acquisition::m_configuration = config;
+
+        // Start continuous conversions on the first channel.
+        if(acquisition::m_mode != acquisition::mode::SINGLESHOT)
+        {
+            config.set_multiplexer(acquisition::m_channels.front());
+            config.set_mode(ads101x::configuration::mode::CONTINUOUS);
+            acquisition::m_driver.write_config(config);
+        }
+
+        // Claim the first block and start the thread.
+        acquisition::m_ring.open();
+        acquisition::m_block = acquisition::m_ring.claim();
+        acquisition::m_block_fill = 0;
+        acquisition::m_last_read = 0;
+        acquisition::m_max_interval = 0;
+        acquisition::m_started = false;
+        acquisition::m_running = true;
+        acquisition::m_thread = std::thread(&acquisition::run, this);
+    }
+    catch(...)
+    {
+        // Detach ALERT/RDY, which also disarms the watchdog, so a failed start leaves nothing attached to the driver.
+        // Close the ring so readers waiting for the stream are released.
+        acquisition::m_running = false;
+        acquisition::m_ring.close();
+        if(attached)
+        {
+            try
+            {
+                acquisition::m_driver.detach_alert_rdy();
+            }
+            catch(...)
+            {}
+        }
+        throw;
+    }
+
+    // Wait for the thread to apply its real-time profile.
+    acquisition::m_started.wait(false);
+}
+void acquisition::stop()
+{
+    // Check if running.
+    if(!acquisition::m_running.exchange(false))
+    {
+        return;
+    }
+
+    // Wake and join the thread.
+    acquisition::m_ready.fetch_add(1, std::memory_order_release);
+    acquisition::m_ready.notify_one();
+    acquisition::m_thread.join();
+
+    // Release ALERT/RDY and power down the device.
+    if(acquisition::m_alert_rdy_pin >= 0 && acquisition::m_mode != acquisition::mode::POLLING)
+    {
+        acquisition::m_driver.detach_alert_rdy();
+    }
+    ads101x::configuration config = acquisition::m_configuration;
+    config.set_operation(ads101x::configuration::operation::IDLE);
+    config.set_mode(ads101x::configuration::mode::SINGLESHOT);
+    acquisition::m_driver.write_config(config);
+}
+bool acquisition::running() const
+{
+    return acquisition::m_running;
+}
+
+// STREAM
+ads101x::broadcast_ring<ads101x::sample>::reader acquisition::subscribe() const
+{
+    return acquisition::m_ring.subscribe();
+}
+const ads101x::broadcast_ring<ads101x::sample>& acquisition::ring() const
+{
+    return acquisition::m_ring;
+}
+bool acquisition::latest(ads101x::configuration::multiplexer channel, ads101x::sample& sample) const
+{
+    return acquisition::m_latest[static_cast<uint16_t>(channel) >> 12].load(sample);
+}
+
+// METRICS
+uint64_t acquisition::samples() const
+{
+    return acquisition::m_samples;
+}
+uint64_t acquisition::errors() const
+{
+    return acquisition::m_errors;
+}
+uint64_t acquisition::stalls() const
+{
+    return acquisition::m_stalls;
+}
+uint64_t acquisition::max_interval() const
+{
+    return acquisition::m_max_interval;
+}
+ads101x::realtime_report acquisition::realtime() const
+{
+    return acquisition::m_realtime_report;
+}
+
+// THREAD
+void acquisition::run()
+{
+    // Apply the real-time profile, and fault in the ring before the first conversion.
+    acquisition::m_realtime_report = ads101x::apply_realtime(acquisition::m_realtime_profile);
+    if(acquisition::m_realtime_profile.prefault)
+    {
+        acquisition::m_ring.prefault();
+    }
+    acquisition::m_started = true;
+    acquisition::m_started.notify_one();
+
+    uint64_t period = ads101x::conversion_period_us(acquisition::m_variant, acquisition::m_configuration.get_data_rate()) * 1000ULL;
+    uint64_t deadline = ads101x::monotonic_ns() + period;
+    uint32_t channel = 0;
+
+    while(acquisition::m_running.load(std::memory_order_relaxed))
+    {
+        if(acquisition::m_mode == acquisition::mode::SINGLESHOT)
+        {
+            // Start a single-shot conversion on the next channel.
+            ads101x::configuration config = acquisition::m_configuration;
+            config.set_multiplexer(acquisition::m_channels[channel]);
+            config.set_mode(ads101x::configuration::mode::SINGLESHOT);
+            config.set_operation(ads101x::configuration::operation::CONVERT);
+            try
+            {
+                acquisition::m_driver.write_config(config);
+            }
+            catch(...)
+            {
+                // Retry after a conversion period, so a device that stopped answering does not spin the thread.
+                acquisition::m_errors++;
+                ads101x::sleep_until_ns(ads101x::monotonic_ns() + period);
+                continue;
+            }
+
+            // Allow for the +/- 10% tolerance of the internal oscillator.
+            deadline = ads101x::monotonic_ns() + period + period / 10;
+            if(!acquisition::wait_ready(deadline, acquisition::m_channels[channel]))
+            {
+                break;
+            }
+            acquisition::acquire(acquisition::m_channels[channel]);
+            channel = (channel + 1) % acquisition::m_channels.size();
+        }
+        else
+        {
+            // Wait for and read the next continuous conversion.
+            if(!acquisition::wait_ready(deadline, acquisition::m_channels.front()))
+            {
+                break;
+            }
+            acquisition::acquire(acquisition::m_channels.front());
+
+            // Advance the deadline, resynchronizing if more than a period behind.
+            deadline += period;
+            uint64_t now = ads101x::monotonic_ns();
+            if(deadline + period < now)
+            {
+                deadline = now + period;
+            }
+        }
+    }
+
+    // Publish any partial block and wake readers.
+    if(acquisition::m_block_fill > 0)
+    {
+        acquisition::publish();
+    }
+    acquisition::m_ring.close();
+}
+bool acquisition::wait_ready(uint64_t deadline, ads101x::configuration::multiplexer channel)
+{
+    if(acquisition::m_alert_rdy_pin < 0 || acquisition::m_mode == acquisition::mode::POLLING)
+    {
+        // Pace on the conversion timer.
+        acquisition::m_ready_time.store(deadline, std::memory_order_relaxed);
+        ads101x::sleep_until_ns(deadline);
+        return acquisition::m_running.load(std::memory_order_relaxed);
+    }
+
+    while(true)
+    {
+        // Wait for a conversion-ready edge. Edges that arrived while busy are consumed together.
+        while(acquisition::m_ready.exchange(0, std::memory_order_acquire) == 0)
+        {
+            acquisition::m_ready.wait(0, std::memory_order_acquire);
+        }
+        if(!acquisition::m_running.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        // Restart conversions if the watchdog woke the thread, and wait again.
+        if(!acquisition::m_stalled.exchange(false, std::memory_order_relaxed))
+        {
+            return true;
+        }
+        acquisition::recover(channel);
+    }
+}
+void acquisition::recover(ads101x::configuration::multiplexer channel)
+{
+    acquisition::m_stalls++;
+
+    // Rewrite conversion-ready mode and the configuration, which a device reset would have lost. Failures are retried
+    // on the next watchdog timeout.
+    ads101x::configuration config = acquisition::m_configuration;
+    config.set_multiplexer(channel);
+    if(acquisition::m_mode == acquisition::mode::SINGLESHOT)
+    {
+        config.set_mode(ads101x::configuration::mode::SINGLESHOT);
+        config.set_operation(ads101x::configuration::operation::CONVERT);
+    }
+    else
+    {
+        config.set_mode(ads101x::configuration::mode::CONTINUOUS);
+    }
+    try
+    {
+        acquisition::m_driver.write_hi_thresh(0x0800);
+        acquisition::m_driver.write_lo_thresh(0x0000);
+        acquisition::m_driver.write_config(config);
+    }
+    catch(...)
+    {
+        acquisition::m_errors++;
+    }
+}
+void acquisition::acquire(ads101x::configuration::multiplexer channel)
+{
+    // Track the interval between reads.
+    uint64_t now = ads101x::monotonic_ns();
+    if(acquisition::m_last_read != 0 && now - acquisition::m_last_read > acquisition::m_max_interval.load(std::memory_order_relaxed))
+    {
+        acquisition::m_max_interval.store(now - acquisition::m_last_read, std::memory_order_relaxed);
+    }
+    acquisition::m_last_read = now;
+    if(acquisition::m_timing_probe)
+    {
+        acquisition::m_timing_probe(acquisition::m_ready_time.load(std::memory_order_relaxed), now);
+    }
+
+    // Read the conversion.
+    uint16_t conversion;
+    try
+    {
+        conversion = acquisition::m_driver.read_conversion();
+    }
+    catch(...)
+    {
+        acquisition::m_errors++;
+        return;
+    }
+
+    // Append the sample to the current block in place.
+    ads101x::sample& sample = acquisition::m_block[acquisition::m_block_fill++];
+    sample = ads101x::sample(conversion, acquisition::m_configuration.get_fsr());
+    sample.channel = channel;
+    sample.timestamp = ads101x::monotonic_ns();
+    sample.sequence = acquisition::m_samples++;
+
+    // Publish the channel's latest sample.
+    acquisition::m_latest[static_cast<uint16_t>(channel) >> 12].store(sample);
+    for(auto& sink : acquisition::m_sample_sinks)
+    {
+        sink(sample);
+    }
+
+    // Publish full blocks.
+    if(acquisition::m_block_fill == acquisition::m_block.size())
+    {
+        acquisition::publish();
+    }
+}
+void acquisition::publish()
+{
+    // Publish the block to readers and sinks.
+    std::span<const ads101x::sample> block(acquisition::m_block.data(), acquisition::m_block_fill);
+    acquisition::m_ring.publish(acquisition::m_block_fill);
+    for(auto& sink : acquisition::m_sinks)
+    {
+        sink(block);
+    }
+    if(acquisition::m_event)
+    {
+        acquisition::m_event->signal();
+    }
+
+    // Claim the next block.
+    acquisition::m_block = acquisition::m_ring.claim();
+    acquisition::m_block_fill = 0;
+}
@@ -0,0 +1,148 @@
+#include <ads101x/auto_range.hpp>
+
+// std
+#include <stdexcept>
+
+using namespace ads101x;
+
+// FSR INDEXING
+/// \brief Converts a full-scale range into an index, where 0 is the widest range and 5 the narrowest.
+static uint16_t fsr_index(ads101x::configuration::fsr fsr)
+{
+    // The PGA field occupies bits 9-11. Codes above 5 all alias the narrowest range.
+    uint16_t index = static_cast<uint16_t>(fsr) >> 9;
+    return (index > 5) ? 5 : index;
+}
+/// \brief Converts an index back into a full-scale range.
+static ads101x::configuration::fsr fsr_from_index(uint16_t index)
+{
+    return static_cast<ads101x::configuration::fsr>(index << 9);
+}
+
+// CONSTRUCTORS
+auto_range::auto_range(const ads101x::configuration& configuration, float upper_threshold, float lower_threshold, uint32_t dwell)
+    : m_configuration(configuration),
+      m_active_fsr(configuration.get_fsr()),
+      m_upper_threshold(static_cast<int32_t>(upper_threshold * 2047.0f)),
+      m_lower_threshold(lower_threshold),
+      m_dwell(dwell),
+      m_dwell_count(0),
+      m_widest(ads101x::configuration::fsr::FSR_6_114),
+      m_narrowest(ads101x::configuration::fsr::FSR_0_256)
+{
+    // Verify the thresholds leave a hysteresis band between them.
+    if(!(lower_threshold > 0.0f && lower_threshold < upper_threshold && upper_threshold <= 1.0f))
+    {
+        throw std::runtime_error("auto_range thresholds must satisfy 0 < lower < upper <= 1");
+    }
+
+    // Verify dwell.
+    if(dwell == 0)
+    {
+        throw std::runtime_error("auto_range dwell must be at least one conversion");
+    }
+}
+
+// LIMITS
+void auto_range::set_limits(ads101x::configuration::fsr widest, ads101x::configuration::fsr narrowest)
+{
+    // Verify limit order.
+    if(fsr_index(widest) > fsr_index(narrowest))
+    {
+        throw std::runtime_error("auto_range widest limit is narrower than narrowest limit");
+    }
+
+    // Store limits.
+    auto_range::m_widest = widest;
+    auto_range::m_narrowest = narrowest;
+
+    // Clamp the pending range into the new limits.
+    uint16_t index = fsr_index(auto_range::m_configuration.get_fsr());
+    if(index < fsr_index(widest))
+    {
+        auto_range::m_configuration.set_fsr(widest);
+    }
+    else if(index > fsr_index(narrowest))
+    {
+        auto_range::m_configuration.set_fsr(narrowest);
+    }
+}
+
+// CONFIGURATION
+ads101x::configuration auto_range::get_configuration() const
+{
+    return auto_range::m_configuration;
+}
+void auto_range::set_configuration(const ads101x::configuration& configuration)
+{
+    // Replace configuration and restart the dwell count.
+    auto_range::m_configuration = configuration;
+    auto_range::m_dwell_count = 0;
+}
+bool auto_range::pending() const
+{
+    return fsr_index(auto_range::m_configuration.get_fsr()) != fsr_index(auto_range::m_active_fsr);
+}
+ads101x::configuration::fsr auto_range::active_fsr() const
+{
+    return auto_range::m_active_fsr;
+}
+
+// CONVERSION
+ads101x::sample auto_range::process(uint16_t conversion)
+{
+    // Tag the conversion with the range it was taken at.
+    ads101x::sample sample(conversion, auto_range::m_active_fsr);
+
+    // Get the conversion magnitude.
+    int32_t magnitude = (sample.value < 0) ? -static_cast<int32_t>(sample.value) : sample.value;
+
+    // Range decisions are made relative to the range the conversion was taken at.
+    uint16_t active = fsr_index(auto_range::m_active_fsr);
+
+    if(magnitude >= auto_range::m_upper_threshold)
+    {
+        // Conversion is at or near saturation. Widen immediately if possible.
+        auto_range::m_dwell_count = 0;
+        if(active > fsr_index(auto_range::m_widest))
+        {
+            auto_range::m_configuration.set_fsr(fsr_from_index(active - 1));
+        }
+    }
+    else if(active < fsr_index(auto_range::m_narrowest))
+    {
+        // Scale the magnitude into the next narrower range and compare with the lower threshold.
+        ads101x::configuration::fsr narrower = fsr_from_index(active + 1);
+        double scaled = magnitude * ads101x::fsr_voltage(auto_range::m_active_fsr) / ads101x::fsr_voltage(narrower);
+        if(scaled < auto_range::m_lower_threshold * 2047.0)
+        {
+            // Narrow once the signal has been under-range for the dwell period.
+            if(++auto_range::m_dwell_count >= auto_range::m_dwell)
+            {
+                auto_range::m_configuration.set_fsr(narrower);
+                auto_range::m_dwell_count = 0;
+            }
+        }
+        else
+        {
+            auto_range::m_dwell_count = 0;
+        }
+    }
+
+    return sample;
+}
+
+// DRIVER
+void auto_range::write_config(const ads101x::driver& driver)
+{
+    // Write configuration with the pending range folded in.
+    driver.write_config(auto_range::m_configuration);
+
+    // New conversions are now taken at the written range.
+    auto_range::m_active_fsr = auto_range::m_configuration.get_fsr();
+    auto_range::m_dwell_count = 0;
+}
+ads101x::sample auto_range::read_conversion(const ads101x::driver& driver)
+{
+    return auto_range::process(driver.read_conversion());
+}
@@ -0,0 +1,207 @@
+#include <ads101x/calibration.hpp>
+
+// std
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+using namespace ads101x;
+
+// NAMES
+/// \brief Parses a multiplexer enumeration name.
+static bool parse_multiplexer(const std::string& name, ads101x::configuration::multiplexer& value)
+{
+    static const char* names[8] = {"AIN0_AIN1", "AIN0_AIN3", "AIN1_AIN3", "AIN2_AIN3", "AIN0_GND", "AIN1_GND", "AIN2_GND", "AIN3_GND"};
+    for(uint16_t i = 0; i < 8; ++i)
+    {
+        if(name == names[i])
+        {
+            value = static_cast<ads101x::configuration::multiplexer>(i << 12);
+            return true;
+        }
+    }
+    return false;
+}
+/// \brief Parses a full-scale range enumeration name.
+static bool parse_fsr(const std::string& name, ads101x::configuration::fsr& value)
+{
+    static const char* names[6] = {"FSR_6_114", "FSR_4_096", "FSR_2_048", "FSR_1_024", "FSR_0_512", "FSR_0_256"};
+    for(uint16_t i = 0; i < 6; ++i)
+    {
+        if(name == names[i])
+        {
+            value = static_cast<ads101x::configuration::fsr>(i << 9);
+            return true;
+        }
+    }
+    return false;
+}
+
+// CONSTRUCTORS
+calibration::calibration()
+    : m_selected(nullptr),
+      m_selected_multiplexer(ads101x::configuration::multiplexer::AIN0_AIN1)
+{
+    // Select the default configuration so apply() always has a table.
+    calibration::select(ads101x::configuration());
+}
+
+// TRANSFORMS
+void calibration::set_polynomial(ads101x::configuration::multiplexer multiplexer, ads101x::configuration::fsr fsr, const std::vector<double>& coefficients)
+{
+    // Evaluate the polynomial with Horner's method.
+    calibration::set_transform(multiplexer, fsr, [coefficients](double voltage)
+    {
+        double result = 0.0;
+        for(auto coefficient = coefficients.rbegin(); coefficient != coefficients.rend(); ++coefficient)
+        {
+            result = result * voltage + *coefficient;
+        }
+        return result;
+    });
+}
+void calibration::set_transform(ads101x::configuration::multiplexer multiplexer, ads101x::configuration::fsr fsr, std::function<double(double)> transform)
+{
+    // Store the transform.
+    calibration::entry& entry = calibration::get_entry(multiplexer, fsr);
+    entry.transform = transform;
+
+    // Rebuild an existing table in place so the selected table pointer stays valid.
+    if(entry.table)
+    {
+        calibration::build(entry, fsr);
+    }
+}
+void calibration::load(const std::string& path)
+{
+    // Open the file.
+    std::ifstream file(path);
+    if(!file.is_open())
+    {
+        throw std::runtime_error("failed to open calibration file: " + path);
+    }
+
+    // Parse each line into a polynomial per (multiplexer, fsr) pair.
+    std::vector<std::tuple<ads101x::configuration::multiplexer, ads101x::configuration::fsr, std::vector<double>>> polynomials;
+    std::string line;
+    uint32_t line_number = 0;
+    while(std::getline(file, line))
+    {
+        ++line_number;
+
+        // Skip empty lines and comments.
+        std::istringstream stream(line);
+        std::string multiplexer_name;
+        if(!(stream >> multiplexer_name) || multiplexer_name[0] == '#')
+        {
+            continue;
+        }
+
+        // Parse multiplexer, fsr, and coefficients.
+        ads101x::configuration::multiplexer multiplexer;
+        std::string fsr_name;
+        ads101x::configuration::fsr fsr;
+        bool all_fsr = false;
+        std::vector<double> coefficients;
+        double coefficient;
+        if(!parse_multiplexer(multiplexer_name, multiplexer) || !(stream >> fsr_name) || !((all_fsr = (fsr_name == "*")) || parse_fsr(fsr_name, fsr)))
+        {
+            throw std::runtime_error("invalid calibration channel on line " + std::to_string(line_number) + " of " + path);
+        }
+        while(stream >> coefficient)
+        {
+            coefficients.push_back(coefficient);
+        }
+        if(coefficients.empty() || !stream.eof())
+        {
+            throw std::runtime_error("invalid calibration coefficients on line " + std::to_string(line_number) + " of " + path);
+        }
+
+        // Queue the polynomial.
+        if(all_fsr)
+        {
+            for(uint16_t i = 0; i < 6; ++i)
+            {
+                polynomials.emplace_back(multiplexer, static_cast<ads101x::configuration::fsr>(i << 9), coefficients);
+            }
+        }
+        else
+        {
+            polynomials.emplace_back(multiplexer, fsr, std::move(coefficients));
+        }
+    }
+
+    // Store the polynomials now that the whole file is valid.
+    for(const auto& [multiplexer, fsr, coefficients] : polynomials)
+    {
+        calibration::set_polynomial(multiplexer, fsr, coefficients);
+    }
+}
+
+// TABLES
+void calibration::select(const ads101x::configuration& configuration)
+{
+    // Build the tables for every range of the multiplexer, so samples from auto_range never build one in apply().
+    for(uint16_t i = 0; i < 6; ++i)
+    {
+        calibration::get_table(configuration.get_multiplexer(), static_cast<ads101x::configuration::fsr>(i << 9));
+    }
+
+    // Select the table.
+    calibration::m_selected = &calibration::get_table(configuration.get_multiplexer(), configuration.get_fsr());
+    calibration::m_selected_multiplexer = configuration.get_multiplexer();
+}
+const calibration::table& calibration::get_table(ads101x::configuration::multiplexer multiplexer, ads101x::configuration::fsr fsr)
+{
+    // Build the table if it has not been built yet.
+    calibration::entry& entry = calibration::get_entry(multiplexer, fsr);
+    if(!entry.table)
+    {
+        entry.table.reset(new calibration::table());
+        calibration::build(entry, fsr);
+    }
+
+    return *entry.table;
+}
+calibration::entry& calibration::get_entry(ads101x::configuration::multiplexer multiplexer, ads101x::configuration::fsr fsr)
+{
+    return const_cast<calibration::entry&>(static_cast<const calibration&>(*this).get_entry(multiplexer, fsr));
+}
+const calibration::entry& calibration::get_entry(ads101x::configuration::multiplexer multiplexer, ads101x::configuration::fsr fsr) const
+{
+    // PGA codes above 5 alias the narrowest range.
+    uint16_t fsr_index = static_cast<uint16_t>(fsr) >> 9;
+    if(fsr_index > 5)
+    {
+        fsr_index = 5;
+    }
+
+    return calibration::m_entries[(static_cast<uint16_t>(multiplexer) >> 12) * 6 + fsr_index];
+}
+void calibration::build(calibration::entry& entry, ads101x::configuration::fsr fsr)
+{
+    // Evaluate the transform once for every conversion code.
+    calibration::table& table = *entry.table;
+    for(uint32_t code = 0; code < calibration::table_size; ++code)
+    {
+        double voltage = ads101x::sample(code, fsr).voltage();
+        table[code] = static_cast<float>(entry.transform ? entry.transform(voltage) : voltage);
+    }
+}
+
+// APPLY
+void calibration::apply(const uint16_t* conversions, float* output, uint32_t count) const
+{
+    // Gather from the selected table. This loop has no branches so the compiler is free to vectorize it.
+    const float* table = calibration::m_selected->data();
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        output[i] = table[conversions[i] & 0x0FFF];
+    }
+}
+float calibration::apply(const ads101x::sample& sample) const
+{
+    // The tables of every range of the selected multiplexer were built by select().
+    return (*calibration::get_entry(calibration::m_selected_multiplexer, sample.fsr).table)[sample.value & 0x0FFF];
+}
@@ -0,0 +1,287 @@
+#include <ads101x/chardev/driver.hpp>
+
+// ads101x
+#include <ads101x/clock.hpp>
+
+// std
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// posix
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+using namespace ads101x::chardev;
+
+/// \brief Throws an std::runtime_error describing a failed system call.
+/// \param operation The operation that failed.
+[[noreturn]] static void fail(const std::string& operation)
+{
+    throw std::runtime_error("failed to " + operation + " (" + std::string(std::strerror(errno)) + ")");
+}
+/// \brief Executes an I2C_RDWR transaction by a deadline.
+/// \details Transient failures, such as lost arbitration or a busy adapter, are retried until the deadline passes.
+/// Without a deadline the first failure is reported. A transaction is not issued once its deadline has passed.
+/// \param io The system calls to use.
+/// \param descriptor The descriptor of the I2C adapter.
+/// \param transaction The transaction to execute.
+/// \param deadline The CLOCK_MONOTONIC deadline in nanoseconds, or zero if unbounded.
+/// \param operation The operation, for error messages.
+/// \exception ads101x::timeout_error if the deadline passes before the transaction succeeds.
+/// \exception std::runtime_error if the transaction fails.
+static void transfer(ads101x::chardev::io& io, int32_t descriptor, i2c_rdwr_ioctl_data& transaction, uint64_t deadline, const std::string& operation)
+{
+    while(true)
+    {
+        // Verify the deadline has not passed before issuing the transaction.
+        if(deadline != 0 && ads101x::monotonic_ns() >= deadline)
+        {
+            throw ads101x::timeout_error("failed to " + operation + " by the deadline");
+        }
+
+        // Try to execute the transaction.
+        if(io.ioctl(descriptor, I2C_RDWR, &transaction) >= 0)
+        {
+            return;
+        }
+
+        // Retry transient failures while the deadline allows.
+        bool transient = errno == EAGAIN || errno == EINTR || errno == EBUSY || errno == ETIMEDOUT;
+        if(deadline == 0 || !transient)
+        {
+            fail(operation);
+        }
+    }
+}
+
+// CONSTRUCTORS
+driver::driver(const std::string& gpio_chip, ads101x::chardev::io& io)
+    : m_io(io),
+      m_gpio_chip(gpio_chip),
+      m_i2c_descriptor(-1),
+      m_i2c_address(0),
+      m_line_descriptor(-1),
+      m_line_offset(0),
+      m_line_sequence(0),
+      m_watchdog(0),
+      m_lost_edges(0)
+{}
+driver::~driver()
+{
+    // Release ALERT/RDY and stop the driver if necessary.
+    driver::detach_interrupt(driver::m_line_offset);
+    driver::close_i2c();
+}
+
+// METRICS
+uint64_t driver::lost_edges() const
+{
+    return driver::m_lost_edges;
+}
+
+// I2C
+void driver::open_i2c(uint32_t i2c_bus, uint8_t i2c_address)
+{
+    // Try to open the I2C adapter.
+    std::string path = "/dev/i2c-" + std::to_string(i2c_bus);
+    int32_t descriptor = driver::m_io.open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if(descriptor < 0)
+    {
+        fail("open " + path);
+    }
+
+    // Store the descriptor and address.
+    driver::m_i2c_descriptor = descriptor;
+    driver::m_i2c_address = i2c_address;
+}
+void driver::close_i2c()
+{
+    // Check if I2C is open.
+    if(driver::m_i2c_descriptor < 0)
+    {
+        return;
+    }
+
+    // Close the adapter.
+    driver::m_io.close(driver::m_i2c_descriptor);
+    driver::m_i2c_descriptor = -1;
+}
+void driver::write_register(uint8_t register_address, uint16_t value) const
+{
+    // Write the register address followed by the big endian value.
+    uint8_t bytes[3] = {register_address, static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value)};
+    i2c_msg message = {driver::m_i2c_address, 0, sizeof(bytes), bytes};
+    i2c_rdwr_ioctl_data transaction = {&message, 1};
+    transfer(driver::m_io, driver::m_i2c_descriptor, transaction, driver::operation_deadline(), "write I2C register");
+}
+uint16_t driver::read_register(uint8_t register_address) const
+{
+    uint16_t value;
+    driver::read_registers(register_address, std::span<uint16_t>(&value, 1));
+    return value;
+}
+void driver::read_registers(uint8_t register_address, std::span<uint16_t> values) const
+{
+    // Each transaction sets the register pointer, then reads values with repeated starts.
+    const size_t batch_size = I2C_RDWR_IOCTL_MAX_MSGS - 1;
+    uint8_t pointer = register_address;
+    uint8_t bytes[batch_size][2];
+    i2c_msg messages[batch_size + 1];
+    messages[0] = {driver::m_i2c_address, 0, 1, &pointer};
+    for(size_t offset = 0; offset < values.size(); offset += batch_size)
+    {
+        size_t count = std::min(batch_size, values.size() - offset);
+
+        // Try to execute the transaction.
+        for(size_t i = 0; i < count; ++i)
+        {
+            messages[i + 1] = {driver::m_i2c_address, I2C_M_RD, 2, bytes[i]};
+        }
+        i2c_rdwr_ioctl_data transaction = {messages, static_cast<uint32_t>(count + 1)};
+        transfer(driver::m_io, driver::m_i2c_descriptor, transaction, driver::operation_deadline(), "read I2C register");
+
+        // Assemble the big endian values.
+        for(size_t i = 0; i < count; ++i)
+        {
+            values[offset + i] = (bytes[i][0] << 8) | bytes[i][1];
+        }
+    }
+}
+
+// ALERT_RDY
+void driver::attach_interrupt(uint16_t pin)
+{
+    // Release any prior line request.
+    driver::detach_interrupt(driver::m_line_offset);
+
+    // Try to open the GPIO chip.
+    int32_t chip = driver::m_io.open(driver::m_gpio_chip.c_str(), O_RDWR | O_CLOEXEC);
+    if(chip < 0)
+    {
+        fail("open " + driver::m_gpio_chip);
+    }
+
+    // Request the line as a pulled-up input with detection of the subscribed edges only, so the kernel does not queue
+    // or wake for the others. Events default to CLOCK_MONOTONIC timestamps.
+    uint64_t edges = 0;
+    switch(driver::alert_rdy_edge())
+    {
+        case ads101x::edge::RISING:
+            edges = GPIO_V2_LINE_FLAG_EDGE_RISING;
+            break;
+        case ads101x::edge::FALLING:
+            edges = GPIO_V2_LINE_FLAG_EDGE_FALLING;
+            break;
+        default:
+            edges = GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+            break;
+    }
+    gpio_v2_line_request request;
+    std::memset(&request, 0, sizeof(request));
+    request.offsets[0] = pin;
+    request.num_lines = 1;
+    std::strncpy(request.consumer, "ads101x", sizeof(request.consumer) - 1);
+    request.config.flags = GPIO_V2_LINE_FLAG_INPUT | edges | GPIO_V2_LINE_FLAG_BIAS_PULL_UP;
+    int32_t result = driver::m_io.ioctl(chip, GPIO_V2_GET_LINE_IOCTL, &request);
+    int32_t error = errno;
+    driver::m_io.close(chip);
+    if(result < 0)
+    {
+        errno = error;
+        fail("request GPIO line " + std::to_string(pin));
+    }
+
+    // Store the line request and start the event thread.
+    driver::m_line_descriptor = request.fd;
+    driver::m_line_offset = pin;
+    driver::m_line_sequence = 0;
+    driver::m_stop.consume();
+    driver::m_thread = std::thread(&driver::run_events, this);
+}
+void driver::detach_interrupt(uint16_t pin)
+{
+    // Check if a line is requested.
+    if(driver::m_line_descriptor < 0)
+    {
+        return;
+    }
+
+    // Stop the event thread and release the line.
+    driver::m_stop.signal();
+    driver::m_thread.join();
+    driver::m_io.close(driver::m_line_descriptor);
+    driver::m_line_descriptor = -1;
+}
+void driver::set_watchdog(uint16_t pin, uint32_t timeout_ms)
+{
+    // Store the timeout, and wake the event thread to apply it.
+    driver::m_watchdog.store(timeout_ms, std::memory_order_relaxed);
+    driver::m_watchdog_changed.signal();
+}
+void driver::run_events()
+{
+    pollfd descriptors[3] = {{driver::m_line_descriptor, POLLIN, 0}, {driver::m_stop.descriptor(), POLLIN, 0}, {driver::m_watchdog_changed.descriptor(), POLLIN, 0}};
+    gpio_v2_line_event events[16];
+    ads101x::edge_event edges[16];
+    while(true)
+    {
+        // Sleep until the kernel queues an edge, the watchdog expires, or the driver stops.
+        uint32_t watchdog = driver::m_watchdog.load(std::memory_order_relaxed);
+        int32_t result = driver::m_io.poll(descriptors, 3, (watchdog != 0) ? static_cast<int32_t>(watchdog) : -1);
+        if(result < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            return;
+        }
+        if(descriptors[1].revents)
+        {
+            return;
+        }
+        if(descriptors[2].revents)
+        {
+            // Restart the wait with the new watchdog timeout.
+            driver::m_watchdog_changed.consume();
+            continue;
+        }
+        if(result == 0)
+        {
+            // No edge within the watchdog timeout.
+            driver::raise_stall(driver::m_line_offset);
+            continue;
+        }
+        if(!(descriptors[0].revents & POLLIN))
+        {
+            continue;
+        }
+
+        // Read every queued edge in one batch.
+        ssize_t size = driver::m_io.read(driver::m_line_descriptor, events, sizeof(events));
+        if(size < static_cast<ssize_t>(sizeof(gpio_v2_line_event)))
+        {
+            continue;
+        }
+        size_t count = size / sizeof(gpio_v2_line_event);
+        for(size_t i = 0; i < count; ++i)
+        {
+            // Count edges skipped by the kernel.
+            const gpio_v2_line_event& event = events[i];
+            if(driver::m_line_sequence != 0 && event.line_seqno > driver::m_line_sequence + 1)
+            {
+                driver::m_lost_edges += event.line_seqno - driver::m_line_sequence - 1;
+            }
+            driver::m_line_sequence = event.line_seqno;
+
+            // Convert the edge, keeping its kernel timestamp.
+            edges[i] = {event.id == GPIO_V2_LINE_EVENT_RISING_EDGE, event.timestamp_ns};
+        }
+
+        // Raise the whole batch at once.
+        driver::raise_interrupts(driver::m_line_offset, std::span<ads101x::edge_event>(edges, count));
+    }
+}
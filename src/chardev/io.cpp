@@ -0,0 +1,37 @@
+#include <ads101x/chardev/io.hpp>
+
+// posix
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+using namespace ads101x::chardev;
+
+// SYSTEM CALLS
+int32_t io::open(const char* path, int32_t flags)
+{
+    return ::open(path, flags);
+}
+int32_t io::close(int32_t descriptor)
+{
+    return ::close(descriptor);
+}
+int32_t io::ioctl(int32_t descriptor, unsigned long request, void* argument)
+{
+    return ::ioctl(descriptor, request, argument);
+}
+ssize_t io::read(int32_t descriptor, void* buffer, size_t size)
+{
+    return ::read(descriptor, buffer, size);
+}
+int32_t io::poll(pollfd* descriptors, nfds_t count, int32_t timeout)
+{
+    return ::poll(descriptors, count, timeout);
+}
+
+// DEFAULT
+io& io::kernel()
+{
+    static io instance;
+    return instance;
+}
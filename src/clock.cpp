@@ -0,0 +1,22 @@
+#include <ads101x/clock.hpp>
+
+// std
+#include <errno.h>
+#include <time.h>
+
+uint64_t ads101x::monotonic_ns()
+{
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<uint64_t>(time.tv_sec) * 1000000000ULL + time.tv_nsec;
+}
+void ads101x::sleep_until_ns(uint64_t deadline)
+{
+    timespec time;
+    time.tv_sec = deadline / 1000000000ULL;
+    time.tv_nsec = deadline % 1000000000ULL;
+
+    // Restart the sleep if interrupted by a signal.
+    while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time, nullptr) == EINTR)
+    {}
+}
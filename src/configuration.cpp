@@ -25,7 +25,7 @@ configuration::configuration(uint16_t bitfield)
 void configuration::set_operation(configuration::operation value)
 {
     // Clear bits location in bitfield using mask, and then set to provided value.
-    configuration::m_bitfield = (configuration::m_bitfield & !MASK_OPERATION) | static_cast<uint16_t>(value);
+    configuration::m_bitfield = (configuration::m_bitfield & ~MASK_OPERATION) | static_cast<uint16_t>(value);
 }
 configuration::operation configuration::get_operation() const
 {
@@ -35,7 +35,7 @@ configuration::operation configuration::get_operation() const
 void configuration::set_multiplexer(configuration::multiplexer value)
 {
     // Clear bits location in bitfield using mask, and then set to provided value.
-    configuration::m_bitfield = (configuration::m_bitfield & !MASK_MULTIPLEXER) | static_cast<uint16_t>(value);
+    configuration::m_bitfield = (configuration::m_bitfield & ~MASK_MULTIPLEXER) | static_cast<uint16_t>(value);
 }
 configuration::multiplexer configuration::get_multiplexer() const
 {
@@ -45,7 +45,7 @@ configuration::multiplexer configuration::get_multiplexer() const
 void configuration::set_fsr(configuration::fsr value)
 {
     // Clear bits location in bitfield using mask, and then set to provided value.
-    configuration::m_bitfield = (configuration::m_bitfield & !MASK_FSR) | static_cast<uint16_t>(value);
+    configuration::m_bitfield = (configuration::m_bitfield & ~MASK_FSR) | static_cast<uint16_t>(value);
 }
 configuration::fsr configuration::get_fsr() const
 {
@@ -55,7 +55,7 @@ configuration::fsr configuration::get_fsr() const
 void configuration::set_mode(configuration::mode value)
 {
     // Clear bits location in bitfield using mask, and then set to provided value.
-    configuration::m_bitfield = (configuration::m_bitfield & !MASK_MODE) | static_cast<uint16_t>(value);
+    configuration::m_bitfield = (configuration::m_bitfield & ~MASK_MODE) | static_cast<uint16_t>(value);
 }
 configuration::mode configuration::get_mode() const
 {
@@ -65,7 +65,7 @@ configuration::mode configuration::get_mode() const
 void configuration::set_data_rate(configuration::data_rate value)
 {
     // Clear bits location in bitfield using mask, and then set to provided value.
-    configuration::m_bitfield = (configuration::m_bitfield & !MASK_DATA_RATE) | static_cast<uint16_t>(value);
+    configuration::m_bitfield = (configuration::m_bitfield & ~MASK_DATA_RATE) | static_cast<uint16_t>(value);
 }
 configuration::data_rate configuration::get_data_rate() const
 {
@@ -75,7 +75,7 @@ configuration::data_rate configuration::get_data_rate() const
 void configuration::set_comparator_mode(configuration::comparator_mode value)
 {
     // Clear bits location in bitfield using mask, and then set to provided value.
-    configuration::m_bitfield = (configuration::m_bitfield & !MASK_COMPARATOR_MODE) | static_cast<uint16_t>(value);
+    configuration::m_bitfield = (configuration::m_bitfield & ~MASK_COMPARATOR_MODE) | static_cast<uint16_t>(value);
 }
 configuration::comparator_mode configuration::get_comparator_mode() const
 {
@@ -85,7 +85,7 @@ configuration::comparator_mode configuration::get_comparator_mode() const
 void configuration::set_comparator_polarity(configuration::comparator_polarity value)
 {
     // Clear bits location in bitfield using mask, and then set to provided value.
-    configuration::m_bitfield = (configuration::m_bitfield & !MASK_COMPARATOR_POLARITY) | static_cast<uint16_t>(value);
+    configuration::m_bitfield = (configuration::m_bitfield & ~MASK_COMPARATOR_POLARITY) | static_cast<uint16_t>(value);
 }
 configuration::comparator_polarity configuration::get_comparator_polarity() const
 {
@@ -95,7 +95,7 @@ configuration::comparator_polarity configuration::get_comparator_polarity() cons
 void configuration::set_comparator_latch(configuration::comparator_latch value)
 {
     // Clear bits location in bitfield using mask, and then set to provided value.
-    configuration::m_bitfield = (configuration::m_bitfield & !MASK_COMPARATOR_LATCH) | static_cast<uint16_t>(value);
+    configuration::m_bitfield = (configuration::m_bitfield & ~MASK_COMPARATOR_LATCH) | static_cast<uint16_t>(value);
 }
 configuration::comparator_latch configuration::get_comparator_latch() const
 {
@@ -105,7 +105,7 @@ configuration::comparator_latch configuration::get_comparator_latch() const
 void configuration::set_comparator_queue(configuration::comparator_queue value)
 {
     // Clear bits location in bitfield using mask, and then set to provided value.
-    configuration::m_bitfield = (configuration::m_bitfield & !MASK_COMPARATOR_QUEUE) | static_cast<uint16_t>(value);
+    configuration::m_bitfield = (configuration::m_bitfield & ~MASK_COMPARATOR_QUEUE) | static_cast<uint16_t>(value);
 }
 configuration::comparator_queue configuration::get_comparator_queue() const
 {
@@ -0,0 +1,166 @@
+#include <ads101x/daemon/client.hpp>
+
+// std
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// posix
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace ads101x::daemon;
+
+// CONSTRUCTORS
+client::client(const std::string& path)
+    : m_next_id(1),
+      m_buffer(sizeof(daemon::block_header) + daemon::max_block_size * sizeof(ads101x::sample)),
+      m_has_response(false)
+{
+    // Validate the path.
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if(path.empty() || path.size() >= sizeof(address.sun_path))
+    {
+        throw std::runtime_error("invalid daemon socket path: " + path);
+    }
+    std::strcpy(address.sun_path, path.c_str());
+
+    // Connect to the daemon.
+    client::m_socket = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if(client::m_socket < 0)
+    {
+        throw std::runtime_error("failed to create daemon client socket (" + std::string(std::strerror(errno)) + ")");
+    }
+    if(connect(client::m_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        int error = errno;
+        ::close(client::m_socket);
+        throw std::runtime_error("failed to connect to daemon at " + path + " (" + std::strerror(error) + ")");
+    }
+}
+client::~client()
+{
+    ::close(client::m_socket);
+}
+
+// REQUESTS
+void client::subscribe(uint16_t device)
+{
+    client::transact(daemon::command::SUBSCRIBE, device, 0);
+}
+void client::unsubscribe(uint16_t device)
+{
+    client::transact(daemon::command::UNSUBSCRIBE, device, 0);
+}
+void client::configure(uint16_t device, const ads101x::configuration& configuration)
+{
+    client::transact(daemon::command::CONFIGURE, device, configuration.bitfield());
+}
+ads101x::sample client::singleshot(uint16_t device, const ads101x::configuration& configuration)
+{
+    return client::transact(daemon::command::SINGLESHOT, device, configuration.bitfield()).sample;
+}
+
+// STREAM
+bool client::receive(uint16_t& device, std::vector<ads101x::sample>& samples, std::chrono::milliseconds timeout)
+{
+    // Read messages until a block is queued or the timeout expires.
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while(client::m_blocks.empty())
+    {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if(remaining.count() < 0 || !client::read_message(static_cast<int32_t>(remaining.count())))
+        {
+            return false;
+        }
+    }
+
+    device = client::m_blocks.front().first;
+    samples = std::move(client::m_blocks.front().second);
+    client::m_blocks.pop_front();
+
+    // An empty block marks the end of the device's stream.
+    if(samples.empty())
+    {
+        throw std::runtime_error("daemon stopped the sample stream of device " + std::to_string(device));
+    }
+    return true;
+}
+int32_t client::descriptor() const
+{
+    return client::m_socket;
+}
+
+// MESSAGES
+ads101x::daemon::response client::transact(daemon::command command, uint16_t device, uint16_t configuration)
+{
+    // Send the request.
+    daemon::request request = {command, device, configuration, 0, client::m_next_id++};
+    if(send(client::m_socket, &request, sizeof(request), MSG_NOSIGNAL) != sizeof(request))
+    {
+        throw std::runtime_error("failed to send daemon request (" + std::string(std::strerror(errno)) + ")");
+    }
+
+    // Wait for the matching response, queueing any blocks pushed in the meantime.
+    do
+    {
+        client::m_has_response = false;
+        client::read_message(-1);
+    } while(!client::m_has_response || client::m_response.id != request.id);
+
+    // Handle errors.
+    switch(client::m_response.status)
+    {
+        case daemon::status::OK:
+            return client::m_response;
+        case daemon::status::BUSY:
+            throw std::runtime_error("daemon device is streaming with a different configuration");
+        case daemon::status::INVALID:
+            throw std::runtime_error("daemon rejected an invalid request");
+        default:
+            throw std::runtime_error("daemon device failed to complete the request");
+    }
+}
+bool client::read_message(int32_t timeout)
+{
+    // Wait for a message.
+    pollfd descriptor = {client::m_socket, POLLIN, 0};
+    if(poll(&descriptor, 1, timeout) <= 0)
+    {
+        return false;
+    }
+    ssize_t size = recv(client::m_socket, client::m_buffer.data(), client::m_buffer.size(), 0);
+    if(size <= 0)
+    {
+        throw std::runtime_error("lost connection to daemon");
+    }
+
+    // Dispatch on the message type.
+    daemon::message type;
+    std::memcpy(&type, client::m_buffer.data(), sizeof(type));
+    if(type == daemon::message::RESPONSE && static_cast<size_t>(size) == sizeof(daemon::response))
+    {
+        std::memcpy(&(client::m_response), client::m_buffer.data(), sizeof(daemon::response));
+        client::m_has_response = true;
+    }
+    else if(type == daemon::message::BLOCK && static_cast<size_t>(size) >= sizeof(daemon::block_header))
+    {
+        daemon::block_header header;
+        std::memcpy(&header, client::m_buffer.data(), sizeof(header));
+        uint32_t count = std::min<size_t>(header.count, (size - sizeof(header)) / sizeof(ads101x::sample));
+        std::vector<ads101x::sample> samples(count);
+        std::memcpy(samples.data(), client::m_buffer.data() + sizeof(header), count * sizeof(ads101x::sample));
+        client::m_blocks.emplace_back(header.device, std::move(samples));
+    }
+    else if(type == daemon::message::STOPPED && static_cast<size_t>(size) >= sizeof(daemon::block_header))
+    {
+        // Queue the end of the stream behind the blocks that preceded it.
+        daemon::block_header header;
+        std::memcpy(&header, client::m_buffer.data(), sizeof(header));
+        client::m_blocks.emplace_back(header.device, std::vector<ads101x::sample>());
+    }
+    return true;
+}
@@ -0,0 +1,635 @@
+#include <ads101x/daemon/server.hpp>
+
+// ads101x
+#include <ads101x/clock.hpp>
+
+// std
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// posix
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace ads101x::daemon;
+
+/// \brief The configuration bits that must match for requests to share a conversion.
+constexpr uint16_t conversion_mask = 0x7EFF;
+
+// CONSTRUCTORS
+server::server(const std::string& path)
+    : m_path(path),
+      m_listener(-1),
+      m_wake(-1),
+      m_client_count(0),
+      m_running(false),
+      m_stopping(false),
+      m_conversions(0),
+      m_coalesced(0),
+      m_dropped(0)
+{
+    // Validate the path.
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if(path.empty() || path.size() >= sizeof(address.sun_path))
+    {
+        throw std::runtime_error("invalid daemon socket path: " + path);
+    }
+    std::strcpy(address.sun_path, path.c_str());
+
+    // Create a message-oriented listening socket, replacing any stale socket file.
+    server::m_listener = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(server::m_listener < 0)
+    {
+        throw std::runtime_error("failed to create daemon socket (" + std::string(std::strerror(errno)) + ")");
+    }
+    unlink(path.c_str());
+    if(bind(server::m_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(server::m_listener, 16) != 0)
+    {
+        int error = errno;
+        ::close(server::m_listener);
+        throw std::runtime_error("failed to listen on " + path + " (" + std::strerror(error) + ")");
+    }
+
+    // Create the wake-up event for stop().
+    server::m_wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(server::m_wake < 0)
+    {
+        ::close(server::m_listener);
+        unlink(path.c_str());
+        throw std::runtime_error("failed to create daemon wake event");
+    }
+}
+server::~server()
+{
+    // Stop all streams before closing the sockets they push to.
+    for(auto& device : server::m_devices)
+    {
+        server::stop_stream(*device);
+    }
+    for(int32_t client : server::m_clients)
+    {
+        ::close(client);
+    }
+    for(auto& device : server::m_devices)
+    {
+        ::close(device->timer);
+    }
+    ::close(server::m_wake);
+    ::close(server::m_listener);
+    unlink(server::m_path.c_str());
+}
+
+// DEVICES
+uint16_t server::add_device(ads101x::driver& driver, int32_t alert_rdy_pin, uint32_t block_size, ads101x::variant variant)
+{
+    if(server::m_running)
+    {
+        throw std::runtime_error("daemon devices must be added before the server runs");
+    }
+    if(block_size == 0 || block_size > daemon::max_block_size)
+    {
+        throw std::runtime_error("invalid daemon block size");
+    }
+
+    auto device = std::make_unique<server::device>();
+    device->index = static_cast<uint16_t>(server::m_devices.size());
+    device->driver = &driver;
+    device->alert_rdy_pin = alert_rdy_pin;
+    device->block_size = block_size;
+    device->variant = variant;
+    device->message.resize(sizeof(daemon::block_header) + block_size * sizeof(ads101x::sample));
+    device->waiting = false;
+    device->converting = false;
+    device->timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if(device->timer < 0)
+    {
+        throw std::runtime_error("failed to create daemon conversion timer");
+    }
+    server::m_devices.push_back(std::move(device));
+
+    return server::m_devices.back()->index;
+}
+
+void server::set_realtime(const ads101x::realtime_profile& profile)
+{
+    server::m_realtime_profile = profile;
+}
+
+// CONTROL
+void server::run()
+{
+    server::m_running = true;
+    std::vector<pollfd> descriptors;
+    std::vector<server::pending> singleshots;
+    std::vector<int32_t> disconnected;
+    while(!server::m_stopping)
+    {
+        // Wait for activity on the listener, the wake event, any conversion timer, or any client.
+        descriptors.clear();
+        descriptors.push_back({server::m_listener, POLLIN, 0});
+        descriptors.push_back({server::m_wake, POLLIN, 0});
+        for(auto& device : server::m_devices)
+        {
+            descriptors.push_back({device->timer, POLLIN, 0});
+        }
+        for(int32_t client : server::m_clients)
+        {
+            descriptors.push_back({client, POLLIN, 0});
+        }
+        if(poll(descriptors.data(), descriptors.size(), -1) < 0)
+        {
+            continue;
+        }
+
+        // Handle wake-ups and new clients.
+        if(descriptors[1].revents)
+        {
+            uint64_t count;
+            ssize_t result = read(server::m_wake, &count, sizeof(count));
+            (void)result;
+        }
+        if(descriptors[0].revents & POLLIN)
+        {
+            server::accept_clients();
+        }
+
+        // Answer completed conversions.
+        size_t first_client = 2 + server::m_devices.size();
+        for(size_t i = 2; i < first_client; ++i)
+        {
+            if(descriptors[i].revents)
+            {
+                server::complete_conversion(*server::m_devices[i - 2]);
+            }
+        }
+
+        // Read every request that is available, collecting single-shots so they can share conversions.
+        for(size_t i = first_client; i < descriptors.size(); ++i)
+        {
+            if(descriptors[i].revents && !server::receive(descriptors[i].fd, singleshots))
+            {
+                disconnected.push_back(descriptors[i].fd);
+            }
+        }
+        server::serve_singleshots(singleshots);
+        for(int32_t client : disconnected)
+        {
+            server::disconnect(client);
+        }
+        singleshots.clear();
+        disconnected.clear();
+    }
+
+    // Stop all streams.
+    for(auto& device : server::m_devices)
+    {
+        server::stop_stream(*device);
+    }
+    server::m_running = false;
+}
+void server::stop()
+{
+    server::m_stopping = true;
+    uint64_t count = 1;
+    ssize_t result = write(server::m_wake, &count, sizeof(count));
+    (void)result;
+}
+
+// METRICS
+uint32_t server::clients() const
+{
+    return server::m_client_count;
+}
+uint64_t server::conversions() const
+{
+    return server::m_conversions;
+}
+uint64_t server::coalesced() const
+{
+    return server::m_coalesced;
+}
+uint64_t server::dropped() const
+{
+    return server::m_dropped;
+}
+
+// REQUESTS
+void server::accept_clients()
+{
+    int32_t client;
+    while((client = accept4(server::m_listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+    {
+        server::m_clients.push_back(client);
+    }
+    server::m_client_count = server::m_clients.size();
+}
+bool server::receive(int32_t client, std::vector<server::pending>& singleshots)
+{
+    while(true)
+    {
+        daemon::request request;
+        ssize_t result = recv(client, &request, sizeof(request), MSG_DONTWAIT);
+        if(result < 0)
+        {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+        if(result == 0)
+        {
+            // Client disconnected.
+            return false;
+        }
+        if(result != sizeof(request))
+        {
+            server::respond(client, 0, daemon::status::INVALID);
+            continue;
+        }
+
+        // Defer single-shots so concurrent requests can be coalesced.
+        if(request.command == daemon::command::SINGLESHOT)
+        {
+            singleshots.push_back({client, request});
+        }
+        else
+        {
+            server::respond(client, request.id, server::handle(client, request));
+        }
+    }
+}
+ads101x::daemon::status server::handle(int32_t client, const daemon::request& request)
+{
+    if(request.device >= server::m_devices.size())
+    {
+        return daemon::status::INVALID;
+    }
+    server::device& device = *server::m_devices[request.device];
+
+    switch(request.command)
+    {
+        case daemon::command::SUBSCRIBE:
+        {
+            // Add the subscriber, starting the shared stream for the first one.
+            bool first;
+            {
+                std::lock_guard<std::mutex> lock(device.mutex);
+                if(std::find(device.subscribers.begin(), device.subscribers.end(), client) != device.subscribers.end())
+                {
+                    return daemon::status::OK;
+                }
+                device.subscribers.push_back(client);
+                first = !device.acquisition;
+            }
+            if(first)
+            {
+                try
+                {
+                    server::start_stream(device);
+                }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> lock(device.mutex);
+                    device.subscribers.clear();
+                    return daemon::status::FAILED;
+                }
+            }
+            return daemon::status::OK;
+        }
+        case daemon::command::UNSUBSCRIBE:
+        {
+            // Remove the subscriber, stopping the stream after the last one.
+            bool last;
+            {
+                std::lock_guard<std::mutex> lock(device.mutex);
+                device.subscribers.erase(std::remove(device.subscribers.begin(), device.subscribers.end(), client), device.subscribers.end());
+                last = device.subscribers.empty();
+            }
+            if(last)
+            {
+                server::stop_stream(device);
+            }
+            return daemon::status::OK;
+        }
+        case daemon::command::CONFIGURE:
+        {
+            // Apply the configuration, restarting the stream if it is running.
+            ads101x::configuration previous = device.configuration;
+            device.configuration = ads101x::configuration(request.configuration);
+            if(device.acquisition)
+            {
+                try
+                {
+                    server::stop_stream(device);
+                    server::start_stream(device);
+                }
+                catch(...)
+                {
+                    // Keep the previous configuration, and restart its stream for the existing subscribers. If that
+                    // fails too, the subscribers are told their stream has stopped.
+                    device.configuration = previous;
+                    try
+                    {
+                        server::stop_stream(device);
+                        server::start_stream(device);
+                    }
+                    catch(...)
+                    {
+                        server::drop_stream(device);
+                    }
+                    return daemon::status::FAILED;
+                }
+            }
+            return daemon::status::OK;
+        }
+        default:
+        {
+            return daemon::status::INVALID;
+        }
+    }
+}
+void server::serve_singleshots(std::vector<server::pending>& singleshots)
+{
+    // Group requests for the same device and conversion settings.
+    std::stable_sort(singleshots.begin(), singleshots.end(), [](const server::pending& a, const server::pending& b)
+    {
+        if(a.request.device != b.request.device)
+        {
+            return a.request.device < b.request.device;
+        }
+        return (a.request.configuration & conversion_mask) < (b.request.configuration & conversion_mask);
+    });
+
+    for(auto group = singleshots.begin(); group != singleshots.end();)
+    {
+        auto end = std::find_if(group, singleshots.end(), [group](const server::pending& p)
+        {
+            return p.request.device != group->request.device || (p.request.configuration & conversion_mask) != (group->request.configuration & conversion_mask);
+        });
+        ads101x::configuration configuration(group->request.configuration);
+
+        if(group->request.device >= server::m_devices.size())
+        {
+            // Reject requests for unknown devices.
+            for(auto request = group; request != end; ++request)
+            {
+                server::respond(request->client, request->request.id, daemon::status::INVALID);
+            }
+        }
+        else if(server::m_devices[group->request.device]->acquisition)
+        {
+            // A streaming device answers with its next sample if the channel and range match.
+            server::device& device = *server::m_devices[group->request.device];
+            bool matches = configuration.get_multiplexer() == device.configuration.get_multiplexer() && configuration.get_fsr() == device.configuration.get_fsr();
+            std::lock_guard<std::mutex> lock(device.mutex);
+            for(auto request = group; request != end; ++request)
+            {
+                if(matches)
+                {
+                    device.waiters.push_back({request->client, request->request.id});
+                    device.waiting = true;
+                }
+                else
+                {
+                    server::respond(request->client, request->request.id, daemon::status::BUSY);
+                }
+            }
+        }
+        else
+        {
+            server::device& device = *server::m_devices[group->request.device];
+            if(device.converting && (configuration.bitfield() & conversion_mask) == (device.conversion.bitfield() & conversion_mask))
+            {
+                // A conversion with the same settings is in progress, so the group shares it.
+                server::m_coalesced += end - group;
+                for(auto request = group; request != end; ++request)
+                {
+                    device.requests.push_back({request->client, request->request.id});
+                }
+            }
+            else if(device.converting)
+            {
+                // Queue the group until the conversion in progress completes.
+                device.queued.insert(device.queued.end(), group, end);
+            }
+            else
+            {
+                // An idle device starts one conversion for the whole group.
+                try
+                {
+                    server::begin_conversion(device, configuration);
+                    server::m_coalesced += (end - group) - 1;
+                    for(auto request = group; request != end; ++request)
+                    {
+                        device.requests.push_back({request->client, request->request.id});
+                    }
+                }
+                catch(...)
+                {
+                    for(auto request = group; request != end; ++request)
+                    {
+                        server::respond(request->client, request->request.id, daemon::status::FAILED);
+                    }
+                }
+            }
+        }
+
+        group = end;
+    }
+}
+void server::begin_conversion(server::device& device, ads101x::configuration configuration)
+{
+    // Start the conversion.
+    configuration.set_mode(ads101x::configuration::mode::SINGLESHOT);
+    configuration.set_operation(ads101x::configuration::operation::CONVERT);
+    device.driver->write_config(configuration);
+    device.conversion = configuration;
+    device.converting = true;
+
+    // Arm the timer for the conversion, allowing for the +/- 10% tolerance of the internal oscillator.
+    uint64_t period = ads101x::conversion_period_us(device.variant, configuration.get_data_rate()) * 1000ULL;
+    period += period / 10;
+    itimerspec expiry = {};
+    expiry.it_value.tv_sec = static_cast<time_t>(period / 1000000000ULL);
+    expiry.it_value.tv_nsec = static_cast<long>(period % 1000000000ULL);
+    timerfd_settime(device.timer, 0, &expiry, nullptr);
+}
+void server::complete_conversion(server::device& device)
+{
+    uint64_t expirations;
+    ssize_t result = read(device.timer, &expirations, sizeof(expirations));
+    (void)result;
+    device.converting = false;
+    std::vector<server::waiter> requests;
+    requests.swap(device.requests);
+
+    if(device.acquisition)
+    {
+        // A stream started during the conversion and took over the device.
+        for(auto& request : requests)
+        {
+            server::respond(request.client, request.id, daemon::status::BUSY);
+        }
+    }
+    else
+    {
+        // Read the result and answer every request sharing it.
+        try
+        {
+            ads101x::sample sample(device.driver->read_conversion(), device.conversion.get_fsr());
+            sample.channel = device.conversion.get_multiplexer();
+            sample.timestamp = ads101x::monotonic_ns();
+            sample.sequence = server::m_conversions++;
+            for(auto& request : requests)
+            {
+                server::respond(request.client, request.id, daemon::status::OK, sample);
+            }
+        }
+        catch(...)
+        {
+            for(auto& request : requests)
+            {
+                server::respond(request.client, request.id, daemon::status::FAILED);
+            }
+        }
+    }
+
+    // Serve the requests queued behind the conversion.
+    std::vector<server::pending> queued;
+    queued.swap(device.queued);
+    server::serve_singleshots(queued);
+}
+void server::disconnect(int32_t client)
+{
+    // Remove the client from every device before closing its socket, since streams push from their own threads.
+    for(auto& device : server::m_devices)
+    {
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(device->mutex);
+            auto subscriber = std::find(device->subscribers.begin(), device->subscribers.end(), client);
+            if(subscriber == device->subscribers.end())
+            {
+                last = false;
+            }
+            else
+            {
+                device->subscribers.erase(subscriber);
+                last = device->subscribers.empty();
+            }
+            device->waiters.erase(std::remove_if(device->waiters.begin(), device->waiters.end(), [client](const server::waiter& w) { return w.client == client; }), device->waiters.end());
+        }
+        device->requests.erase(std::remove_if(device->requests.begin(), device->requests.end(), [client](const server::waiter& w) { return w.client == client; }), device->requests.end());
+        device->queued.erase(std::remove_if(device->queued.begin(), device->queued.end(), [client](const server::pending& p) { return p.client == client; }), device->queued.end());
+        if(last)
+        {
+            server::stop_stream(*device);
+        }
+    }
+    ::close(client);
+    server::m_clients.erase(std::remove(server::m_clients.begin(), server::m_clients.end(), client), server::m_clients.end());
+    server::m_client_count = server::m_clients.size();
+}
+
+// STREAMS
+void server::start_stream(server::device& device)
+{
+    auto acquisition = std::make_unique<ads101x::acquisition>(*device.driver, device.block_size, 16);
+    acquisition->set_mode(device.alert_rdy_pin >= 0 ? ads101x::acquisition::mode::DATA_READY : ads101x::acquisition::mode::POLLING);
+    acquisition->set_configuration(device.configuration);
+    acquisition->set_variant(device.variant);
+    acquisition->set_channels({device.configuration.get_multiplexer()});
+    if(device.alert_rdy_pin >= 0)
+    {
+        acquisition->set_alert_rdy_pin(device.alert_rdy_pin);
+    }
+    acquisition->set_realtime(server::m_realtime_profile);
+    acquisition->add_sink([this, &device](std::span<const ads101x::sample> block) { server::push(device, block); });
+    acquisition->add_sample_sink([this, &device](const ads101x::sample& sample) { server::answer(device, sample); });
+    acquisition->start();
+    device.acquisition = std::move(acquisition);
+}
+void server::stop_stream(server::device& device)
+{
+    if(!device.acquisition)
+    {
+        return;
+    }
+    device.acquisition->stop();
+    device.acquisition.reset();
+
+    // Single-shots waiting on the stream can no longer be answered by it.
+    std::lock_guard<std::mutex> lock(device.mutex);
+    for(auto& waiter : device.waiters)
+    {
+        server::respond(waiter.client, waiter.id, daemon::status::BUSY);
+    }
+    device.waiters.clear();
+    device.waiting = false;
+}
+void server::drop_stream(server::device& device)
+{
+    // Release the acquisition even if powering down the device fails.
+    try
+    {
+        server::stop_stream(device);
+    }
+    catch(...)
+    {}
+    device.acquisition.reset();
+
+    // Tell the subscribers their stream has stopped.
+    std::lock_guard<std::mutex> lock(device.mutex);
+    daemon::block_header header = {daemon::message::STOPPED, device.index, 0};
+    for(int32_t subscriber : device.subscribers)
+    {
+        send(subscriber, &header, sizeof(header), MSG_DONTWAIT | MSG_NOSIGNAL);
+    }
+    device.subscribers.clear();
+}
+void server::push(server::device& device, std::span<const ads101x::sample> block)
+{
+    std::lock_guard<std::mutex> lock(device.mutex);
+
+    // Build the block message.
+    daemon::block_header header = {daemon::message::BLOCK, device.index, static_cast<uint32_t>(block.size())};
+    std::memcpy(device.message.data(), &header, sizeof(header));
+    std::memcpy(device.message.data() + sizeof(header), block.data(), block.size_bytes());
+    size_t size = sizeof(header) + block.size_bytes();
+
+    // Push it to every subscriber without blocking the acquisition thread.
+    for(int32_t subscriber : device.subscribers)
+    {
+        if(send(subscriber, device.message.data(), size, MSG_DONTWAIT | MSG_NOSIGNAL) < 0)
+        {
+            server::m_dropped++;
+        }
+    }
+}
+void server::answer(server::device& device, const ads101x::sample& sample)
+{
+    // Only lock when single-shots are waiting.
+    if(!device.waiting.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    // Answer waiting single-shots with the new sample.
+    std::lock_guard<std::mutex> lock(device.mutex);
+    server::m_coalesced += device.waiters.size();
+    for(auto& waiter : device.waiters)
+    {
+        server::respond(waiter.client, waiter.id, daemon::status::OK, sample);
+    }
+    device.waiters.clear();
+    device.waiting = false;
+}
+void server::respond(int32_t client, uint32_t id, daemon::status status, const ads101x::sample& sample)
+{
+    daemon::response response = {daemon::message::RESPONSE, status, id, sample};
+    send(client, &response, sizeof(response), MSG_DONTWAIT | MSG_NOSIGNAL);
+}
@@ -0,0 +1,49 @@
+#include <ads101x/event.hpp>
+
+// std
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+// posix
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+using namespace ads101x;
+
+// CONSTRUCTORS
+event::event()
+{
+    // Create a non-blocking eventfd.
+    event::m_descriptor = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(event::m_descriptor < 0)
+    {
+        throw std::runtime_error("failed to create eventfd (" + std::string(std::strerror(errno)) + ")");
+    }
+}
+event::~event()
+{
+    close(event::m_descriptor);
+}
+
+// EVENT
+int32_t event::descriptor() const
+{
+    return event::m_descriptor;
+}
+void event::signal(uint64_t count) const
+{
+    // The write only fails if the counter would overflow, in which case the event is already readable.
+    ssize_t result = write(event::m_descriptor, &count, sizeof(count));
+    (void)result;
+}
+uint64_t event::consume() const
+{
+    // A non-blocking read fails with EAGAIN if no signals are pending.
+    uint64_t count = 0;
+    if(read(event::m_descriptor, &count, sizeof(count)) != sizeof(count))
+    {
+        return 0;
+    }
+    return count;
+}
@@ -0,0 +1,119 @@
+#include <ads101x/histogram.hpp>
+
+// std
+#include <bit>
+#include <cmath>
+
+using namespace ads101x;
+
+// CONSTRUCTORS
+histogram::histogram()
+{
+    histogram::reset();
+}
+
+// RECORDING
+void histogram::record(uint64_t value)
+{
+    histogram::m_buckets[histogram::index(value)]++;
+    histogram::m_count++;
+    histogram::m_sum += static_cast<double>(value);
+    if(value < histogram::m_min)
+    {
+        histogram::m_min = value;
+    }
+    if(value > histogram::m_max)
+    {
+        histogram::m_max = value;
+    }
+}
+void histogram::reset()
+{
+    histogram::m_buckets.fill(0);
+    histogram::m_count = 0;
+    histogram::m_sum = 0;
+    histogram::m_min = UINT64_MAX;
+    histogram::m_max = 0;
+}
+
+// STATISTICS
+uint64_t histogram::count() const
+{
+    return histogram::m_count;
+}
+uint64_t histogram::min() const
+{
+    return histogram::m_count ? histogram::m_min : 0;
+}
+uint64_t histogram::max() const
+{
+    return histogram::m_max;
+}
+double histogram::mean() const
+{
+    return histogram::m_count ? histogram::m_sum / static_cast<double>(histogram::m_count) : 0.0;
+}
+uint64_t histogram::percentile(double percentile) const
+{
+    if(histogram::m_count == 0)
+    {
+        return 0;
+    }
+
+    // Find the bucket holding the value at the percentile's rank.
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(histogram::m_count)));
+    rank = (rank == 0) ? 1 : rank;
+    uint64_t seen = 0;
+    for(uint32_t i = 0; i < histogram::bucket_count; ++i)
+    {
+        seen += histogram::m_buckets[i];
+        if(seen >= rank)
+        {
+            uint64_t upper = histogram::upper_bound(i);
+            return (upper < histogram::m_max) ? upper : histogram::m_max;
+        }
+    }
+    return histogram::m_max;
+}
+void histogram::print(std::ostream& stream, double scale) const
+{
+    for(uint32_t i = 0; i < histogram::bucket_count; ++i)
+    {
+        if(histogram::m_buckets[i] > 0)
+        {
+            stream << histogram::lower_bound(i) / scale << " " << histogram::upper_bound(i) / scale << " " << histogram::m_buckets[i] << std::endl;
+        }
+    }
+}
+
+// BUCKETS
+uint32_t histogram::index(uint64_t value)
+{
+    // Values below 32 have their own bucket.
+    if(value < 32)
+    {
+        return static_cast<uint32_t>(value);
+    }
+
+    // Otherwise keep the top five bits, whose leading bit is always set.
+    uint32_t shift = std::bit_width(value) - 5;
+    return 32 + (shift - 1) * 16 + static_cast<uint32_t>((value >> shift) - 16);
+}
+uint64_t histogram::lower_bound(uint32_t index)
+{
+    if(index < 32)
+    {
+        return index;
+    }
+    uint32_t shift = (index - 32) / 16 + 1;
+    return (static_cast<uint64_t>((index - 32) % 16 + 16)) << shift;
+}
+uint64_t histogram::upper_bound(uint32_t index)
+{
+    if(index < 32)
+    {
+        return index;
+    }
+    uint32_t shift = (index - 32) / 16 + 1;
+    return histogram::lower_bound(index) + ((1ULL << shift) - 1);
+}
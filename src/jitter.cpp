@@ -0,0 +1,69 @@
+#include <ads101x/jitter.hpp>
+
+// std
+#include <iomanip>
+
+using namespace ads101x;
+
+// CONSTRUCTORS
+jitter::jitter()
+    : m_last_read(0)
+{}
+
+// RECORDING
+void jitter::attach(ads101x::acquisition& acquisition)
+{
+    acquisition.set_timing_probe([this](uint64_t ready, uint64_t read) { jitter::record(ready, read); });
+}
+void jitter::record(uint64_t ready, uint64_t read)
+{
+    if(jitter::m_last_read != 0)
+    {
+        jitter::m_intervals.record(read - jitter::m_last_read);
+    }
+    jitter::m_last_read = read;
+
+    // A read started before its timer deadline has no latency.
+    jitter::m_latencies.record((read > ready) ? read - ready : 0);
+}
+void jitter::reset()
+{
+    jitter::m_intervals.reset();
+    jitter::m_latencies.reset();
+    jitter::m_last_read = 0;
+}
+
+// RESULTS
+const ads101x::histogram& jitter::intervals() const
+{
+    return jitter::m_intervals;
+}
+const ads101x::histogram& jitter::latencies() const
+{
+    return jitter::m_latencies;
+}
+void jitter::print(std::ostream& stream, bool histograms) const
+{
+    // Print a summary line for each histogram.
+    auto summarize = [&stream](const char* name, const ads101x::histogram& histogram)
+    {
+        stream << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(1)
+               << " n=" << histogram.count()
+               << " mean=" << histogram.mean() / 1000.0
+               << " p50=" << histogram.percentile(50) / 1000.0
+               << " p99=" << histogram.percentile(99) / 1000.0
+               << " p99.9=" << histogram.percentile(99.9) / 1000.0
+               << " max=" << histogram.max() / 1000.0 << " us" << std::endl;
+    };
+    summarize("interval", jitter::m_intervals);
+    summarize("latency", jitter::m_latencies);
+
+    // Print the buckets if requested.
+    if(histograms)
+    {
+        stream << std::endl << "interval histogram (lower_us upper_us count):" << std::endl;
+        jitter::m_intervals.print(stream, 1000.0);
+        stream << std::endl << "latency histogram (lower_us upper_us count):" << std::endl;
+        jitter::m_latencies.print(stream, 1000.0);
+    }
+}
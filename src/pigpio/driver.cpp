@@ -1,6 +1,7 @@
 #include <ads101x/pigpio/driver.hpp>
 
 // ads101x
+#include <ads101x/clock.hpp>
 #include <ads101x/pigpio/error.hpp>
 
 // pigpio
@@ -11,9 +12,31 @@
 
 using namespace ads101x::pigpio;
 
+/// \brief Converts subscribed ALERT_RDY edges to a pigpio ISR edge.
+/// \param edge The subscribed edges.
+/// \return The pigpio edge.
+static uint32_t isr_edge(ads101x::edge edge)
+{
+    switch(edge)
+    {
+        case ads101x::edge::RISING:
+            return RISING_EDGE;
+        case ads101x::edge::FALLING:
+            return FALLING_EDGE;
+        default:
+            return EITHER_EDGE;
+    }
+}
+
 // CONSTRUCTORS
 driver::driver()
-    : m_i2c_handle(PI_NO_HANDLE)
+    : m_i2c_handle(PI_NO_HANDLE),
+      m_interrupt_mode(driver::interrupt_mode::SAMPLED),
+      m_attached_mode(driver::interrupt_mode::SAMPLED),
+      m_watchdog(0),
+      m_sampled_pin(0),
+      m_sampled_level(true),
+      m_sampled_tick(0)
 {}
 driver::~driver()
 {
@@ -22,10 +45,14 @@ driver::~driver()
 }
 
 // PIGPIO
-void driver::pigpio_initialize()
+void driver::pigpio_initialize(uint32_t sample_period_us)
 {
+    // Try to configure the GPIO sample period, which must happen before initialization.
+    int32_t result = gpioCfgClock(sample_period_us, PI_CLOCK_PCM, 0);
+    ads101x::pigpio::error(result);
+
     // Try to initialize the library.
-    int32_t result = gpioInitialise();
+    result = gpioInitialise();
 
     // Handle error if present.
     ads101x::pigpio::error(result);
@@ -36,6 +63,12 @@ void driver::pigpio_terminate()
     gpioTerminate();
 }
 
+// ALERT_RDY
+void driver::set_interrupt_mode(driver::interrupt_mode mode)
+{
+    driver::m_interrupt_mode = mode;
+}
+
 // OVERRIDES
 void driver::open_i2c(uint32_t i2c_bus, uint8_t i2c_address)
 {
@@ -85,6 +118,24 @@ uint16_t driver::read_register(uint8_t register_address) const
     // Extract 16-bit value from result, handling endianness.
     return be16toh(static_cast<uint16_t>(result));
 }
+void driver::read_registers(uint8_t register_address, std::span<uint16_t> values) const
+{
+    // Set the register pointer once. The ADS101X keeps it until the next write, so each value can then be read with a
+    // plain two byte read instead of a pointer write and repeated start.
+    int32_t result = i2cWriteByte(driver::m_i2c_handle, register_address);
+    ads101x::pigpio::error(result);
+
+    // Read each value.
+    for(auto& value : values)
+    {
+        char bytes[2];
+        result = i2cReadDevice(driver::m_i2c_handle, bytes, sizeof(bytes));
+        ads101x::pigpio::error(result);
+
+        // Assemble the big endian value.
+        value = (static_cast<uint8_t>(bytes[0]) << 8) | static_cast<uint8_t>(bytes[1]);
+    }
+}
 
 // ALERT_RDY
 void driver::attach_interrupt(uint16_t pin)
@@ -98,25 +149,109 @@ void driver::attach_interrupt(uint16_t pin)
     ads101x::pigpio::error(result);
 
     // Try to attach interrupt.
-    result = gpioSetAlertFuncEx(pin, &driver::interrupt_callback, this);
+    switch(driver::m_interrupt_mode)
+    {
+        case driver::interrupt_mode::ISR:
+        {
+            // Ask the kernel for the subscribed edges only.
+            result = gpioSetISRFuncEx(pin, isr_edge(driver::alert_rdy_edge()), 0, &driver::interrupt_callback, this);
+            break;
+        }
+        case driver::interrupt_mode::BATCHED:
+        {
+            // Start from the current level, so only changes are reported as edges.
+            result = gpioRead(pin);
+            ads101x::pigpio::error(result);
+            driver::m_sampled_level = result;
+            driver::m_sampled_pin = pin;
+            result = gpioSetGetSamplesFuncEx(&driver::samples_callback, 1U << pin, this);
+            break;
+        }
+        default:
+        {
+            result = gpioSetAlertFuncEx(pin, &driver::interrupt_callback, this);
+            break;
+        }
+    }
     ads101x::pigpio::error(result);
+
+    // Store the mode to detach with.
+    driver::m_attached_mode = driver::m_interrupt_mode;
+    driver::m_watchdog = 0;
 }
 void driver::detach_interrupt(uint16_t pin)
 {
     // Try to detach interrupt.
-    int32_t result = gpioSetAlertFuncEx(pin, nullptr, nullptr);
+    int32_t result;
+    switch(driver::m_attached_mode)
+    {
+        case driver::interrupt_mode::ISR:
+            result = gpioSetISRFuncEx(pin, EITHER_EDGE, 0, nullptr, nullptr);
+            break;
+        case driver::interrupt_mode::BATCHED:
+            result = gpioSetGetSamplesFuncEx(nullptr, 0, nullptr);
+            break;
+        default:
+            result = gpioSetAlertFuncEx(pin, nullptr, nullptr);
+            break;
+    }
 
     // Handle error if present.
     ads101x::pigpio::error(result);
 }
+void driver::set_watchdog(uint16_t pin, uint32_t timeout_ms)
+{
+    // Try to set the watchdog for the attached mode.
+    int32_t result = 0;
+    switch(driver::m_attached_mode)
+    {
+        case driver::interrupt_mode::ISR:
+        {
+            // ISRs time out through their own timeout, so reattach with it.
+            result = gpioSetISRFuncEx(pin, isr_edge(driver::alert_rdy_edge()), timeout_ms, &driver::interrupt_callback, this);
+            break;
+        }
+        case driver::interrupt_mode::BATCHED:
+        {
+            // Sample callbacks run every millisecond, so they time the watchdog from the last edge.
+            driver::m_sampled_tick = gpioTick();
+            break;
+        }
+        default:
+        {
+            result = gpioSetWatchdog(pin, timeout_ms);
+            break;
+        }
+    }
+    ads101x::pigpio::error(result);
+
+    // Store the timeout.
+    driver::m_watchdog = timeout_ms;
+}
 void driver::interrupt_callback(int32_t pin, int32_t level, uint32_t tick, void* data)
 {
-    // Verify level is not a watchdog timeout.
-    if(level == 2)
+    // Convert user data to driver instance.
+    ads101x::pigpio::driver* driver = reinterpret_cast<ads101x::pigpio::driver*>(data);
+
+    // Verify driver instance.
+    if(!driver)
+    {
+        return;
+    }
+
+    // Raise watchdog and ISR timeouts as stalls.
+    if(level == PI_TIMEOUT)
     {
+        driver->raise_stall(pin);
         return;
     }
 
+    // Convert the microsecond tick of the edge to CLOCK_MONOTONIC, and raise interrupt on driver.
+    uint32_t age = gpioTick() - tick;
+    driver->raise_interrupt(pin, level, ads101x::monotonic_ns() - static_cast<uint64_t>(age) * 1000ULL);
+}
+void driver::samples_callback(const gpioSample_t* samples, int32_t count, void* data)
+{
     // Convert user data to driver instance.
     ads101x::pigpio::driver* driver = reinterpret_cast<ads101x::pigpio::driver*>(data);
 
@@ -126,6 +261,43 @@ void driver::interrupt_callback(int32_t pin, int32_t level, uint32_t tick, void*
         return;
     }
 
-    // Raise interrupt on driver.
-    driver->raise_interrupt(pin, level);
-}
\ No newline at end of file
+    // Collect the edges of ALERT/RDY, converting their microsecond ticks to CLOCK_MONOTONIC. Samples are also reported
+    // for other GPIOs of interest to pigpio, so only level changes count.
+    uint16_t pin = driver->m_sampled_pin;
+    uint64_t now = ads101x::monotonic_ns();
+    uint32_t tick = gpioTick();
+    ads101x::edge_event edges[64];
+    size_t size = 0;
+    for(int32_t i = 0; i < count; ++i)
+    {
+        bool level = (samples[i].level >> pin) & 1U;
+        if(level == driver->m_sampled_level)
+        {
+            continue;
+        }
+        driver->m_sampled_level = level;
+        driver->m_sampled_tick = samples[i].tick;
+        edges[size++] = {level, now - static_cast<uint64_t>(tick - samples[i].tick) * 1000ULL};
+
+        // Raise a full batch early.
+        if(size == sizeof(edges) / sizeof(edges[0]))
+        {
+            driver->raise_interrupts(pin, std::span<ads101x::edge_event>(edges, size));
+            size = 0;
+        }
+    }
+
+    // Raise the remaining edges as one batch.
+    if(size != 0)
+    {
+        driver->raise_interrupts(pin, std::span<ads101x::edge_event>(edges, size));
+    }
+
+    // Raise a stall after each watchdog timeout without an edge.
+    uint32_t watchdog = driver->m_watchdog.load(std::memory_order_relaxed);
+    if(watchdog != 0 && tick - driver->m_sampled_tick >= watchdog * 1000U)
+    {
+        driver->m_sampled_tick = tick;
+        driver->raise_stall(pin);
+    }
+}
@@ -81,6 +81,26 @@ void ads101x::pigpio::error(int32_t result)
             message += "i2c read failed";
             break;
         }
+        case PI_BAD_CLK_MICROS:
+        {
+            message += "invalid sample rate specified";
+            break;
+        }
+        case PI_BAD_EDGE:
+        {
+            message += "invalid interrupt edge specified";
+            break;
+        }
+        case PI_BAD_ISR_INIT:
+        {
+            message += "interrupt initialization failed";
+            break;
+        }
+        case PI_BAD_WDOG_TIMEOUT:
+        {
+            message += "invalid watchdog timeout specified";
+            break;
+        }
         default:
         {
             message += std::to_string(result);
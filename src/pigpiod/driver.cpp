@@ -1,24 +1,43 @@
 #include <ads101x/pigpiod/driver.hpp>
 
 // ads101x
+#include <ads101x/clock.hpp>
 #include <ads101x/pigpiod/error.hpp>
 
 // pigpio
 #include <pigpiod_if2.h>
 
 // std
+#include <algorithm>
 #include <endian.h>
+#include <stdexcept>
 
 using namespace ads101x::pigpiod;
 
 // CONSTRUCTORS
 driver::driver()
     : m_daemon_handle(PI_NO_HANDLE),
-      m_i2c_handle(PI_NO_HANDLE)
+      m_i2c_handle(PI_NO_HANDLE),
+      m_port(0),
+      m_i2c_bus(0),
+      m_i2c_address(0),
+      m_registers{0, 0, 0},
+      m_registers_written(0),
+      m_auto_reconnect(true),
+      m_reconnects(0),
+      m_reconnect_latency(0)
 {}
 driver::driver(int32_t daemon_handle)
     : m_daemon_handle(daemon_handle),
-      m_i2c_handle(PI_NO_HANDLE)
+      m_i2c_handle(PI_NO_HANDLE),
+      m_port(0),
+      m_i2c_bus(0),
+      m_i2c_address(0),
+      m_registers{0, 0, 0},
+      m_registers_written(0),
+      m_auto_reconnect(true),
+      m_reconnects(0),
+      m_reconnect_latency(0)
 {}
 driver::~driver()
 {
@@ -38,8 +57,10 @@ void driver::pigpiod_connect(const std::string& ip_address, uint16_t port)
     // Handle error if necessary.
     ads101x::pigpiod::error(result);
 
-    // Store deamon handle.
+    // Store deamon handle, and the address to reconnect to.
     driver::m_daemon_handle = result;
+    driver::m_ip_address = ip_address;
+    driver::m_port = port;
 }
 void driver::pigpiod_disconnect()
 {
@@ -52,12 +73,76 @@ void driver::pigpiod_disconnect()
 
     // Disconnect from daemon.
     pigpio_stop(driver::m_daemon_handle);
+    driver::m_daemon_handle = PI_NO_HANDLE;
+    driver::m_ip_address.clear();
+}
+void driver::pigpiod_reconnect()
+{
+    // Verify the driver opened the connection.
+    if(driver::m_ip_address.empty())
+    {
+        throw std::runtime_error("pigpiod driver cannot reconnect a connection it did not open");
+    }
+    uint64_t start = ads101x::monotonic_ns();
+
+    // Cancel the callbacks of the dropped connection, and close it.
+    for(auto& callback : driver::m_callback_handles)
+    {
+        callback_cancel(callback.second);
+    }
+    pigpio_stop(driver::m_daemon_handle);
+    bool reopen = driver::m_i2c_handle >= 0;
+    driver::m_daemon_handle = PI_NO_HANDLE;
+    driver::m_i2c_handle = PI_NO_HANDLE;
+
+    // Try to connect.
+    int32_t result = pigpio_start(driver::m_ip_address.c_str(), std::to_string(driver::m_port).c_str());
+    ads101x::pigpiod::error(result);
+    driver::m_daemon_handle = result;
+
+    // Reopen I2C, and restore the registers.
+    if(reopen)
+    {
+        result = i2c_open(driver::m_daemon_handle, driver::m_i2c_bus, driver::m_i2c_address, 0);
+        ads101x::pigpiod::error(result);
+        driver::m_i2c_handle = result;
+        driver::restore();
+    }
+
+    // Reattach the callbacks and watchdogs.
+    for(auto& callback : driver::m_callback_handles)
+    {
+        callback.second = driver::subscribe(callback.first);
+    }
+    for(auto& watchdog : driver::m_watchdogs)
+    {
+        result = ::set_watchdog(driver::m_daemon_handle, watchdog.first, watchdog.second);
+        ads101x::pigpiod::error(result);
+    }
+
+    // Update metrics.
+    driver::m_reconnects++;
+    driver::m_reconnect_latency = ads101x::monotonic_ns() - start;
+}
+void driver::set_auto_reconnect(bool enabled)
+{
+    driver::m_auto_reconnect = enabled;
 }
 int32_t driver::pigpiod_handle() const
 {
     return driver::m_daemon_handle;
 }
 
+// METRICS
+uint64_t driver::reconnects() const
+{
+    return driver::m_reconnects;
+}
+uint64_t driver::reconnect_latency() const
+{
+    return driver::m_reconnect_latency;
+}
+
 // OVERRIDES
 void driver::open_i2c(uint32_t i2c_bus, uint8_t i2c_address)
 {
@@ -67,8 +152,11 @@ void driver::open_i2c(uint32_t i2c_bus, uint8_t i2c_address)
     // Handle error if present.
     ads101x::pigpiod::error(result);
 
-    // Store new handle.
+    // Store new handle, and start a new snapshot.
     driver::m_i2c_handle = result;
+    driver::m_i2c_bus = i2c_bus;
+    driver::m_i2c_address = i2c_address;
+    driver::m_registers_written = 0;
 }
 void driver::close_i2c()
 {
@@ -90,16 +178,31 @@ void driver::close_i2c()
 }
 void driver::write_register(uint8_t register_address, uint16_t value) const
 {
-    // Try to write 16-bit value (big endian) to the register.
+    // Try to write 16-bit value (big endian) to the register, retrying once after a reconnect.
     int32_t result = i2c_write_word_data(driver::m_daemon_handle, driver::m_i2c_handle, register_address, htobe16(value));
+    if(driver::recover(result))
+    {
+        result = i2c_write_word_data(driver::m_daemon_handle, driver::m_i2c_handle, register_address, htobe16(value));
+    }
 
     // Handle error if present.
     ads101x::pigpiod::error(result);
+
+    // Snapshot the CONFIG, LO_THRESH and HI_THRESH registers.
+    if(register_address >= static_cast<uint8_t>(ads101x::register_address::CONFIG))
+    {
+        driver::m_registers[register_address - 1] = value;
+        driver::m_registers_written |= 1 << (register_address - 1);
+    }
 }
 uint16_t driver::read_register(uint8_t register_address) const
 {
-    // Try to read 16-bit value from the register.
+    // Try to read 16-bit value from the register, retrying once after a reconnect.
     int32_t result = i2c_read_word_data(driver::m_daemon_handle, driver::m_i2c_handle, register_address);
+    if(driver::recover(result))
+    {
+        result = i2c_read_word_data(driver::m_daemon_handle, driver::m_i2c_handle, register_address);
+    }
 
     // Handle error if present.
     ads101x::pigpiod::error(result);
@@ -107,8 +210,64 @@ uint16_t driver::read_register(uint8_t register_address) const
     // Extract 16-bit value from result, handling endianness.
     return be16toh(static_cast<uint16_t>(result));
 }
+void driver::read_registers(uint8_t register_address, std::span<uint16_t> values) const
+{
+    // Batch the reads into I2C zip commands, each costing one round trip to the daemon. A zip sets the register
+    // pointer once and is followed by a two byte read per value.
+    const size_t batch_size = 32;
+    uint64_t deadline = driver::operation_deadline();
+    for(size_t offset = 0; offset < values.size(); offset += batch_size)
+    {
+        size_t count = std::min(batch_size, values.size() - offset);
+
+        // Stop issuing round trips once the deadline has passed.
+        if(deadline != 0 && offset != 0 && ads101x::monotonic_ns() >= deadline)
+        {
+            throw ads101x::timeout_error("i2c zip read did not complete by the deadline");
+        }
+
+        // Build the zip command.
+        char commands[4 + 2 * batch_size];
+        uint32_t length = 0;
+        commands[length++] = PI_I2C_WRITE;
+        commands[length++] = 1;
+        commands[length++] = register_address;
+        for(size_t i = 0; i < count; ++i)
+        {
+            commands[length++] = PI_I2C_READ;
+            commands[length++] = 2;
+        }
+        commands[length++] = PI_I2C_END;
+
+        // Try to execute the zip command, retrying once after a reconnect.
+        char bytes[2 * batch_size];
+        int32_t result = i2c_zip(driver::m_daemon_handle, driver::m_i2c_handle, commands, length, bytes, 2 * count);
+        if(driver::recover(result))
+        {
+            result = i2c_zip(driver::m_daemon_handle, driver::m_i2c_handle, commands, length, bytes, 2 * count);
+        }
+        ads101x::pigpiod::error(result);
+
+        // Verify that every value was read.
+        if(static_cast<size_t>(result) != 2 * count)
+        {
+            throw std::runtime_error("i2c zip read returned " + std::to_string(result) + " of " + std::to_string(2 * count) + " bytes");
+        }
+
+        // Assemble the big endian values.
+        for(size_t i = 0; i < count; ++i)
+        {
+            values[offset + i] = (static_cast<uint8_t>(bytes[2 * i]) << 8) | static_cast<uint8_t>(bytes[2 * i + 1]);
+        }
+    }
+}
 
 void driver::attach_interrupt(uint16_t pin)
+{
+    // Try to subscribe, and store the callback handle for the pin.
+    driver::m_callback_handles[pin] = driver::subscribe(pin);
+}
+int32_t driver::subscribe(uint16_t pin)
 {
     // Try to set the pin for input.
     int32_t result = set_mode(driver::m_daemon_handle, pin, PI_INPUT);
@@ -118,12 +277,20 @@ void driver::attach_interrupt(uint16_t pin)
     result = set_pull_up_down(driver::m_daemon_handle, pin, PI_PUD_UP);
     ads101x::pigpiod::error(result);
 
-    // Try to attach interrupt.
-    result = callback_ex(driver::m_daemon_handle, pin, EITHER_EDGE, &driver::interrupt_callback, this);
+    // Try to attach interrupt, letting the daemon's client thread filter the subscribed edges.
+    uint32_t edge = EITHER_EDGE;
+    if(driver::alert_rdy_edge() == ads101x::edge::RISING)
+    {
+        edge = RISING_EDGE;
+    }
+    else if(driver::alert_rdy_edge() == ads101x::edge::FALLING)
+    {
+        edge = FALLING_EDGE;
+    }
+    result = callback_ex(driver::m_daemon_handle, pin, edge, &driver::interrupt_callback, this);
     ads101x::pigpiod::error(result);
 
-    // Store the callback handle for the pin.
-    driver::m_callback_handles[pin] = result;
+    return result;
 }
 void driver::detach_interrupt(uint16_t pin)
 {
@@ -142,14 +309,24 @@ void driver::detach_interrupt(uint16_t pin)
     // Remove the entry from the callback handle map.
     driver::m_callback_handles.erase(handle_entry);
 }
-void driver::interrupt_callback(int32_t daemon_handle, uint32_t pin, uint32_t level, uint32_t tick, void* data)
+void driver::set_watchdog(uint16_t pin, uint32_t timeout_ms)
 {
-    // Verify level is not a watchdog timeout.
-    if(level == 2)
+    // Try to set the daemon's watchdog, which reports timeouts to the pin's callbacks.
+    int32_t result = ::set_watchdog(driver::m_daemon_handle, pin, timeout_ms);
+    ads101x::pigpiod::error(result);
+
+    // Snapshot the watchdog.
+    if(timeout_ms != 0)
     {
-        return;
+        driver::m_watchdogs[pin] = timeout_ms;
     }
-
+    else
+    {
+        driver::m_watchdogs.erase(pin);
+    }
+}
+void driver::interrupt_callback(int32_t daemon_handle, uint32_t pin, uint32_t level, uint32_t tick, void* data)
+{
     // Convert user data to driver instance.
     ads101x::pigpiod::driver* driver = reinterpret_cast<ads101x::pigpiod::driver*>(data);
 
@@ -159,6 +336,64 @@ void driver::interrupt_callback(int32_t daemon_handle, uint32_t pin, uint32_t le
         return;
     }
 
+    // Raise watchdog timeouts as stalls.
+    if(level == PI_TIMEOUT)
+    {
+        driver->raise_stall(pin);
+        return;
+    }
+
     // Raise interrupt on driver.
     driver->raise_interrupt(pin, level);
-}
\ No newline at end of file
+}
+
+// RECONNECT
+bool driver::recover(int32_t result) const
+{
+    // Check for a dropped connection that the driver can reconnect.
+    if(!driver::m_auto_reconnect || driver::m_ip_address.empty() || (result != pigif_bad_send && result != pigif_bad_recv && result != pigif_unconnected_pi))
+    {
+        return false;
+    }
+
+    // Reconnect. This restores the session the const operation was issued on, rather than changing it.
+    const_cast<ads101x::pigpiod::driver*>(this)->pigpiod_reconnect();
+    return true;
+}
+void driver::restore()
+{
+    // Check if any register needs restoring.
+    if(driver::m_registers_written == 0)
+    {
+        return;
+    }
+
+    // Build a zip command writing the thresholds before the configuration, which may start conversions.
+    const ads101x::register_address order[3] = {ads101x::register_address::LO_THRESH, ads101x::register_address::HI_THRESH, ads101x::register_address::CONFIG};
+    char commands[3 * 5 + 1];
+    uint32_t length = 0;
+    for(auto address : order)
+    {
+        uint8_t register_address = static_cast<uint8_t>(address);
+        if(driver::m_registers_written & (1 << (register_address - 1)))
+        {
+            // Clear the OS bit of CONFIG, which would otherwise start a spurious single-shot conversion.
+            uint16_t value = driver::m_registers[register_address - 1];
+            if(address == ads101x::register_address::CONFIG)
+            {
+                value &= 0x7FFF;
+            }
+            commands[length++] = PI_I2C_WRITE;
+            commands[length++] = 3;
+            commands[length++] = register_address;
+            commands[length++] = static_cast<char>(value >> 8);
+            commands[length++] = static_cast<char>(value);
+        }
+    }
+    commands[length++] = PI_I2C_END;
+
+    // Try to execute the zip command in one round trip.
+    char bytes[1];
+    int32_t result = i2c_zip(driver::m_daemon_handle, driver::m_i2c_handle, commands, length, bytes, 0);
+    ads101x::pigpiod::error(result);
+}
@@ -0,0 +1,163 @@
+#include <ads101x/planner.hpp>
+
+// ads101x
+#include <ads101x/clock.hpp>
+
+// std
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using namespace ads101x;
+
+/// \brief The I2C bits of a register write: start, address, pointer, two data bytes, and stop. Each byte is followed
+/// by an acknowledge bit.
+static const uint64_t write_bits = 1 + 4 * 9 + 1;
+/// \brief The I2C bits of a register read: start, address, pointer, repeated start, address, two data bytes, and stop.
+static const uint64_t read_bits = 1 + 2 * 9 + 1 + 3 * 9 + 1;
+
+// COST MODEL
+uint64_t planner::cost_model::write_ns() const
+{
+    return write_bits * 1000000000ULL / planner::cost_model::clock_hz + planner::cost_model::overhead_ns;
+}
+uint64_t planner::cost_model::read_ns() const
+{
+    return read_bits * 1000000000ULL / planner::cost_model::clock_hz + planner::cost_model::overhead_ns;
+}
+planner::cost_model planner::cost_model::calibrate(ads101x::driver& driver, uint32_t clock_hz, uint32_t transactions)
+{
+    // Measure the latency of each read.
+    std::vector<uint64_t> latencies(std::max<uint32_t>(transactions, 1));
+    for(auto& latency : latencies)
+    {
+        uint64_t start = ads101x::monotonic_ns();
+        driver.read_conversion();
+        latency = ads101x::monotonic_ns() - start;
+    }
+
+    // Take the overhead from the median, which ignores the odd preempted read.
+    std::nth_element(latencies.begin(), latencies.begin() + latencies.size() / 2, latencies.end());
+    uint64_t median = latencies[latencies.size() / 2];
+    planner::cost_model model = {clock_hz, 0};
+    uint64_t wire = model.read_ns();
+    model.overhead_ns = (median > wire) ? median - wire : 0;
+    return model;
+}
+
+// CONSTRUCTORS
+planner::planner(const planner::cost_model& model, double max_utilisation)
+    : m_model(model),
+      m_max_utilisation(max_utilisation)
+{}
+
+// PLANNING
+planner::report planner::evaluate(const std::vector<planner::request>& plan) const
+{
+    // Validate the requests, and count the devices.
+    uint32_t devices = 0;
+    for(auto& request : plan)
+    {
+        if(!(request.rate > 0))
+        {
+            throw std::runtime_error("planner request rates must be positive");
+        }
+        devices = std::max(devices, request.device + 1);
+    }
+    std::vector<uint32_t> channels(devices, 0);
+    for(auto& request : plan)
+    {
+        channels[request.device]++;
+    }
+    for(auto& request : plan)
+    {
+        if(request.mode == ads101x::configuration::mode::CONTINUOUS && channels[request.device] > 1)
+        {
+            throw std::runtime_error("planner continuous channel shares device " + std::to_string(request.device));
+        }
+    }
+
+    // Estimate the load of each device at the requested rates.
+    planner::report report;
+    report.device_utilisation.assign(devices, 0);
+    for(auto& request : plan)
+    {
+        if(request.mode == ads101x::configuration::mode::CONTINUOUS)
+        {
+            report.device_utilisation[request.device] += request.rate / ads101x::samples_per_second(request.variant, request.data_rate);
+        }
+        else
+        {
+            report.device_utilisation[request.device] += request.rate * planner::device_time(request);
+        }
+    }
+
+    // Scale the requests of overloaded devices down to fit.
+    report.rates.resize(plan.size());
+    for(size_t i = 0; i < plan.size(); ++i)
+    {
+        double load = report.device_utilisation[plan[i].device];
+        report.rates[i] = (load > 1) ? plan[i].rate / load : plan[i].rate;
+    }
+
+    // Estimate the bus load at the requested rates, and scale every request down uniformly if it overloads the bus.
+    report.bus_utilisation = 0;
+    double degraded = 0;
+    for(size_t i = 0; i < plan.size(); ++i)
+    {
+        report.bus_utilisation += plan[i].rate * planner::bus_time(plan[i]);
+        degraded += report.rates[i] * planner::bus_time(plan[i]);
+    }
+    if(degraded > planner::m_max_utilisation)
+    {
+        for(auto& rate : report.rates)
+        {
+            rate *= planner::m_max_utilisation / degraded;
+        }
+    }
+
+    // The plan is feasible if nothing had to be scaled.
+    report.feasible = report.bus_utilisation <= planner::m_max_utilisation;
+    for(auto load : report.device_utilisation)
+    {
+        report.feasible = report.feasible && load <= 1;
+    }
+
+    return report;
+}
+std::vector<double> planner::admit(const std::vector<planner::request>& plan, planner::policy policy) const
+{
+    planner::report report = planner::evaluate(plan);
+    if(report.feasible || policy == planner::policy::DEGRADE)
+    {
+        return report.rates;
+    }
+
+    // Reject the plan, naming the first overloaded resource.
+    for(uint32_t device = 0; device < report.device_utilisation.size(); ++device)
+    {
+        if(report.device_utilisation[device] > 1)
+        {
+            throw std::runtime_error("planner plan overruns device " + std::to_string(device) + " (" + std::to_string(static_cast<uint32_t>(report.device_utilisation[device] * 100)) + "% utilisation)");
+        }
+    }
+    throw std::runtime_error("planner plan overruns the bus (" + std::to_string(static_cast<uint32_t>(report.bus_utilisation * 100)) + "% utilisation)");
+}
+
+// COSTS
+double planner::bus_time(const planner::request& request) const
+{
+    // Continuous channels only read each conversion. Single-shot channels also write the configuration to start it.
+    uint64_t time = planner::m_model.read_ns();
+    if(request.mode == ads101x::configuration::mode::SINGLESHOT)
+    {
+        time += planner::m_model.write_ns();
+    }
+    return time / 1e9;
+}
+double planner::device_time(const planner::request& request) const
+{
+    // The device is busy from the configuration write until the conversion is read, allowing for the +/- 10%
+    // tolerance of the internal oscillator.
+    return (planner::m_model.write_ns() + ads101x::conversion_period_us(request.variant, request.data_rate) * 1100ULL + planner::m_model.read_ns()) / 1e9;
+}
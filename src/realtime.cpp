@@ -0,0 +1,56 @@
+#include <ads101x/realtime.hpp>
+
+// posix
+#include <alloca.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/// \brief Touches each page of a region of the calling thread's stack.
+/// \param size The number of bytes to touch.
+static void prefault_stack(size_t size)
+{
+    volatile uint8_t* stack = static_cast<volatile uint8_t*>(alloca(size));
+    long page = sysconf(_SC_PAGESIZE);
+    for(size_t i = 0; i < size; i += page)
+    {
+        stack[i] = 0;
+    }
+}
+
+ads101x::realtime_report ads101x::apply_realtime(const ads101x::realtime_profile& profile)
+{
+    ads101x::realtime_report report;
+
+    // Pin the thread first so memory is faulted in on the CPU it runs on.
+    if(profile.cpu >= 0 && profile.cpu < CPU_SETSIZE)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(profile.cpu, &set);
+        report.affinity = pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    }
+
+    // Lock memory before prefaulting so touched pages stay resident.
+    if(profile.lock_memory)
+    {
+        report.memory_locked = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+    }
+    if(profile.prefault)
+    {
+        prefault_stack(profile.stack_size);
+        report.prefaulted = true;
+    }
+
+    // Switch to SCHED_FIFO last, once the setup work that may page fault is done.
+    if(profile.priority > 0)
+    {
+        sched_param parameters = {};
+        parameters.sched_priority = profile.priority;
+        report.scheduling = pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters) == 0;
+    }
+
+    return report;
+}
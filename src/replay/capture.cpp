@@ -0,0 +1,134 @@
+#include <ads101x/replay/capture.hpp>
+
+// std
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace ads101x::replay;
+
+// EVENTS
+void capture::add_conversion(uint64_t time, int16_t value)
+{
+    if(!capture::m_events.empty() && time < capture::m_events.back().time)
+    {
+        throw std::runtime_error("capture events must be in time order");
+    }
+    capture::m_events.push_back({time, value, false, false});
+    capture::m_conversions++;
+}
+void capture::add_alert(uint64_t time, bool level)
+{
+    if(!capture::m_events.empty() && time < capture::m_events.back().time)
+    {
+        throw std::runtime_error("capture events must be in time order");
+    }
+    capture::m_events.push_back({time, 0, true, level});
+}
+void capture::add_samples(std::span<const ads101x::sample> samples)
+{
+    for(auto& sample : samples)
+    {
+        if(!capture::m_has_sample_epoch)
+        {
+            capture::m_sample_epoch = sample.timestamp;
+            capture::m_has_sample_epoch = true;
+        }
+        capture::add_conversion(sample.timestamp - capture::m_sample_epoch, sample.value);
+    }
+}
+const std::vector<capture::event>& capture::events() const
+{
+    return capture::m_events;
+}
+uint64_t capture::conversions() const
+{
+    return capture::m_conversions;
+}
+
+// FILES
+void capture::load(const std::string& path)
+{
+    // Open the file.
+    std::ifstream file(path);
+    if(!file.is_open())
+    {
+        throw std::runtime_error("failed to open capture file: " + path);
+    }
+
+    // Parse each line.
+    std::string line;
+    uint32_t line_number = 0;
+    while(std::getline(file, line))
+    {
+        ++line_number;
+
+        // Skip empty lines and comments.
+        std::istringstream stream(line);
+        std::string time_field;
+        if(!(stream >> time_field) || time_field[0] == '#')
+        {
+            continue;
+        }
+
+        // Parse the time and the conversion or alert.
+        std::string field;
+        try
+        {
+            uint64_t time = std::stoull(time_field);
+            if(!(stream >> field))
+            {
+                throw std::invalid_argument("missing value");
+            }
+            if(field == "alert")
+            {
+                int32_t level;
+                if(!(stream >> level) || (level != 0 && level != 1))
+                {
+                    throw std::invalid_argument("invalid level");
+                }
+                capture::add_alert(time, level);
+            }
+            else
+            {
+                int32_t value = std::stoi(field);
+                if(value < -2048 || value > 2047)
+                {
+                    throw std::invalid_argument("invalid value");
+                }
+                capture::add_conversion(time, static_cast<int16_t>(value));
+            }
+        }
+        catch(const std::exception&)
+        {
+            throw std::runtime_error("invalid capture event on line " + std::to_string(line_number) + " of " + path);
+        }
+    }
+}
+void capture::save(const std::string& path) const
+{
+    // Open the file.
+    std::ofstream file(path);
+    if(!file.is_open())
+    {
+        throw std::runtime_error("failed to create capture file: " + path);
+    }
+
+    // Write each event.
+    file << "# ads101x capture: <time_ns> <value> or <time_ns> alert <level>" << std::endl;
+    for(auto& event : capture::m_events)
+    {
+        if(event.alert)
+        {
+            file << event.time << " alert " << event.level << "\n";
+        }
+        else
+        {
+            file << event.time << " " << event.value << "\n";
+        }
+    }
+    if(!file.good())
+    {
+        throw std::runtime_error("failed to write capture file: " + path);
+    }
+}
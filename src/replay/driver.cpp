@@ -0,0 +1,288 @@
+#include <ads101x/replay/driver.hpp>
+
+// std
+#include <stdexcept>
+
+using namespace ads101x::replay;
+
+/// \brief Indicates if a configuration and thresholds put ALERT/RDY in conversion-ready mode.
+static bool conversion_ready_mode(const uint16_t* registers)
+{
+    // The comparator must be enabled, with the MSB of HI_THRESH set and the MSB of LO_THRESH clear.
+    return (registers[1] & 0x0003) != 0x0003 && (registers[3] & 0x8000) && !(registers[2] & 0x8000);
+}
+/// \brief Gets the idle ALERT/RDY pin level for a configuration.
+static bool idle_level(uint16_t config)
+{
+    return !(config & static_cast<uint16_t>(ads101x::configuration::comparator_polarity::ACTIVE_HIGH));
+}
+
+// CONSTRUCTORS
+driver::driver(const replay::capture& capture)
+    : m_events(capture.events()),
+      m_duration(0),
+      m_speed(1.0),
+      m_loop(false),
+      m_running(false),
+      m_cursor(0),
+      m_passes(0),
+      m_registers{0x0000, 0x0583, 0x8000, 0x7FF0},
+      m_finished(false),
+      m_played(0),
+      m_interrupt_pin(-1),
+      m_alert_rdy_level(true)
+{
+    if(capture.conversions() == 0)
+    {
+        throw std::runtime_error("replay capture has no conversions");
+    }
+
+    // A looped pass lasts one average conversion interval beyond the last event.
+    uint64_t last = driver::m_events.back().time;
+    driver::m_duration = last + ((capture.conversions() > 1) ? last / (capture.conversions() - 1) : 1);
+}
+driver::~driver()
+{
+    // Stop the playback thread if necessary.
+    driver::close_i2c();
+}
+
+// PLAYBACK
+void driver::set_speed(double speed)
+{
+    if(speed < 0)
+    {
+        throw std::runtime_error("replay speed must not be negative");
+    }
+    std::lock_guard<std::mutex> lock(driver::m_mutex);
+    driver::m_speed = speed;
+}
+void driver::set_loop(bool loop)
+{
+    std::lock_guard<std::mutex> lock(driver::m_mutex);
+    driver::m_loop = loop;
+}
+bool driver::finished() const
+{
+    return driver::m_finished;
+}
+uint64_t driver::played() const
+{
+    return driver::m_played;
+}
+
+// OVERRIDES
+void driver::open_i2c(uint32_t i2c_bus, uint8_t i2c_address)
+{
+    std::lock_guard<std::mutex> lock(driver::m_mutex);
+
+    // Rewind.
+    driver::m_cursor = 0;
+    driver::m_passes = 0;
+    driver::m_finished = false;
+    driver::m_played = 0;
+    driver::m_epoch = std::chrono::steady_clock::now();
+
+    if(driver::m_speed > 0)
+    {
+        // Play back on the capture's timeline.
+        driver::m_running = true;
+        driver::m_thread = std::thread(&driver::run, this);
+    }
+    else
+    {
+        // Load the first conversion. Nothing is attached to ALERT/RDY yet.
+        driver::activity activity = {false, false, false, driver::m_registers[1]};
+        driver::play_next(activity);
+    }
+}
+void driver::close_i2c()
+{
+    // Check if the playback thread is running.
+    {
+        std::lock_guard<std::mutex> lock(driver::m_mutex);
+        if(!driver::m_running)
+        {
+            return;
+        }
+        driver::m_running = false;
+    }
+
+    // Stop the playback thread.
+    driver::m_wake.notify_one();
+    driver::m_thread.join();
+}
+void driver::write_register(uint8_t register_address, uint16_t value) const
+{
+    driver::activity activity = {false, false, false, value};
+    {
+        std::lock_guard<std::mutex> lock(driver::m_mutex);
+
+        // The conversion register is read only, and the OS bit is not stored.
+        if(register_address == static_cast<uint8_t>(ads101x::register_address::CONFIG))
+        {
+            driver::m_registers[1] = value & 0x7FFF;
+
+            // As fast as possible, the current conversion is ready as soon as conversions are configured.
+            activity.pulse = driver::m_speed == 0 && conversion_ready_mode(driver::m_registers);
+        }
+        else if(register_address != static_cast<uint8_t>(ads101x::register_address::CONVERSION))
+        {
+            driver::m_registers[register_address & 0x03] = value;
+        }
+    }
+    driver::drive(activity);
+}
+uint16_t driver::read_register(uint8_t register_address) const
+{
+    driver::activity activity = {false, false, false, 0};
+    uint16_t value;
+    {
+        std::lock_guard<std::mutex> lock(driver::m_mutex);
+        activity.config = driver::m_registers[1];
+        switch(static_cast<ads101x::register_address>(register_address))
+        {
+            case ads101x::register_address::CONFIG:
+            {
+                // Conversions always appear complete.
+                value = driver::m_registers[1] | 0x8000;
+                break;
+            }
+            case ads101x::register_address::CONVERSION:
+            {
+                // As fast as possible, each read moves on to the next conversion.
+                value = driver::m_registers[0];
+                if(driver::m_speed == 0)
+                {
+                    driver::play_next(activity);
+                }
+                break;
+            }
+            default:
+            {
+                value = driver::m_registers[register_address & 0x03];
+                break;
+            }
+        }
+    }
+    driver::drive(activity);
+    return value;
+}
+void driver::attach_interrupt(uint16_t pin)
+{
+    std::lock_guard<std::recursive_mutex> lock(driver::m_interrupt_mutex);
+    driver::m_interrupt_pin = pin;
+}
+void driver::detach_interrupt(uint16_t pin)
+{
+    // Waits for any in-flight interrupt to finish.
+    std::lock_guard<std::recursive_mutex> lock(driver::m_interrupt_mutex);
+    driver::m_interrupt_pin = -1;
+}
+
+// PLAYBACK
+void driver::run()
+{
+    std::unique_lock<std::mutex> lock(driver::m_mutex);
+    while(driver::m_running)
+    {
+        // Wait until the next event is due on the scaled timeline.
+        size_t index = driver::m_cursor;
+        double time = (static_cast<double>(driver::m_passes) * driver::m_duration + driver::m_events[index].time) / driver::m_speed;
+        auto due = driver::m_epoch + std::chrono::nanoseconds(static_cast<int64_t>(time));
+        if(driver::m_wake.wait_until(lock, due, [this]() { return !driver::m_running; }))
+        {
+            break;
+        }
+
+        // Play the event, and drive ALERT/RDY outside of the lock.
+        driver::activity activity = {false, false, false, driver::m_registers[1]};
+        const replay::capture::event& event = driver::m_events[index];
+        bool playing = true;
+        if(event.alert)
+        {
+            // Play the explicit edge on its own.
+            driver::m_cursor++;
+            activity.drive = true;
+            activity.level = event.level;
+        }
+        else
+        {
+            playing = driver::play_next(activity);
+        }
+        if(driver::m_cursor >= driver::m_events.size() && driver::m_loop)
+        {
+            driver::m_cursor = 0;
+            driver::m_passes++;
+        }
+        lock.unlock();
+        driver::drive(activity);
+        lock.lock();
+
+        // Hold the last conversion once a non-looping capture finishes.
+        if(!playing || (driver::m_cursor >= driver::m_events.size() && !driver::m_loop))
+        {
+            driver::m_finished = true;
+            driver::m_wake.wait(lock, [this]() { return !driver::m_running; });
+        }
+    }
+}
+bool driver::play_next(driver::activity& activity) const
+{
+    while(true)
+    {
+        // Wrap or finish at the end of the capture.
+        if(driver::m_cursor >= driver::m_events.size())
+        {
+            if(!driver::m_loop)
+            {
+                driver::m_finished = true;
+                return false;
+            }
+            driver::m_cursor = 0;
+            driver::m_passes++;
+        }
+
+        // Play explicit edges until the next conversion.
+        const replay::capture::event& event = driver::m_events[driver::m_cursor++];
+        if(event.alert)
+        {
+            activity.drive = true;
+            activity.level = event.level;
+            continue;
+        }
+        driver::m_registers[0] = static_cast<uint16_t>(event.value << 4);
+        driver::m_played++;
+        activity.pulse = conversion_ready_mode(driver::m_registers);
+        return true;
+    }
+}
+void driver::drive(const driver::activity& activity) const
+{
+    if(activity.drive)
+    {
+        driver::drive_alert_rdy(activity.level);
+    }
+    if(activity.pulse)
+    {
+        driver::drive_alert_rdy(!idle_level(activity.config));
+        driver::drive_alert_rdy(idle_level(activity.config));
+    }
+}
+void driver::drive_alert_rdy(bool level) const
+{
+    std::lock_guard<std::recursive_mutex> lock(driver::m_interrupt_mutex);
+
+    // Only raise edges.
+    if(level == driver::m_alert_rdy_level)
+    {
+        return;
+    }
+    driver::m_alert_rdy_level = level;
+
+    // Raise the interrupt if attached.
+    if(driver::m_interrupt_pin >= 0)
+    {
+        const_cast<driver*>(this)->raise_interrupt(static_cast<uint16_t>(driver::m_interrupt_pin), level);
+    }
+}
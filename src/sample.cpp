@@ -0,0 +1,59 @@
+#include <ads101x/sample.hpp>
+
+using namespace ads101x;
+
+// CONSTRUCTORS
+sample::sample()
+    : value(0),
+      fsr(ads101x::configuration::fsr::FSR_2_048),
+      channel(ads101x::configuration::multiplexer::AIN0_AIN1),
+      timestamp(0),
+      sequence(0)
+{}
+sample::sample(uint16_t conversion, ads101x::configuration::fsr fsr)
+    : fsr(fsr),
+      channel(ads101x::configuration::multiplexer::AIN0_AIN1),
+      timestamp(0),
+      sequence(0)
+{
+    // Conversion is 12-bit two's complement. Sign extend into 16 bits.
+    sample::value = static_cast<int16_t>(static_cast<uint16_t>(conversion << 4)) >> 4;
+}
+
+// CONVERSION
+double sample::voltage() const
+{
+    // One LSB is the positive full scale voltage divided by 2^11.
+    return static_cast<double>(sample::value) * ads101x::fsr_voltage(sample::fsr) / 2048.0;
+}
+double ads101x::fsr_voltage(ads101x::configuration::fsr fsr)
+{
+    switch(fsr)
+    {
+        case ads101x::configuration::fsr::FSR_6_114:
+        {
+            return 6.144;
+        }
+        case ads101x::configuration::fsr::FSR_4_096:
+        {
+            return 4.096;
+        }
+        case ads101x::configuration::fsr::FSR_2_048:
+        {
+            return 2.048;
+        }
+        case ads101x::configuration::fsr::FSR_1_024:
+        {
+            return 1.024;
+        }
+        case ads101x::configuration::fsr::FSR_0_512:
+        {
+            return 0.512;
+        }
+        default:
+        {
+            // The three remaining PGA codes all select +/- 0.256V.
+            return 0.256;
+        }
+    }
+}
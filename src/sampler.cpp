@@ -0,0 +1,288 @@
+#include <ads101x/sampler.hpp>
+
+// ads101x
+#include <ads101x/clock.hpp>
+
+// std
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+// posix
+#include <poll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+using namespace ads101x;
+
+// CONSTRUCTORS
+sampler::sampler()
+    : m_running(false)
+{
+    // Create the timer on the monotonic clock.
+    sampler::m_timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if(sampler::m_timer < 0)
+    {
+        throw std::runtime_error("failed to create timerfd (" + std::string(std::strerror(errno)) + ")");
+    }
+}
+sampler::~sampler()
+{
+    // Stop the sampler if necessary.
+    sampler::stop();
+    close(sampler::m_timer);
+}
+
+// TASKS
+uint32_t sampler::add(ads101x::driver& driver, const ads101x::configuration& configuration, ads101x::configuration::multiplexer channel, uint64_t period_ns, std::function<void(const ads101x::sample&)> callback, ads101x::variant variant)
+{
+    // Verify state.
+    if(sampler::m_running)
+    {
+        throw std::runtime_error("sampler is already running");
+    }
+
+    // Verify the period exceeds the conversion time, allowing for the +/- 10% tolerance of the internal oscillator.
+    uint64_t conversion = ads101x::conversion_period_us(variant, configuration.get_data_rate()) * 1100ULL;
+    if(period_ns <= conversion)
+    {
+        throw std::runtime_error("sampler period is shorter than the conversion time");
+    }
+
+    // Find or add the task's device.
+    uint32_t device = 0;
+    while(device < sampler::m_devices.size() && sampler::m_devices[device].driver != &driver)
+    {
+        device++;
+    }
+    if(device == sampler::m_devices.size())
+    {
+        sampler::m_devices.push_back({&driver, false});
+    }
+
+    // Create the task with a single-shot configuration.
+    auto task = std::make_unique<sampler::task>();
+    task->device = device;
+    task->configuration = configuration;
+    task->configuration.set_multiplexer(channel);
+    task->configuration.set_mode(ads101x::configuration::mode::SINGLESHOT);
+    task->configuration.set_operation(ads101x::configuration::operation::CONVERT);
+    task->period = period_ns;
+    task->conversion = conversion;
+    task->callback = callback;
+    task->deadline = 0;
+    task->started = 0;
+    task->samples = 0;
+    task->overruns = 0;
+    task->errors = 0;
+    task->max_latency = 0;
+    sampler::m_tasks.push_back(std::move(task));
+
+    return sampler::m_tasks.size() - 1;
+}
+
+// CONTROL
+void sampler::start()
+{
+    // Verify state.
+    if(sampler::m_running)
+    {
+        throw std::runtime_error("sampler is already running");
+    }
+    if(sampler::m_tasks.empty())
+    {
+        throw std::runtime_error("sampler has no tasks");
+    }
+
+    // Schedule every task's first conversion now.
+    uint64_t now = ads101x::monotonic_ns();
+    for(auto& task : sampler::m_tasks)
+    {
+        task->deadline = now;
+        task->started = 0;
+    }
+    for(auto& device : sampler::m_devices)
+    {
+        device.busy = false;
+    }
+
+    // Start the thread.
+    sampler::m_stop.consume();
+    sampler::m_running = true;
+    sampler::m_thread = std::thread(&sampler::run, this);
+}
+void sampler::stop()
+{
+    // Check if running.
+    if(!sampler::m_running.exchange(false))
+    {
+        return;
+    }
+
+    // Wake and join the thread.
+    sampler::m_stop.signal();
+    sampler::m_thread.join();
+}
+bool sampler::running() const
+{
+    return sampler::m_running;
+}
+
+// METRICS
+uint64_t sampler::samples(uint32_t task) const
+{
+    return sampler::m_tasks.at(task)->samples;
+}
+uint64_t sampler::overruns(uint32_t task) const
+{
+    return sampler::m_tasks.at(task)->overruns;
+}
+uint64_t sampler::errors(uint32_t task) const
+{
+    return sampler::m_tasks.at(task)->errors;
+}
+uint64_t sampler::max_latency(uint32_t task) const
+{
+    return sampler::m_tasks.at(task)->max_latency;
+}
+
+// THREAD
+void sampler::run()
+{
+    pollfd descriptors[2] = {{sampler::m_timer, POLLIN, 0}, {sampler::m_stop.descriptor(), POLLIN, 0}};
+    while(sampler::m_running.load(std::memory_order_relaxed))
+    {
+        // Complete finished conversions first, which frees their devices for the conversions that are due.
+        uint64_t now = ads101x::monotonic_ns();
+        sampler::complete(now);
+        sampler::begin(now);
+
+        // Arm the timer at the next absolute deadline, so scheduling does not drift with wake-up latency.
+        uint64_t wake = sampler::next_wake();
+        itimerspec time;
+        std::memset(&time, 0, sizeof(time));
+        time.it_value.tv_sec = wake / 1000000000ULL;
+        time.it_value.tv_nsec = wake % 1000000000ULL;
+        timerfd_settime(sampler::m_timer, TFD_TIMER_ABSTIME, &time, nullptr);
+
+        // Sleep until the timer expires or the sampler stops.
+        if(poll(descriptors, 2, -1) < 0)
+        {
+            continue;
+        }
+        if(descriptors[0].revents & POLLIN)
+        {
+            uint64_t expirations;
+            ssize_t result = read(sampler::m_timer, &expirations, sizeof(expirations));
+            (void)result;
+        }
+    }
+}
+void sampler::complete(uint64_t now)
+{
+    for(auto& task : sampler::m_tasks)
+    {
+        // Check if the task's conversion is due.
+        if(task->started == 0 || now < task->started + task->conversion)
+        {
+            continue;
+        }
+        sampler::device& device = sampler::m_devices[task->device];
+
+        // Read the conversion, and free the device.
+        uint16_t conversion;
+        bool read = true;
+        try
+        {
+            conversion = device.driver->read_conversion();
+        }
+        catch(...)
+        {
+            task->errors++;
+            read = false;
+        }
+        device.busy = false;
+
+        // Deliver the sample, timestamped with the conversion start.
+        if(read)
+        {
+            ads101x::sample sample(conversion, task->configuration.get_fsr());
+            sample.channel = task->configuration.get_multiplexer();
+            sample.timestamp = task->started;
+            sample.sequence = task->samples;
+            task->callback(sample);
+            task->samples++;
+        }
+        task->started = 0;
+    }
+}
+void sampler::begin(uint64_t now)
+{
+    // Pick the due task with the earliest deadline for each idle device.
+    for(uint32_t device = 0; device < sampler::m_devices.size(); ++device)
+    {
+        if(sampler::m_devices[device].busy)
+        {
+            continue;
+        }
+        sampler::task* next = nullptr;
+        for(auto& task : sampler::m_tasks)
+        {
+            if(task->device == device && task->started == 0 && task->deadline <= now && (!next || task->deadline < next->deadline))
+            {
+                next = task.get();
+            }
+        }
+        if(!next)
+        {
+            continue;
+        }
+
+        // Skip the periods that have already passed, keeping the schedule on its grid.
+        uint64_t latency = now - next->deadline;
+        if(latency >= next->period)
+        {
+            uint64_t missed = latency / next->period;
+            next->overruns += missed;
+            next->deadline += missed * next->period;
+            latency -= missed * next->period;
+        }
+        if(latency > next->max_latency.load(std::memory_order_relaxed))
+        {
+            next->max_latency.store(latency, std::memory_order_relaxed);
+        }
+        next->deadline += next->period;
+
+        // Start the conversion.
+        try
+        {
+            sampler::m_devices[device].driver->write_config(next->configuration);
+        }
+        catch(...)
+        {
+            next->errors++;
+            continue;
+        }
+        next->started = ads101x::monotonic_ns();
+        sampler::m_devices[device].busy = true;
+    }
+}
+uint64_t sampler::next_wake() const
+{
+    uint64_t wake = UINT64_MAX;
+    for(auto& task : sampler::m_tasks)
+    {
+        if(task->started != 0)
+        {
+            // Wake to read the conversion in progress.
+            wake = std::min(wake, task->started + task->conversion);
+        }
+        else if(!sampler::m_devices[task->device].busy)
+        {
+            // Wake to start the next conversion. Tasks waiting on a busy device are started once it is read.
+            wake = std::min(wake, task->deadline);
+        }
+    }
+    return wake;
+}
@@ -0,0 +1,409 @@
+#include <ads101x/serialized_driver.hpp>
+
+// ads101x
+#include <ads101x/clock.hpp>
+
+// std
+#include <algorithm>
+
+using namespace ads101x;
+
+// CACHE
+/// \brief Flags a cached register value as valid.
+#define CACHE_VALID 0x10000
+
+// CONSTRUCTORS
+serialized_driver::serialized_driver(ads101x::driver& driver)
+    : m_driver(driver),
+      m_head{nullptr, nullptr},
+      m_owned(false),
+      m_completions(0),
+      m_cache{0, 0, 0},
+      m_coalesced_reads(0),
+      m_preemptions(0),
+      m_preemption_interval(0)
+{}
+
+// CONFIGURATION
+void serialized_driver::write_config(const ads101x::configuration& configuration, serialized_driver::priority priority)
+{
+    serialized_driver::operation operation;
+    operation.kind = serialized_driver::kind::WRITE;
+    operation.priority = priority;
+    operation.address = ads101x::register_address::CONFIG;
+    operation.value = configuration.bitfield();
+    serialized_driver::submit(operation);
+}
+ads101x::configuration serialized_driver::read_config(serialized_driver::priority priority)
+{
+    serialized_driver::operation operation;
+    operation.kind = serialized_driver::kind::READ;
+    operation.priority = priority;
+    operation.address = ads101x::register_address::CONFIG;
+    serialized_driver::submit(operation);
+    return ads101x::configuration(operation.value);
+}
+
+// CONVERSION
+uint16_t serialized_driver::read_conversion(serialized_driver::priority priority)
+{
+    serialized_driver::operation operation;
+    operation.kind = serialized_driver::kind::READ;
+    operation.priority = priority;
+    operation.address = ads101x::register_address::CONVERSION;
+    serialized_driver::submit(operation);
+    return operation.value;
+}
+void serialized_driver::read_conversions(std::span<uint16_t> conversions, serialized_driver::priority priority)
+{
+    // Split LOW blocks at the preemption interval, so queued HIGH operations run between the chunks.
+    size_t chunk = conversions.size();
+    uint32_t interval = serialized_driver::m_preemption_interval.load(std::memory_order_relaxed);
+    if(priority == serialized_driver::priority::LOW && interval != 0)
+    {
+        chunk = std::min<size_t>(chunk, interval);
+    }
+
+    // Read each chunk as a block operation.
+    for(size_t offset = 0; offset < conversions.size(); offset += chunk)
+    {
+        serialized_driver::operation operation;
+        operation.kind = serialized_driver::kind::BLOCK;
+        operation.priority = priority;
+        operation.address = ads101x::register_address::CONVERSION;
+        operation.block = conversions.subspan(offset, std::min(chunk, conversions.size() - offset));
+        serialized_driver::submit(operation);
+    }
+}
+
+// THRESHOLDS
+void serialized_driver::write_lo_thresh(uint16_t value, serialized_driver::priority priority)
+{
+    serialized_driver::operation operation;
+    operation.kind = serialized_driver::kind::WRITE;
+    operation.priority = priority;
+    operation.address = ads101x::register_address::LO_THRESH;
+    operation.value = value;
+    serialized_driver::submit(operation);
+}
+uint16_t serialized_driver::read_lo_thresh(serialized_driver::priority priority)
+{
+    serialized_driver::operation operation;
+    operation.kind = serialized_driver::kind::READ;
+    operation.priority = priority;
+    operation.address = ads101x::register_address::LO_THRESH;
+    serialized_driver::submit(operation);
+    return operation.value;
+}
+void serialized_driver::write_hi_thresh(uint16_t value, serialized_driver::priority priority)
+{
+    serialized_driver::operation operation;
+    operation.kind = serialized_driver::kind::WRITE;
+    operation.priority = priority;
+    operation.address = ads101x::register_address::HI_THRESH;
+    operation.value = value;
+    serialized_driver::submit(operation);
+}
+uint16_t serialized_driver::read_hi_thresh(serialized_driver::priority priority)
+{
+    serialized_driver::operation operation;
+    operation.kind = serialized_driver::kind::READ;
+    operation.priority = priority;
+    operation.address = ads101x::register_address::HI_THRESH;
+    serialized_driver::submit(operation);
+    return operation.value;
+}
+
+// SEQUENCES
+void serialized_driver::execute(const std::function<void(ads101x::driver&)>& sequence, serialized_driver::priority priority)
+{
+    serialized_driver::operation operation;
+    operation.kind = serialized_driver::kind::SEQUENCE;
+    operation.priority = priority;
+    operation.address = ads101x::register_address::CONVERSION;
+    operation.sequence = &sequence;
+    serialized_driver::submit(operation);
+}
+
+// CACHE
+bool serialized_driver::cached_config(ads101x::configuration& configuration) const
+{
+    uint32_t cached = serialized_driver::m_cache[0].load(std::memory_order_acquire);
+    if(!(cached & CACHE_VALID))
+    {
+        return false;
+    }
+    configuration = ads101x::configuration(static_cast<uint16_t>(cached));
+    return true;
+}
+bool serialized_driver::cached_lo_thresh(uint16_t& value) const
+{
+    uint32_t cached = serialized_driver::m_cache[1].load(std::memory_order_acquire);
+    value = static_cast<uint16_t>(cached);
+    return cached & CACHE_VALID;
+}
+bool serialized_driver::cached_hi_thresh(uint16_t& value) const
+{
+    uint32_t cached = serialized_driver::m_cache[2].load(std::memory_order_acquire);
+    value = static_cast<uint16_t>(cached);
+    return cached & CACHE_VALID;
+}
+void serialized_driver::invalidate_cache()
+{
+    for(auto& cached : serialized_driver::m_cache)
+    {
+        cached.store(0, std::memory_order_release);
+    }
+}
+void serialized_driver::cache(ads101x::register_address address, uint16_t value)
+{
+    // The conversion register is not cached.
+    if(address != ads101x::register_address::CONVERSION)
+    {
+        serialized_driver::m_cache[static_cast<uint8_t>(address) - 1].store(value | CACHE_VALID, std::memory_order_release);
+    }
+}
+
+// PREEMPTION
+void serialized_driver::set_preemption_interval(uint32_t values)
+{
+    serialized_driver::m_preemption_interval.store(values, std::memory_order_relaxed);
+}
+
+// METRICS
+uint64_t serialized_driver::coalesced_reads() const
+{
+    return serialized_driver::m_coalesced_reads.load(std::memory_order_relaxed);
+}
+uint64_t serialized_driver::preemptions() const
+{
+    return serialized_driver::m_preemptions.load(std::memory_order_relaxed);
+}
+const ads101x::histogram& serialized_driver::latency(serialized_driver::priority priority) const
+{
+    return serialized_driver::m_latency[static_cast<uint8_t>(priority)];
+}
+
+// QUEUE
+void serialized_driver::submit(serialized_driver::operation& operation)
+{
+    // Push the operation onto the submission stack of its priority class.
+    std::atomic<serialized_driver::operation*>& head = serialized_driver::m_head[static_cast<uint8_t>(operation.priority)];
+    operation.submitted = ads101x::monotonic_ns();
+    operation.done.store(false, std::memory_order_relaxed);
+    operation.next = head.load(std::memory_order_relaxed);
+    while(!head.compare_exchange_weak(operation.next, &operation))
+    {}
+
+    // Wait for the operation to complete, taking ownership of the bus whenever it is free.
+    while(!operation.done.load(std::memory_order_acquire))
+    {
+        if(!serialized_driver::m_owned.exchange(true))
+        {
+            // This thread owns the bus. Drain the queue, and keep draining if operations arrived while releasing.
+            do
+            {
+                serialized_driver::drain();
+                serialized_driver::m_owned.store(false);
+            }
+            while((serialized_driver::m_head[0].load() != nullptr || serialized_driver::m_head[1].load() != nullptr) && !serialized_driver::m_owned.exchange(true));
+        }
+        else
+        {
+            // Another thread owns the bus and will execute this operation. Sleep on the driver's completion counter
+            // rather than the operation, which the bus owner must not touch once it has flagged it done.
+            uint32_t completions = serialized_driver::m_completions.load(std::memory_order_acquire);
+            if(!operation.done.load(std::memory_order_acquire))
+            {
+                serialized_driver::m_completions.wait(completions, std::memory_order_acquire);
+            }
+        }
+    }
+
+    // Rethrow any exception raised by the operation.
+    if(operation.exception)
+    {
+        std::rethrow_exception(operation.exception);
+    }
+}
+void serialized_driver::drain()
+{
+    // Track register values read in the current batch so repeated reads share one transaction.
+    bool read_valid[4] = {false, false, false, false};
+    uint16_t read_value[4];
+
+    serialized_driver::operation* low = nullptr;
+    bool preempting = false;
+    while(true)
+    {
+        // Execute every queued HIGH operation first. This is the preemption point between transactions.
+        serialized_driver::operation* high = serialized_driver::take(serialized_driver::priority::HIGH);
+        if(high)
+        {
+            if(preempting)
+            {
+                serialized_driver::m_preemptions.fetch_add(1, std::memory_order_relaxed);
+                preempting = false;
+            }
+            read_valid[0] = read_valid[1] = read_valid[2] = read_valid[3] = false;
+            while(high)
+            {
+                // Read the next link first, since the operation is released as soon as it is flagged done.
+                serialized_driver::operation* operation = high;
+                high = operation->next;
+                serialized_driver::dispatch(*operation, read_valid, read_value);
+            }
+            continue;
+        }
+
+        // Take the queued LOW operations once the previous ones have executed.
+        if(!low)
+        {
+            low = serialized_driver::take(serialized_driver::priority::LOW);
+            if(!low)
+            {
+                return;
+            }
+            read_valid[0] = read_valid[1] = read_valid[2] = read_valid[3] = false;
+        }
+
+        // Execute one LOW operation before checking for HIGH operations again.
+        serialized_driver::operation* operation = low;
+        low = operation->next;
+        serialized_driver::dispatch(*operation, read_valid, read_value);
+        preempting = true;
+    }
+}
+serialized_driver::operation* serialized_driver::take(serialized_driver::priority priority)
+{
+    // Take the whole submission stack at once.
+    serialized_driver::operation* batch = serialized_driver::m_head[static_cast<uint8_t>(priority)].exchange(nullptr, std::memory_order_acquire);
+
+    // Reverse the stack into submission order.
+    serialized_driver::operation* fifo = nullptr;
+    while(batch)
+    {
+        serialized_driver::operation* next = batch->next;
+        batch->next = fifo;
+        fifo = batch;
+        batch = next;
+    }
+    return fifo;
+}
+void serialized_driver::dispatch(serialized_driver::operation& operation, bool (&read_valid)[4], uint16_t (&read_value)[4])
+{
+    uint8_t index = static_cast<uint8_t>(operation.address);
+
+    if(operation.kind == serialized_driver::kind::READ && read_valid[index])
+    {
+        // Serve the read from the value already read in this batch.
+        operation.value = read_value[index];
+        serialized_driver::m_coalesced_reads.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        try
+        {
+            if(operation.kind == serialized_driver::kind::SEQUENCE)
+            {
+                (*operation.sequence)(serialized_driver::m_driver);
+            }
+            else if(operation.kind == serialized_driver::kind::BLOCK)
+            {
+                serialized_driver::m_driver.read_conversions(operation.block);
+            }
+            else
+            {
+                serialized_driver::transact(operation);
+            }
+        }
+        catch(...)
+        {
+            operation.exception = std::current_exception();
+        }
+
+        // Anything other than a successful read invalidates the values read in this batch. A successful block read
+        // only supersedes the conversion value.
+        if(operation.kind == serialized_driver::kind::READ && !operation.exception)
+        {
+            read_valid[index] = true;
+            read_value[index] = operation.value;
+        }
+        else if(operation.kind == serialized_driver::kind::BLOCK && !operation.exception)
+        {
+            read_valid[index] = false;
+        }
+        else
+        {
+            read_valid[0] = read_valid[1] = read_valid[2] = read_valid[3] = false;
+        }
+
+        // A sequence may have changed any register.
+        if(operation.kind == serialized_driver::kind::SEQUENCE)
+        {
+            serialized_driver::invalidate_cache();
+        }
+    }
+
+    // Record the latency of the operation's class.
+    serialized_driver::m_latency[static_cast<uint8_t>(operation.priority)].record(ads101x::monotonic_ns() - operation.submitted);
+
+    // Release the waiting caller. The caller may return and destroy the operation as soon as it is flagged done, so
+    // the wakeup goes through the driver's own completion counter.
+    operation.done.store(true, std::memory_order_release);
+    serialized_driver::m_completions.fetch_add(1, std::memory_order_release);
+    serialized_driver::m_completions.notify_all();
+}
+void serialized_driver::transact(serialized_driver::operation& operation)
+{
+    const ads101x::driver& driver = serialized_driver::m_driver;
+    bool write = (operation.kind == serialized_driver::kind::WRITE);
+
+    switch(operation.address)
+    {
+        case ads101x::register_address::CONVERSION:
+        {
+            operation.value = driver.read_conversion();
+            break;
+        }
+        case ads101x::register_address::CONFIG:
+        {
+            if(write)
+            {
+                driver.write_config(ads101x::configuration(operation.value));
+            }
+            else
+            {
+                operation.value = driver.read_config().bitfield();
+            }
+            break;
+        }
+        case ads101x::register_address::LO_THRESH:
+        {
+            if(write)
+            {
+                driver.write_lo_thresh(operation.value);
+            }
+            else
+            {
+                operation.value = driver.read_lo_thresh();
+            }
+            break;
+        }
+        case ads101x::register_address::HI_THRESH:
+        {
+            if(write)
+            {
+                driver.write_hi_thresh(operation.value);
+            }
+            else
+            {
+                operation.value = driver.read_hi_thresh();
+            }
+            break;
+        }
+    }
+
+    // Update the register cache.
+    serialized_driver::cache(operation.address, operation.value);
+}
@@ -0,0 +1,184 @@
+#include <ads101x/shm/publisher.hpp>
+
+// std
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+// posix
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace ads101x::shm;
+
+// CONSTRUCTORS
+publisher::publisher(const std::string& name, uint32_t block_count, uint32_t block_size)
+    : m_name(name),
+      m_descriptor(-1),
+      m_size(shm::size(block_count, block_size))
+{
+    // Validate parameters.
+    if(block_count == 0 || block_size == 0)
+    {
+        throw std::runtime_error("sample bus must have at least one block of one sample");
+    }
+
+    // Create the bus, replacing a stale bus only if its publisher has exited.
+    int descriptor = publisher::create(name);
+    // Size and map the shared memory object.
+    void* mapping = MAP_FAILED;
+    if(ftruncate(descriptor, static_cast<off_t>(publisher::m_size)) == 0)
+    {
+        mapping = mmap(nullptr, publisher::m_size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    }
+    int error = errno;
+    if(mapping == MAP_FAILED)
+    {
+        shm_unlink(name.c_str());
+        ::close(descriptor);
+        throw std::runtime_error("failed to map sample bus " + name + " (" + std::strerror(error) + ")");
+    }
+
+    // Initialize the layout in place.
+    uint8_t* base = static_cast<uint8_t*>(mapping);
+    publisher::m_header = new(base) shm::header;
+    publisher::m_blocks = new(base + sizeof(shm::header)) shm::block[block_count];
+    publisher::m_samples = reinterpret_cast<ads101x::sample*>(base + sizeof(shm::header) + sizeof(shm::block) * block_count);
+    publisher::m_header->version = shm::version;
+    publisher::m_header->block_count = block_count;
+    publisher::m_header->block_size = block_size;
+    publisher::m_header->published.store(0);
+    publisher::m_header->generation.store(0);
+    publisher::m_header->waiters.store(0);
+    publisher::m_header->closed.store(0);
+    for(uint32_t i = 0; i < block_count; ++i)
+    {
+        publisher::m_blocks[i].sequence.store(0);
+        publisher::m_blocks[i].count.store(0);
+    }
+
+    // Mark the bus valid last.
+    std::atomic_thread_fence(std::memory_order_release);
+    publisher::m_header->magic = shm::magic;
+    publisher::m_descriptor = descriptor;
+}
+publisher::~publisher()
+{
+    // Wake readers, then remove the bus while still owning it. Mapped readers keep their mapping until they unmap it.
+    publisher::close();
+    munmap(publisher::m_header, publisher::m_size);
+    shm_unlink(publisher::m_name.c_str());
+    ::close(publisher::m_descriptor);
+}
+int publisher::create(const std::string& name)
+{
+    while(true)
+    {
+        // Try to create a new bus, and take ownership of it.
+        int descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+        if(descriptor >= 0)
+        {
+            // Retry if a publisher reclaiming a stale bus of the same name locked or removed it first.
+            struct stat status;
+            if(flock(descriptor, LOCK_EX | LOCK_NB) != 0 || fstat(descriptor, &status) != 0 || status.st_nlink == 0)
+            {
+                ::close(descriptor);
+                continue;
+            }
+            return descriptor;
+        }
+        if(errno != EEXIST)
+        {
+            throw std::runtime_error("failed to create sample bus " + name + " (" + std::strerror(errno) + ")");
+        }
+
+        // Open the existing bus. Its publisher holds the ownership lock for as long as it runs.
+        descriptor = shm_open(name.c_str(), O_RDWR, 0);
+        if(descriptor < 0)
+        {
+            if(errno == ENOENT)
+            {
+                continue;
+            }
+            throw std::runtime_error("failed to open existing sample bus " + name + " (" + std::strerror(errno) + ")");
+        }
+        if(flock(descriptor, LOCK_EX | LOCK_NB) != 0)
+        {
+            int error = errno;
+            ::close(descriptor);
+            if(error == EWOULDBLOCK)
+            {
+                throw std::runtime_error("sample bus " + name + " is owned by a running publisher");
+            }
+            throw std::runtime_error("failed to lock sample bus " + name + " (" + std::strerror(error) + ")");
+        }
+
+        // Remove the stale bus unless another publisher already did, then retry.
+        struct stat status;
+        if(fstat(descriptor, &status) == 0 && status.st_nlink > 0)
+        {
+            shm_unlink(name.c_str());
+        }
+        ::close(descriptor);
+    }
+}
+
+// PUBLISHING
+void publisher::publish(std::span<const ads101x::sample> samples)
+{
+    uint32_t block_count = publisher::m_header->block_count;
+    uint32_t block_size = publisher::m_header->block_size;
+    while(!samples.empty())
+    {
+        // Mark the next block as being written.
+        uint64_t index = publisher::m_header->published.load(std::memory_order_relaxed);
+        uint32_t slot = index % block_count;
+        shm::block& block = publisher::m_blocks[slot];
+        block.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        // Copy the samples.
+        uint32_t count = std::min<size_t>(samples.size(), block_size);
+        std::memcpy(publisher::m_samples + static_cast<size_t>(slot) * block_size, samples.data(), count * sizeof(ads101x::sample));
+        block.count.store(count, std::memory_order_relaxed);
+
+        // Publish the block.
+        block.sequence.store(2 * index + 2, std::memory_order_release);
+        publisher::m_header->published.store(index + 1, std::memory_order_release);
+        samples = samples.subspan(count);
+    }
+
+    // Only enter the kernel if a reader is waiting.
+    publisher::m_header->generation.fetch_add(1);
+    if(publisher::m_header->waiters.load() > 0)
+    {
+        syscall(SYS_futex, &publisher::m_header->generation, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+}
+void publisher::attach(ads101x::acquisition& acquisition)
+{
+    acquisition.add_sink([this](std::span<const ads101x::sample> block) { publisher::publish(block); });
+}
+void publisher::close()
+{
+    publisher::m_header->closed.store(1);
+    publisher::m_header->generation.fetch_add(1);
+    syscall(SYS_futex, &publisher::m_header->generation, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+// PROPERTIES
+const std::string& publisher::name() const
+{
+    return publisher::m_name;
+}
+uint64_t publisher::published() const
+{
+    return publisher::m_header->published.load();
+}
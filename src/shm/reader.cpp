@@ -0,0 +1,150 @@
+#include <ads101x/shm/reader.hpp>
+
+// std
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// posix
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace ads101x::shm;
+
+// CONSTRUCTORS
+reader::reader(const std::string& name)
+    : m_overruns(0)
+{
+    // Open the shared memory object. It is mapped writable only to register as a waiter.
+    int descriptor = shm_open(name.c_str(), O_RDWR, 0);
+    if(descriptor < 0)
+    {
+        throw std::runtime_error("failed to open sample bus " + name + " (" + std::strerror(errno) + ")");
+    }
+    struct stat status;
+    if(fstat(descriptor, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(shm::header))
+    {
+        ::close(descriptor);
+        throw std::runtime_error("sample bus " + name + " is not initialized");
+    }
+    reader::m_size = status.st_size;
+    void* mapping = mmap(nullptr, reader::m_size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if(mapping == MAP_FAILED)
+    {
+        throw std::runtime_error("failed to map sample bus " + name + " (" + std::strerror(errno) + ")");
+    }
+
+    // Validate the layout.
+    uint8_t* base = static_cast<uint8_t*>(mapping);
+    reader::m_header = reinterpret_cast<shm::header*>(base);
+    uint32_t magic = reader::m_header->magic;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(magic != shm::magic || reader::m_header->version != shm::version || reader::m_size != shm::size(reader::m_header->block_count, reader::m_header->block_size))
+    {
+        munmap(mapping, reader::m_size);
+        throw std::runtime_error("sample bus " + name + " has an incompatible layout");
+    }
+    reader::m_blocks = reinterpret_cast<shm::block*>(base + sizeof(shm::header));
+    reader::m_samples = reinterpret_cast<const ads101x::sample*>(base + sizeof(shm::header) + sizeof(shm::block) * reader::m_header->block_count);
+
+    // Start at the next published block.
+    reader::m_cursor = reader::m_header->published.load(std::memory_order_acquire);
+}
+reader::~reader()
+{
+    munmap(reader::m_header, reader::m_size);
+}
+
+// READING
+uint32_t reader::read(std::span<ads101x::sample> buffer)
+{
+    uint32_t block_count = reader::m_header->block_count;
+    uint32_t block_size = reader::m_header->block_size;
+    if(buffer.size() < block_size)
+    {
+        throw std::runtime_error("sample bus read buffer is smaller than the block size");
+    }
+
+    // Skip blocks that have already been overwritten.
+    uint64_t published = reader::m_header->published.load(std::memory_order_acquire);
+    if(published - reader::m_cursor > block_count)
+    {
+        reader::m_overruns += published - block_count - reader::m_cursor;
+        reader::m_cursor = published - block_count;
+    }
+
+    while(reader::m_cursor < published)
+    {
+        uint32_t slot = reader::m_cursor % block_count;
+        shm::block& block = reader::m_blocks[slot];
+
+        // Check that the block still holds the expected publish index.
+        uint64_t sequence = block.sequence.load(std::memory_order_acquire);
+        if(sequence != 2 * reader::m_cursor + 2)
+        {
+            reader::m_overruns++;
+            reader::m_cursor++;
+            continue;
+        }
+
+        // Copy the block, then verify it was not overwritten during the copy.
+        uint32_t count = std::min(block.count.load(std::memory_order_relaxed), block_size);
+        std::memcpy(buffer.data(), reader::m_samples + static_cast<size_t>(slot) * block_size, count * sizeof(ads101x::sample));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        reader::m_cursor++;
+        if(block.sequence.load(std::memory_order_relaxed) != sequence)
+        {
+            reader::m_overruns++;
+            continue;
+        }
+
+        return count;
+    }
+
+    return 0;
+}
+bool reader::wait(std::chrono::nanoseconds timeout)
+{
+    // Check without entering the kernel first.
+    if(reader::lag() > 0 || reader::closed())
+    {
+        return reader::lag() > 0;
+    }
+
+    // Register as a waiter, then recheck before sleeping so a publish in between is not missed.
+    reader::m_header->waiters.fetch_add(1);
+    uint32_t generation = reader::m_header->generation.load();
+    if(reader::lag() == 0 && !reader::closed())
+    {
+        struct timespec duration;
+        duration.tv_sec = timeout.count() / 1000000000;
+        duration.tv_nsec = timeout.count() % 1000000000;
+        syscall(SYS_futex, &reader::m_header->generation, FUTEX_WAIT, generation, &duration, nullptr, 0);
+    }
+    reader::m_header->waiters.fetch_sub(1);
+
+    return reader::lag() > 0;
+}
+
+// PROPERTIES
+uint32_t reader::block_size() const
+{
+    return reader::m_header->block_size;
+}
+uint64_t reader::lag() const
+{
+    return reader::m_header->published.load(std::memory_order_acquire) - reader::m_cursor;
+}
+uint64_t reader::overruns() const
+{
+    return reader::m_overruns;
+}
+bool reader::closed() const
+{
+    return reader::m_header->closed.load() != 0;
+}
@@ -0,0 +1,451 @@
+#include <ads101x/simulator/driver.hpp>
+
+// ads101x
+#include <ads101x/clock.hpp>
+#include <ads101x/sample.hpp>
+#include <ads101x/variant.hpp>
+
+// std
+#include <cmath>
+
+using namespace ads101x::simulator;
+
+/// \brief The register layout and timing of the simulated device.
+typedef ads101x::traits<ads101x::variant::ADS1015> device_traits;
+
+// CONSTRUCTORS
+driver::driver()
+    : m_running(false),
+      m_registers{0x0000, 0x0583, 0x8000, 0x7FF0},
+      m_converting(false),
+      m_inputs{0, 0, 0, 0, 0, 0, 0, 0},
+      m_asserted(false),
+      m_queue_count(0),
+      m_interrupt_pin(-1),
+      m_alert_rdy_level(true),
+      m_watchdog(0),
+      m_latency(0),
+      m_transactions(0),
+      m_conversions(0)
+{}
+driver::~driver()
+{
+    // Stop the model thread if necessary.
+    driver::close_i2c();
+}
+
+// INPUTS
+void driver::set_input(ads101x::configuration::multiplexer multiplexer, double voltage)
+{
+    std::lock_guard<std::mutex> lock(driver::m_mutex);
+    driver::m_inputs[static_cast<uint16_t>(multiplexer) >> 12] = voltage;
+    driver::m_signal = nullptr;
+}
+void driver::set_signal(std::function<double(ads101x::configuration::multiplexer, double)> signal)
+{
+    std::lock_guard<std::mutex> lock(driver::m_mutex);
+    driver::m_signal = signal;
+}
+
+// BUS
+void driver::set_latency(std::chrono::nanoseconds latency)
+{
+    std::lock_guard<std::mutex> lock(driver::m_mutex);
+    driver::m_latency = latency;
+}
+uint64_t driver::transactions() const
+{
+    return driver::m_transactions.load();
+}
+uint64_t driver::conversions() const
+{
+    return driver::m_conversions.load();
+}
+void driver::delay() const
+{
+    // Count the transaction and apply any latency outside of the model lock.
+    driver::m_transactions++;
+    std::chrono::nanoseconds latency;
+    {
+        std::lock_guard<std::mutex> lock(driver::m_mutex);
+        latency = driver::m_latency;
+    }
+    if(latency.count() <= 0)
+    {
+        return;
+    }
+
+    // Abandon a transaction that would outlast its deadline once the deadline passes, as a backend waiting on a stuck
+    // bus would.
+    uint64_t deadline = driver::operation_deadline();
+    if(deadline != 0 && ads101x::monotonic_ns() + latency.count() > deadline)
+    {
+        ads101x::sleep_until_ns(deadline);
+        throw ads101x::timeout_error("simulated transaction exceeded its deadline");
+    }
+    std::this_thread::sleep_for(latency);
+}
+
+// FAULTS
+void driver::reset()
+{
+    // Restore the power-on registers, which power the device down with the comparator disabled.
+    {
+        std::lock_guard<std::mutex> lock(driver::m_mutex);
+        driver::m_registers[0] = 0x0000;
+        driver::m_registers[1] = 0x0583;
+        driver::m_registers[2] = 0x8000;
+        driver::m_registers[3] = 0x7FF0;
+        driver::m_converting = false;
+        driver::m_asserted = false;
+        driver::m_queue_count = 0;
+    }
+
+    // Release ALERT/RDY to its pulled-up level.
+    driver::drive_alert_rdy(true);
+}
+
+// OVERRIDES
+void driver::open_i2c(uint32_t i2c_bus, uint8_t i2c_address)
+{
+    // Start the model thread.
+    std::lock_guard<std::mutex> lock(driver::m_mutex);
+    driver::m_epoch = std::chrono::steady_clock::now();
+    driver::m_running = true;
+    driver::m_thread = std::thread(&driver::run, this);
+}
+void driver::close_i2c()
+{
+    // Check if the model thread is running.
+    {
+        std::lock_guard<std::mutex> lock(driver::m_mutex);
+        if(!driver::m_running)
+        {
+            return;
+        }
+        driver::m_running = false;
+    }
+
+    // Stop the model thread.
+    driver::m_wake.notify_one();
+    driver::m_thread.join();
+}
+void driver::write_register(uint8_t register_address, uint16_t value) const
+{
+    driver::delay();
+
+    driver::activity activity;
+    bool release = false;
+    {
+        std::lock_guard<std::mutex> lock(driver::m_mutex);
+
+        // Complete any conversion that finished before this write.
+        activity = driver::advance(std::chrono::steady_clock::now());
+
+        switch(static_cast<ads101x::register_address>(register_address))
+        {
+            case ads101x::register_address::CONFIG:
+            {
+                // Store configuration. The OS bit only starts conversions and is not stored.
+                driver::m_registers[1] = value & 0x7FFF;
+
+                // Continuous mode restarts conversions, single-shot mode starts one if OS is set.
+                bool continuous = !(value & static_cast<uint16_t>(ads101x::configuration::mode::SINGLESHOT));
+                bool start = value & static_cast<uint16_t>(ads101x::configuration::operation::CONVERT);
+                if(continuous || start)
+                {
+                    driver::m_converting = true;
+                    driver::m_conversion_end = std::chrono::steady_clock::now() + std::chrono::microseconds(device_traits::conversion_period_us(ads101x::configuration(value).get_data_rate()));
+                }
+                else
+                {
+                    driver::m_converting = false;
+                }
+
+                // An enabled comparator drives the pin to its deasserted level for the new polarity.
+                release = !driver::m_asserted && (value & 0x0003) != 0x0003;
+                break;
+            }
+            case ads101x::register_address::LO_THRESH:
+            case ads101x::register_address::HI_THRESH:
+            {
+                driver::m_registers[register_address] = value;
+                break;
+            }
+            default:
+            {
+                // Conversion register is read only.
+                break;
+            }
+        }
+    }
+
+    // Reschedule the model and drive ALERT/RDY outside of the model lock.
+    driver::m_wake.notify_one();
+    driver::drive(activity);
+    if(release)
+    {
+        driver::drive_alert_rdy(driver::idle_level(value));
+    }
+}
+uint16_t driver::read_register(uint8_t register_address) const
+{
+    driver::delay();
+
+    driver::activity activity;
+    bool release = false;
+    uint16_t value;
+    uint16_t config;
+    {
+        std::lock_guard<std::mutex> lock(driver::m_mutex);
+
+        // Complete any conversion that finished before this read.
+        activity = driver::advance(std::chrono::steady_clock::now());
+
+        switch(static_cast<ads101x::register_address>(register_address))
+        {
+            case ads101x::register_address::CONFIG:
+            {
+                // OS reads 1 when no conversion is in progress.
+                value = driver::m_registers[1] | (driver::m_converting ? 0x0000 : 0x8000);
+                break;
+            }
+            case ads101x::register_address::CONVERSION:
+            {
+                value = driver::m_registers[0];
+
+                // Reading the conversion clears a latched comparator.
+                if(driver::m_asserted && (driver::m_registers[1] & static_cast<uint16_t>(ads101x::configuration::comparator_latch::LATCHING)))
+                {
+                    driver::m_asserted = false;
+                    release = true;
+                }
+                break;
+            }
+            default:
+            {
+                value = driver::m_registers[register_address & 0x03];
+                break;
+            }
+        }
+        config = driver::m_registers[1];
+    }
+
+    // Drive ALERT/RDY outside of the model lock.
+    driver::drive(activity);
+    if(release)
+    {
+        driver::drive_alert_rdy(driver::idle_level(config));
+    }
+
+    return value;
+}
+void driver::attach_interrupt(uint16_t pin)
+{
+    std::lock_guard<std::recursive_mutex> lock(driver::m_interrupt_mutex);
+    driver::m_interrupt_pin = pin;
+}
+void driver::detach_interrupt(uint16_t pin)
+{
+    // Waits for any in-flight interrupt to finish.
+    std::lock_guard<std::recursive_mutex> lock(driver::m_interrupt_mutex);
+    driver::m_interrupt_pin = -1;
+}
+void driver::set_watchdog(uint16_t pin, uint32_t timeout_ms)
+{
+    // Store the timeout and start timing, then wake the model thread to apply it.
+    {
+        std::lock_guard<std::mutex> lock(driver::m_mutex);
+        driver::m_watchdog = std::chrono::milliseconds(timeout_ms);
+        driver::m_watchdog_deadline = std::chrono::steady_clock::now() + driver::m_watchdog;
+    }
+    driver::m_wake.notify_one();
+}
+
+// MODEL
+void driver::run()
+{
+    std::unique_lock<std::mutex> lock(driver::m_mutex);
+    while(driver::m_running)
+    {
+        // Wait for a conversion or the watchdog to be scheduled.
+        bool watching = driver::m_watchdog.count() > 0;
+        if(!driver::m_converting && !watching)
+        {
+            driver::m_wake.wait(lock);
+            continue;
+        }
+
+        // Wait for the conversion to complete or the watchdog to expire, or for the schedule to change.
+        auto wake = driver::m_converting ? driver::m_conversion_end : driver::m_watchdog_deadline;
+        if(watching && driver::m_watchdog_deadline < wake)
+        {
+            wake = driver::m_watchdog_deadline;
+        }
+        if(driver::m_wake.wait_until(lock, wake) != std::cv_status::timeout)
+        {
+            continue;
+        }
+
+        // Complete the conversion and drive ALERT/RDY outside of the model lock.
+        auto now = std::chrono::steady_clock::now();
+        driver::activity activity = driver::advance(now);
+        lock.unlock();
+        driver::drive(activity);
+        lock.lock();
+
+        // Raise a stall if no edge restarted the watchdog, and restart it.
+        if(driver::m_watchdog.count() > 0 && now >= driver::m_watchdog_deadline)
+        {
+            driver::m_watchdog_deadline = now + driver::m_watchdog;
+            lock.unlock();
+            driver::drive_stall();
+            lock.lock();
+        }
+    }
+}
+driver::activity driver::advance(std::chrono::steady_clock::time_point now) const
+{
+    driver::activity activity = {false, false, true, driver::m_registers[1]};
+
+    // Check if a conversion is due.
+    if(!driver::m_converting || now < driver::m_conversion_end)
+    {
+        return activity;
+    }
+
+    // Complete the conversion.
+    auto end = driver::m_conversion_end;
+    activity.completed = true;
+    activity.level = driver::complete_conversion(end, activity.pulse);
+
+    // Schedule the next conversion.
+    if(activity.config & static_cast<uint16_t>(ads101x::configuration::mode::SINGLESHOT))
+    {
+        driver::m_converting = false;
+    }
+    else
+    {
+        auto period = std::chrono::microseconds(device_traits::conversion_period_us(ads101x::configuration(activity.config).get_data_rate()));
+        driver::m_conversion_end = end + period;
+        if(driver::m_conversion_end <= now)
+        {
+            // The model fell behind. Skip the missed conversions as the device would have overwritten them.
+            driver::m_conversion_end = now + period;
+        }
+    }
+
+    return activity;
+}
+bool driver::complete_conversion(std::chrono::steady_clock::time_point time, bool& pulse) const
+{
+    ads101x::configuration config(driver::m_registers[1]);
+
+    // Sample the input.
+    double voltage;
+    if(driver::m_signal)
+    {
+        voltage = driver::m_signal(config.get_multiplexer(), std::chrono::duration<double>(time - driver::m_epoch).count());
+    }
+    else
+    {
+        voltage = driver::m_inputs[static_cast<uint16_t>(config.get_multiplexer()) >> 12];
+    }
+
+    // Quantize into the conversion register.
+    double scaled = std::round(voltage / ads101x::fsr_voltage(config.get_fsr()) * 2048.0);
+    int32_t code = static_cast<int32_t>(std::fmax(device_traits::min_code, std::fmin(device_traits::max_code, scaled)));
+    driver::m_registers[0] = device_traits::encode(static_cast<uint16_t>(code));
+    driver::m_conversions++;
+
+    // A disabled comparator leaves ALERT/RDY in high impedance, where it is pulled up.
+    if(config.get_comparator_queue() == ads101x::configuration::comparator_queue::DISABLED)
+    {
+        driver::m_asserted = false;
+        driver::m_queue_count = 0;
+        return true;
+    }
+
+    // Conversion-ready mode is selected by the MSB of HI_THRESH set and the MSB of LO_THRESH clear.
+    int32_t hi = device_traits::decode(driver::m_registers[3]);
+    int32_t lo = device_traits::decode(driver::m_registers[2]);
+    if(hi < 0 && lo >= 0)
+    {
+        pulse = true;
+        return driver::idle_level(config.bitfield());
+    }
+
+    // Evaluate the comparator.
+    bool window = config.get_comparator_mode() == ads101x::configuration::comparator_mode::WINDOW;
+    bool exceeded = (code > hi) || (window && code < lo);
+    if(exceeded)
+    {
+        static const uint32_t queue_lengths[3] = {1, 2, 4};
+        if(++driver::m_queue_count >= queue_lengths[static_cast<uint16_t>(config.get_comparator_queue())])
+        {
+            driver::m_asserted = true;
+        }
+    }
+    else
+    {
+        driver::m_queue_count = 0;
+        bool latching = config.get_comparator_latch() == ads101x::configuration::comparator_latch::LATCHING;
+        bool released = window || code < lo;
+        if(!latching && released)
+        {
+            driver::m_asserted = false;
+        }
+    }
+
+    return driver::m_asserted ? !driver::idle_level(config.bitfield()) : driver::idle_level(config.bitfield());
+}
+bool driver::idle_level(uint16_t config)
+{
+    // The deasserted level is the inverse of the comparator polarity.
+    return !(config & static_cast<uint16_t>(ads101x::configuration::comparator_polarity::ACTIVE_HIGH));
+}
+void driver::drive(const driver::activity& activity) const
+{
+    if(!activity.completed)
+    {
+        return;
+    }
+    if(activity.pulse)
+    {
+        driver::drive_alert_rdy(!driver::idle_level(activity.config));
+    }
+    driver::drive_alert_rdy(activity.level);
+}
+void driver::drive_alert_rdy(bool level) const
+{
+    std::lock_guard<std::recursive_mutex> lock(driver::m_interrupt_mutex);
+
+    // Only raise edges.
+    if(level == driver::m_alert_rdy_level)
+    {
+        return;
+    }
+    driver::m_alert_rdy_level = level;
+
+    // Restart the watchdog.
+    {
+        std::lock_guard<std::mutex> lock(driver::m_mutex);
+        driver::m_watchdog_deadline = std::chrono::steady_clock::now() + driver::m_watchdog;
+    }
+
+    // Raise the interrupt if attached.
+    if(driver::m_interrupt_pin >= 0)
+    {
+        const_cast<driver*>(this)->raise_interrupt(static_cast<uint16_t>(driver::m_interrupt_pin), level);
+    }
+}
+void driver::drive_stall() const
+{
+    std::lock_guard<std::recursive_mutex> lock(driver::m_interrupt_mutex);
+
+    // Raise the stall if attached.
+    if(driver::m_interrupt_pin >= 0)
+    {
+        const_cast<driver*>(this)->raise_stall(static_cast<uint16_t>(driver::m_interrupt_pin));
+    }
+}
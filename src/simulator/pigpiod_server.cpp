@@ -0,0 +1,597 @@
+#include <ads101x/simulator/pigpiod_server.hpp>
+
+// std
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+// posix
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace ads101x::simulator;
+
+/// \brief The pigpio error for an unknown GPIO.
+constexpr int32_t bad_gpio = -3;
+/// \brief The pigpio error for an unknown handle.
+constexpr int32_t bad_handle = -25;
+/// \brief The pigpio error for a failed I2C write.
+constexpr int32_t i2c_write_failed = -82;
+/// \brief The pigpio error for a failed I2C read.
+constexpr int32_t i2c_read_failed = -83;
+/// \brief The pigpio error for an unknown command.
+constexpr int32_t unknown_command = -123;
+
+/// \brief The zip operations.
+enum zip_operation : uint8_t
+{
+    ZIP_END = 0,
+    ZIP_ESC = 1,
+    ZIP_START = 2,
+    ZIP_STOP = 3,
+    ZIP_ADDR = 4,
+    ZIP_FLAGS = 5,
+    ZIP_READ = 6,
+    ZIP_WRITE = 7
+};
+
+/// \brief The notification report flag for a watchdog timeout, combined with the GPIO.
+constexpr uint16_t notify_watchdog = 1 << 5;
+
+/// \brief The largest command extension accepted.
+constexpr uint32_t max_extension = 65536;
+
+// CONSTRUCTORS
+pigpiod_server::pigpiod_server(ads101x::simulator::driver& driver, uint32_t i2c_bus, uint8_t i2c_address, uint16_t alert_rdy_pin, uint16_t port)
+    : m_driver(driver),
+      m_i2c_bus(i2c_bus),
+      m_i2c_address(i2c_address),
+      m_alert_rdy_pin(alert_rdy_pin),
+      m_alert_rdy_level(true),
+      m_epoch(std::chrono::steady_clock::now()),
+      m_listener(-1),
+      m_port(0),
+      m_wake(-1),
+      m_stopping(false),
+      m_dropping(false),
+      m_client_count(0)
+{
+    // Validate the pin, which must fit the report's level bitmask.
+    if(alert_rdy_pin > 31)
+    {
+        throw std::runtime_error("invalid pigpiod alert_rdy pin: " + std::to_string(alert_rdy_pin));
+    }
+
+    // Clear latencies and metrics.
+    for(uint32_t i = 0; i < pigpiod_server::command_count; ++i)
+    {
+        pigpiod_server::m_latency[i] = std::chrono::nanoseconds(0);
+        pigpiod_server::m_commands[i] = 0;
+    }
+
+    // Create a listening socket on the loopback interface.
+    pigpiod_server::m_listener = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(pigpiod_server::m_listener < 0)
+    {
+        throw std::runtime_error("failed to create pigpiod socket (" + std::string(std::strerror(errno)) + ")");
+    }
+    int32_t reuse = 1;
+    setsockopt(pigpiod_server::m_listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    socklen_t length = sizeof(address);
+    if(bind(pigpiod_server::m_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+       listen(pigpiod_server::m_listener, 16) != 0 ||
+       getsockname(pigpiod_server::m_listener, reinterpret_cast<sockaddr*>(&address), &length) != 0)
+    {
+        int error = errno;
+        ::close(pigpiod_server::m_listener);
+        throw std::runtime_error("failed to listen on port " + std::to_string(port) + " (" + std::strerror(error) + ")");
+    }
+    pigpiod_server::m_port = ntohs(address.sin_port);
+
+    // Create the wake-up event for stop() and drop().
+    pigpiod_server::m_wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(pigpiod_server::m_wake < 0)
+    {
+        ::close(pigpiod_server::m_listener);
+        throw std::runtime_error("failed to create pigpiod wake event");
+    }
+
+    // Report the device's ALERT/RDY edges to the notification streams.
+    pigpiod_server::m_driver.attach_alert_rdy(alert_rdy_pin, [this](bool level)
+    {
+        pigpiod_server::m_alert_rdy_level = level;
+        pigpiod_server::notify(0);
+    });
+}
+pigpiod_server::~pigpiod_server()
+{
+    // Detach first, waiting for any in-flight notification.
+    pigpiod_server::m_driver.detach_alert_rdy();
+    for(auto& client : pigpiod_server::m_clients)
+    {
+        ::close(client.socket);
+    }
+    ::close(pigpiod_server::m_wake);
+    ::close(pigpiod_server::m_listener);
+}
+
+uint16_t pigpiod_server::port() const
+{
+    return pigpiod_server::m_port;
+}
+
+// LATENCY
+void pigpiod_server::set_latency(pigpiod_server::command command, std::chrono::nanoseconds latency)
+{
+    pigpiod_server::m_latency[static_cast<uint32_t>(command)] = latency;
+}
+void pigpiod_server::set_latency(std::chrono::nanoseconds latency)
+{
+    for(auto& command_latency : pigpiod_server::m_latency)
+    {
+        command_latency = latency;
+    }
+}
+
+// CONTROL
+void pigpiod_server::run()
+{
+    std::vector<pollfd> descriptors;
+    while(!pigpiod_server::m_stopping)
+    {
+        // Wait for activity on the listener, the wake event, or any client. Only this thread changes the clients.
+        descriptors.clear();
+        descriptors.push_back({pigpiod_server::m_listener, POLLIN, 0});
+        descriptors.push_back({pigpiod_server::m_wake, POLLIN, 0});
+        for(auto& client : pigpiod_server::m_clients)
+        {
+            descriptors.push_back({client.socket, POLLIN, 0});
+        }
+        if(poll(descriptors.data(), descriptors.size(), -1) < 0)
+        {
+            continue;
+        }
+
+        // Handle wake-ups, dropping every client if requested.
+        if(descriptors[1].revents)
+        {
+            uint64_t count;
+            while(read(pigpiod_server::m_wake, &count, sizeof(count)) > 0)
+            {}
+        }
+        if(pigpiod_server::m_dropping.exchange(false))
+        {
+            std::vector<pigpiod_server::client> dropped;
+            {
+                std::lock_guard<std::mutex> lock(pigpiod_server::m_mutex);
+                dropped.swap(pigpiod_server::m_clients);
+            }
+            for(auto& client : dropped)
+            {
+                pigpiod_server::close_client(client.socket);
+            }
+            continue;
+        }
+
+        // Serve clients, collecting those that disconnected.
+        std::vector<int32_t> disconnected;
+        for(size_t i = 2; i < descriptors.size(); ++i)
+        {
+            if(descriptors[i].revents && !pigpiod_server::receive(pigpiod_server::m_clients[i - 2]))
+            {
+                disconnected.push_back(descriptors[i].fd);
+            }
+        }
+        for(int32_t socket : disconnected)
+        {
+            {
+                std::lock_guard<std::mutex> lock(pigpiod_server::m_mutex);
+                std::erase_if(pigpiod_server::m_clients, [socket](const pigpiod_server::client& client) { return client.socket == socket; });
+            }
+            pigpiod_server::close_client(socket);
+        }
+
+        // Accept new clients last, so the client indices above stayed valid.
+        if(descriptors[0].revents)
+        {
+            pigpiod_server::accept_client();
+        }
+    }
+}
+void pigpiod_server::stop()
+{
+    pigpiod_server::m_stopping = true;
+    uint64_t count = 1;
+    ssize_t result = write(pigpiod_server::m_wake, &count, sizeof(count));
+    (void)result;
+}
+void pigpiod_server::drop()
+{
+    pigpiod_server::m_dropping = true;
+    uint64_t count = 1;
+    ssize_t result = write(pigpiod_server::m_wake, &count, sizeof(count));
+    (void)result;
+}
+
+// METRICS
+uint32_t pigpiod_server::clients() const
+{
+    return pigpiod_server::m_client_count;
+}
+uint64_t pigpiod_server::commands(pigpiod_server::command command) const
+{
+    return pigpiod_server::m_commands[static_cast<uint32_t>(command)];
+}
+
+// CLIENTS
+void pigpiod_server::accept_client()
+{
+    int32_t socket;
+    while((socket = accept4(pigpiod_server::m_listener, nullptr, nullptr, SOCK_CLOEXEC)) >= 0)
+    {
+        // Answer small commands immediately, as pigpiod does.
+        int32_t nodelay = 1;
+        setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+        std::lock_guard<std::mutex> lock(pigpiod_server::m_mutex);
+        pigpiod_server::m_clients.push_back({socket, {}, false, 0, 0});
+        pigpiod_server::m_client_count++;
+    }
+}
+bool pigpiod_server::receive(pigpiod_server::client& client)
+{
+    // Append the available bytes.
+    uint8_t bytes[4096];
+    ssize_t count = recv(client.socket, bytes, sizeof(bytes), MSG_DONTWAIT);
+    if(count == 0 || (count < 0 && errno != EAGAIN && errno != EINTR))
+    {
+        return false;
+    }
+    if(count < 0)
+    {
+        return true;
+    }
+    client.buffer.insert(client.buffer.end(), bytes, bytes + count);
+
+    // Serve each whole command: a header of four words, followed by an extension whose length is the last word.
+    size_t offset = 0;
+    std::vector<uint8_t> reply;
+    while(client.buffer.size() - offset >= sizeof(uint32_t[4]))
+    {
+        uint32_t words[4];
+        std::memcpy(words, client.buffer.data() + offset, sizeof(words));
+        if(words[3] > max_extension)
+        {
+            return false;
+        }
+        if(client.buffer.size() - offset < sizeof(words) + words[3])
+        {
+            break;
+        }
+
+        // Serve the command after its latency.
+        reply.clear();
+        int32_t result = pigpiod_server::serve(client, words, client.buffer.data() + offset + sizeof(words), reply);
+        offset += sizeof(words) + words[3];
+        if(words[0] < pigpiod_server::command_count)
+        {
+            pigpiod_server::m_commands[words[0]]++;
+            if(pigpiod_server::m_latency[words[0]].count() > 0)
+            {
+                std::this_thread::sleep_for(pigpiod_server::m_latency[words[0]]);
+            }
+        }
+
+        // Echo the command with its result, followed by any bytes read.
+        std::memcpy(&words[3], &result, sizeof(result));
+        reply.insert(reply.begin(), reinterpret_cast<uint8_t*>(words), reinterpret_cast<uint8_t*>(words) + sizeof(words));
+        if(send(client.socket, reply.data(), reply.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(reply.size()))
+        {
+            return false;
+        }
+    }
+    client.buffer.erase(client.buffer.begin(), client.buffer.begin() + offset);
+
+    return true;
+}
+void pigpiod_server::close_client(int32_t socket)
+{
+    // Close the handles the client opened.
+    for(auto& handle : pigpiod_server::m_handles)
+    {
+        if(handle.owner == socket)
+        {
+            handle.owner = -1;
+        }
+    }
+
+    ::close(socket);
+    pigpiod_server::m_client_count--;
+}
+
+// COMMANDS
+int32_t pigpiod_server::serve(pigpiod_server::client& client, const uint32_t words[4], const uint8_t* extension, std::vector<uint8_t>& reply)
+{
+    uint32_t p1 = words[1];
+    uint32_t p2 = words[2];
+    uint32_t p3 = words[3];
+    switch(static_cast<pigpiod_server::command>(words[0]))
+    {
+        case pigpiod_server::command::MODES:
+        case pigpiod_server::command::PUD:
+        {
+            // Accept modes and pulls on any GPIO.
+            return (p1 <= 53) ? 0 : bad_gpio;
+        }
+        case pigpiod_server::command::WDOG:
+        {
+            // Watch the ALERT/RDY pin only; other pins never change.
+            if(p1 != pigpiod_server::m_alert_rdy_pin)
+            {
+                return 0;
+            }
+            pigpiod_server::m_driver.set_alert_rdy_watchdog(p2, [this]
+            {
+                pigpiod_server::notify(notify_watchdog | pigpiod_server::m_alert_rdy_pin);
+            });
+            return 0;
+        }
+        case pigpiod_server::command::BR1:
+        {
+            return pigpiod_server::m_alert_rdy_level ? (1 << pigpiod_server::m_alert_rdy_pin) : 0;
+        }
+        case pigpiod_server::command::TICK:
+        {
+            auto elapsed = std::chrono::steady_clock::now() - pigpiod_server::m_epoch;
+            return static_cast<int32_t>(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+        }
+        case pigpiod_server::command::HWVER:
+        {
+            // Report a Raspberry Pi 4 Model B.
+            return 0xC03111;
+        }
+        case pigpiod_server::command::PIGPV:
+        {
+            return 79;
+        }
+        case pigpiod_server::command::NB:
+        case pigpiod_server::command::NC:
+        {
+            // Update the bits of the notification stream, whose handle is its socket.
+            std::lock_guard<std::mutex> lock(pigpiod_server::m_mutex);
+            for(auto& stream : pigpiod_server::m_clients)
+            {
+                if(stream.notify && stream.socket == static_cast<int32_t>(p1))
+                {
+                    stream.bits = (words[0] == static_cast<uint32_t>(pigpiod_server::command::NB)) ? p2 : 0;
+                    return 0;
+                }
+            }
+            return bad_handle;
+        }
+        case pigpiod_server::command::NOIB:
+        {
+            // Turn the connection into a notification stream, which receives no further commands.
+            std::lock_guard<std::mutex> lock(pigpiod_server::m_mutex);
+            client.notify = true;
+            return client.socket;
+        }
+        case pigpiod_server::command::I2CO:
+        {
+            // Reuse a closed handle, or add one.
+            if(p3 < sizeof(uint32_t))
+            {
+                return unknown_command;
+            }
+            pigpiod_server::handle opened = {client.socket, p1, p2, 0};
+            for(size_t i = 0; i < pigpiod_server::m_handles.size(); ++i)
+            {
+                if(pigpiod_server::m_handles[i].owner < 0)
+                {
+                    pigpiod_server::m_handles[i] = opened;
+                    return static_cast<int32_t>(i);
+                }
+            }
+            pigpiod_server::m_handles.push_back(opened);
+            return static_cast<int32_t>(pigpiod_server::m_handles.size() - 1);
+        }
+        case pigpiod_server::command::I2CC:
+        {
+            auto handle = pigpiod_server::find_handle(p1);
+            if(!handle)
+            {
+                return bad_handle;
+            }
+            handle->owner = -1;
+            return 0;
+        }
+        case pigpiod_server::command::I2CRW:
+        {
+            // Read the register, returning the SMBus word whose first byte is the register's most significant byte.
+            auto handle = pigpiod_server::find_handle(p1);
+            if(!handle)
+            {
+                return bad_handle;
+            }
+            if(handle->i2c_bus != pigpiod_server::m_i2c_bus || handle->i2c_address != pigpiod_server::m_i2c_address)
+            {
+                return i2c_read_failed;
+            }
+            try
+            {
+                handle->pointer = static_cast<uint8_t>(p2 & 0x03);
+                uint16_t value = pigpiod_server::m_driver.read_register(handle->pointer);
+                return (value >> 8) | ((value & 0xFF) << 8);
+            }
+            catch(const std::exception&)
+            {
+                return i2c_read_failed;
+            }
+        }
+        case pigpiod_server::command::I2CWW:
+        {
+            // Write the SMBus word, whose first byte is the register's most significant byte.
+            auto handle = pigpiod_server::find_handle(p1);
+            if(!handle)
+            {
+                return bad_handle;
+            }
+            if(p3 < sizeof(uint32_t) || handle->i2c_bus != pigpiod_server::m_i2c_bus || handle->i2c_address != pigpiod_server::m_i2c_address)
+            {
+                return i2c_write_failed;
+            }
+            uint32_t word;
+            std::memcpy(&word, extension, sizeof(word));
+            try
+            {
+                handle->pointer = static_cast<uint8_t>(p2 & 0x03);
+                pigpiod_server::m_driver.write_register(handle->pointer, static_cast<uint16_t>(((word & 0xFF) << 8) | ((word >> 8) & 0xFF)));
+                return 0;
+            }
+            catch(const std::exception&)
+            {
+                return i2c_write_failed;
+            }
+        }
+        case pigpiod_server::command::I2CZ:
+        {
+            auto handle = pigpiod_server::find_handle(p1);
+            if(!handle)
+            {
+                return bad_handle;
+            }
+            return pigpiod_server::zip(*handle, extension, p3, reply);
+        }
+        default:
+        {
+            return unknown_command;
+        }
+    }
+}
+int32_t pigpiod_server::zip(pigpiod_server::handle& handle, const uint8_t* operations, uint32_t length, std::vector<uint8_t>& reply)
+{
+    // Execute operations until the end, addressing the handle's device unless changed.
+    uint32_t i2c_address = handle.i2c_address;
+    uint32_t i = 0;
+    try
+    {
+        while(i < length && operations[i] != ZIP_END)
+        {
+            uint8_t operation = operations[i++];
+            bool addressed = handle.i2c_bus == pigpiod_server::m_i2c_bus && i2c_address == pigpiod_server::m_i2c_address;
+            switch(operation)
+            {
+                case ZIP_START:
+                case ZIP_STOP:
+                {
+                    break;
+                }
+                case ZIP_ADDR:
+                {
+                    if(i + 1 > length)
+                    {
+                        return i2c_write_failed;
+                    }
+                    i2c_address = operations[i++];
+                    break;
+                }
+                case ZIP_FLAGS:
+                {
+                    i += 2;
+                    break;
+                }
+                case ZIP_READ:
+                {
+                    // Read the selected register repeatedly, most significant byte first.
+                    if(i + 1 > length || !addressed)
+                    {
+                        return i2c_read_failed;
+                    }
+                    uint8_t count = operations[i++];
+                    for(uint8_t j = 0; j < count; j += 2)
+                    {
+                        uint16_t value = pigpiod_server::m_driver.read_register(handle.pointer);
+                        reply.push_back(static_cast<uint8_t>(value >> 8));
+                        if(j + 1 < count)
+                        {
+                            reply.push_back(static_cast<uint8_t>(value));
+                        }
+                    }
+                    break;
+                }
+                case ZIP_WRITE:
+                {
+                    // Select the register with the pointer's two bits, and write it if a whole value follows.
+                    if(i + 1 > length || i + 1 + operations[i] > length || !addressed)
+                    {
+                        return i2c_write_failed;
+                    }
+                    uint8_t count = operations[i++];
+                    if(count >= 1)
+                    {
+                        handle.pointer = operations[i] & 0x03;
+                    }
+                    if(count >= 3)
+                    {
+                        pigpiod_server::m_driver.write_register(handle.pointer, static_cast<uint16_t>((operations[i + 1] << 8) | operations[i + 2]));
+                    }
+                    i += count;
+                    break;
+                }
+                default:
+                {
+                    // Escaped counts are not needed for 16-bit registers.
+                    return unknown_command;
+                }
+            }
+        }
+    }
+    catch(const std::exception&)
+    {
+        return i2c_read_failed;
+    }
+
+    return static_cast<int32_t>(reply.size());
+}
+pigpiod_server::handle* pigpiod_server::find_handle(uint32_t number)
+{
+    if(number >= pigpiod_server::m_handles.size() || pigpiod_server::m_handles[number].owner < 0)
+    {
+        return nullptr;
+    }
+    return &pigpiod_server::m_handles[number];
+}
+
+// DEVICE
+void pigpiod_server::notify(uint16_t flags)
+{
+    // Build the report: a sequence, flags, the tick, and the levels of GPIO 0 to 31.
+    auto elapsed = std::chrono::steady_clock::now() - pigpiod_server::m_epoch;
+    uint32_t tick = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    uint32_t level = pigpiod_server::m_alert_rdy_level ? (1u << pigpiod_server::m_alert_rdy_pin) : 0;
+    uint8_t report[12];
+    std::memcpy(report + 2, &flags, sizeof(flags));
+    std::memcpy(report + 4, &tick, sizeof(tick));
+    std::memcpy(report + 8, &level, sizeof(level));
+
+    // Send the report to each stream watching the pin, without blocking the driver.
+    std::lock_guard<std::mutex> lock(pigpiod_server::m_mutex);
+    for(auto& client : pigpiod_server::m_clients)
+    {
+        if(client.notify && (client.bits & (1u << pigpiod_server::m_alert_rdy_pin)))
+        {
+            std::memcpy(report, &client.sequence, sizeof(client.sequence));
+            client.sequence++;
+            send(client.socket, report, sizeof(report), MSG_DONTWAIT | MSG_NOSIGNAL);
+        }
+    }
+}
@@ -0,0 +1,118 @@
+// ads101x
+#include <ads101x/daemon/server.hpp>
+
+// tools
+#include "device.hpp"
+
+// std
+#include <csignal>
+#include <iostream>
+
+/// \brief The server stopped by signal handlers.
+ads101x::daemon::server* running_server = nullptr;
+
+/// \brief Stops the server on SIGINT and SIGTERM.
+void handle_signal(int signal)
+{
+    if(running_server)
+    {
+        running_server->stop();
+    }
+}
+
+/// \brief Prints usage information.
+void print_usage()
+{
+    std::cout << "usage: ads101x_daemon [--socket PATH] [--block-size N] [--rt-priority N] [--rt-cpu N] [--mlock]" << std::endl
+              << "                      --device SPEC [--device SPEC ...]" << std::endl
+              << std::endl
+              << "Serves ADS101X devices to local clients over a Unix domain socket." << std::endl
+              << "Devices are indexed in the order they are given. SPEC is one of:" << std::endl
+              << tools::device_usage
+              << "--rt-priority, --rt-cpu, and --mlock run acquisition threads with SCHED_FIFO, CPU pinning, and locked memory." << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    // Parse arguments.
+    std::string path = ads101x::daemon::default_socket_path;
+    uint32_t block_size = 32;
+    ads101x::realtime_profile profile;
+    std::vector<std::string> specifications;
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        if(argument == "--socket" && i + 1 < argc)
+        {
+            path = argv[++i];
+        }
+        else if(argument == "--block-size" && i + 1 < argc)
+        {
+            block_size = std::stoul(argv[++i]);
+        }
+        else if(argument == "--rt-priority" && i + 1 < argc)
+        {
+            profile.priority = std::stol(argv[++i]);
+            profile.prefault = true;
+        }
+        else if(argument == "--rt-cpu" && i + 1 < argc)
+        {
+            profile.cpu = std::stol(argv[++i]);
+        }
+        else if(argument == "--mlock")
+        {
+            profile.lock_memory = true;
+            profile.prefault = true;
+        }
+        else if(argument == "--device" && i + 1 < argc)
+        {
+            specifications.push_back(argv[++i]);
+        }
+        else
+        {
+            print_usage();
+            return argument == "--help" ? 0 : 1;
+        }
+    }
+    if(specifications.empty())
+    {
+        print_usage();
+        return 1;
+    }
+
+    try
+    {
+        // Create devices.
+        std::vector<tools::device> devices;
+        for(auto& specification : specifications)
+        {
+            devices.push_back(tools::create_device(specification));
+        }
+
+        // Create the server and serve until signalled.
+        {
+            ads101x::daemon::server server(path);
+            server.set_realtime(profile);
+            for(auto& device : devices)
+            {
+                server.add_device(*device.driver, device.alert_rdy_pin, block_size);
+            }
+            running_server = &server;
+            std::signal(SIGINT, handle_signal);
+            std::signal(SIGTERM, handle_signal);
+            std::cout << "serving " << devices.size() << " device(s) on " << path << std::endl;
+            server.run();
+            running_server = nullptr;
+        }
+
+        // Stop devices.
+        tools::release_devices(devices);
+    }
+    catch(const std::exception& error)
+    {
+        std::cerr << "ads101x_daemon: " << error.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,163 @@
+/// \file tools/device.hpp
+/// \brief Creates devices from the command line specifications shared by the ads101x tools.
+#ifndef ADS101X___TOOLS___DEVICE_H
+#define ADS101X___TOOLS___DEVICE_H
+
+// ads101x
+#include <ads101x/chardev/driver.hpp>
+#include <ads101x/replay/driver.hpp>
+#include <ads101x/simulator/driver.hpp>
+#ifdef ADS101X_TOOLS_PIGPIO
+#include <ads101x/pigpio/driver.hpp>
+#endif
+#ifdef ADS101X_TOOLS_PIGPIOD
+#include <ads101x/pigpiod/driver.hpp>
+#endif
+
+// std
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace tools {
+
+/// \brief The device specifications supported by this build, one per line.
+inline const char* device_usage =
+    "  simulator[:ALERT_PIN]\n"
+    "  replay:CAPTURE_FILE[:SPEED[:ALERT_PIN]]   (SPEED 0 plays as fast as possible)\n"
+    "  chardev:BUS:ADDRESS[:ALERT_LINE[:GPIO_CHIP]]   (GPIO_CHIP defaults to /dev/gpiochip0)\n"
+#ifdef ADS101X_TOOLS_PIGPIO
+    "  pigpio:BUS:ADDRESS[:ALERT_PIN[:MODE]]  (MODE is isr for pigpio ISRs, or batched for batched edges)\n"
+#endif
+#ifdef ADS101X_TOOLS_PIGPIOD
+    "  pigpiod:HOST:PORT:BUS:ADDRESS[:ALERT_PIN]\n"
+#endif
+    "ADDRESS is the I2C slave address, for example 0x48.\n";
+
+/// \brief A device created from the command line.
+struct device
+{
+    /// \brief The started driver of the device.
+    std::unique_ptr<ads101x::driver> driver;
+    /// \brief The ALERT/RDY pin, or -1.
+    int32_t alert_rdy_pin;
+};
+
+#ifdef ADS101X_TOOLS_PIGPIO
+/// \brief The pigpio driver that initialized the pigpio library, if any.
+inline ads101x::pigpio::driver* pigpio_owner = nullptr;
+#endif
+
+/// \brief Splits a device specification into its fields.
+inline std::vector<std::string> split(const std::string& specification)
+{
+    std::vector<std::string> fields;
+    std::stringstream stream(specification);
+    std::string field;
+    while(std::getline(stream, field, ':'))
+    {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+/// \brief Creates and starts a device from its specification.
+/// \exception std::runtime_error if the specification is invalid or the device fails to start.
+inline tools::device create_device(const std::string& specification)
+{
+    std::vector<std::string> fields = tools::split(specification);
+    if(fields.empty())
+    {
+        throw std::runtime_error("empty device specification");
+    }
+
+    tools::device result = {nullptr, -1};
+    if(fields[0] == "simulator" && fields.size() <= 2)
+    {
+        result.driver = std::make_unique<ads101x::simulator::driver>();
+        result.driver->start();
+        result.alert_rdy_pin = fields.size() == 2 ? std::stol(fields[1]) : -1;
+        return result;
+    }
+    if(fields[0] == "replay" && fields.size() >= 2 && fields.size() <= 4)
+    {
+        ads101x::replay::capture capture;
+        capture.load(fields[1]);
+        auto driver = std::make_unique<ads101x::replay::driver>(capture);
+        driver->set_speed(fields.size() >= 3 ? std::stod(fields[2]) : 1.0);
+        driver->start();
+        result.alert_rdy_pin = fields.size() == 4 ? std::stol(fields[3]) : -1;
+        result.driver = std::move(driver);
+        return result;
+    }
+    if(fields[0] == "chardev" && fields.size() >= 3 && fields.size() <= 5)
+    {
+        auto driver = std::make_unique<ads101x::chardev::driver>(fields.size() == 5 ? fields[4] : "/dev/gpiochip0");
+        driver->start(std::stoul(fields[1]), static_cast<ads101x::slave_address>(std::stoul(fields[2], nullptr, 0)));
+        result.alert_rdy_pin = fields.size() >= 4 ? std::stol(fields[3]) : -1;
+        result.driver = std::move(driver);
+        return result;
+    }
+#ifdef ADS101X_TOOLS_PIGPIO
+    if(fields[0] == "pigpio" && fields.size() >= 3 && fields.size() <= 5)
+    {
+        auto driver = std::make_unique<ads101x::pigpio::driver>();
+        if(fields.size() == 5 && fields[4] == "isr")
+        {
+            driver->set_interrupt_mode(ads101x::pigpio::driver::interrupt_mode::ISR);
+        }
+        else if(fields.size() == 5 && fields[4] == "batched")
+        {
+            driver->set_interrupt_mode(ads101x::pigpio::driver::interrupt_mode::BATCHED);
+        }
+        else if(fields.size() == 5)
+        {
+            throw std::runtime_error("invalid pigpio interrupt mode: " + fields[4]);
+        }
+        if(!tools::pigpio_owner)
+        {
+            driver->pigpio_initialize();
+            tools::pigpio_owner = driver.get();
+        }
+        driver->start(std::stoul(fields[1]), static_cast<ads101x::slave_address>(std::stoul(fields[2], nullptr, 0)));
+        result.alert_rdy_pin = fields.size() >= 4 ? std::stol(fields[3]) : -1;
+        result.driver = std::move(driver);
+        return result;
+    }
+#endif
+#ifdef ADS101X_TOOLS_PIGPIOD
+    if(fields[0] == "pigpiod" && (fields.size() == 5 || fields.size() == 6))
+    {
+        auto driver = std::make_unique<ads101x::pigpiod::driver>();
+        driver->pigpiod_connect(fields[1], std::stoul(fields[2]));
+        driver->start(std::stoul(fields[3]), static_cast<ads101x::slave_address>(std::stoul(fields[4], nullptr, 0)));
+        result.alert_rdy_pin = fields.size() == 6 ? std::stol(fields[5]) : -1;
+        result.driver = std::move(driver);
+        return result;
+    }
+#endif
+    throw std::runtime_error("invalid device specification: " + specification);
+}
+
+/// \brief Stops all devices and terminates pigpio if it was initialized.
+inline void release_devices(std::vector<tools::device>& devices)
+{
+    for(auto& device : devices)
+    {
+        device.driver->stop();
+    }
+#ifdef ADS101X_TOOLS_PIGPIO
+    if(tools::pigpio_owner)
+    {
+        tools::pigpio_owner->pigpio_terminate();
+        tools::pigpio_owner = nullptr;
+    }
+#endif
+    devices.clear();
+}
+
+}
+
+#endif
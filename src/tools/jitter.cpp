@@ -0,0 +1,142 @@
+// ads101x
+#include <ads101x/acquisition.hpp>
+#include <ads101x/jitter.hpp>
+#include <ads101x/variant.hpp>
+
+// tools
+#include "device.hpp"
+
+// std
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+/// \brief Prints usage information.
+void print_usage()
+{
+    std::cout << "usage: ads101x_jitter [--device SPEC] [--mode polling|data-ready|singleshot] [--rate SPS] [--channel N]" << std::endl
+              << "                      [--seconds N] [--histogram] [--rt-priority N] [--rt-cpu N] [--mlock]" << std::endl
+              << std::endl
+              << "Measures the interval between consecutive conversion reads and the latency from each conversion" << std::endl
+              << "becoming ready (ALERT/RDY edge, or timer deadline when polling) to its read." << std::endl
+              << "Defaults to the simulator, polling at 1600 SPS on AIN0/GND for 10 seconds. SPEC is one of:" << std::endl
+              << tools::device_usage
+              << "Data-ready mode, and single-shot mode paced by ALERT/RDY, require an ALERT_PIN." << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    // Parse arguments.
+    std::string specification = "simulator";
+    ads101x::acquisition::mode mode = ads101x::acquisition::mode::POLLING;
+    uint32_t rate = 1600;
+    uint16_t channel = 4;
+    double seconds = 10;
+    bool histograms = false;
+    ads101x::realtime_profile profile;
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        std::string value = (i + 1 < argc) ? argv[i + 1] : "";
+        if(argument == "--device" && !value.empty())
+        {
+            specification = argv[++i];
+        }
+        else if(argument == "--mode" && (value == "polling" || value == "data-ready" || value == "singleshot"))
+        {
+            mode = (value == "polling") ? ads101x::acquisition::mode::POLLING : (value == "data-ready") ? ads101x::acquisition::mode::DATA_READY : ads101x::acquisition::mode::SINGLESHOT;
+            ++i;
+        }
+        else if(argument == "--rate" && !value.empty())
+        {
+            rate = std::stoul(argv[++i]);
+        }
+        else if(argument == "--channel" && !value.empty())
+        {
+            channel = std::stoul(argv[++i]);
+        }
+        else if(argument == "--seconds" && !value.empty())
+        {
+            seconds = std::stod(argv[++i]);
+        }
+        else if(argument == "--histogram")
+        {
+            histograms = true;
+        }
+        else if(argument == "--rt-priority" && !value.empty())
+        {
+            profile.priority = std::stol(argv[++i]);
+            profile.prefault = true;
+        }
+        else if(argument == "--rt-cpu" && !value.empty())
+        {
+            profile.cpu = std::stol(argv[++i]);
+        }
+        else if(argument == "--mlock")
+        {
+            profile.lock_memory = true;
+            profile.prefault = true;
+        }
+        else
+        {
+            print_usage();
+            return argument == "--help" ? 0 : 1;
+        }
+    }
+
+    // Find the data rate setting.
+    auto& rates = ads101x::ads101x_data_rates::data_rates;
+    auto setting = std::find(rates.begin(), rates.end(), rate);
+    if(setting == rates.end() || channel > 7)
+    {
+        std::cerr << "ads101x_jitter: invalid rate or channel" << std::endl;
+        return 1;
+    }
+    ads101x::configuration config;
+    config.set_data_rate(static_cast<ads101x::configuration::data_rate>((setting - rates.begin()) << 5));
+
+    try
+    {
+        // Create the device and acquisition.
+        std::vector<tools::device> devices;
+        devices.push_back(tools::create_device(specification));
+        uint64_t samples;
+        uint64_t errors;
+        ads101x::jitter jitter;
+        ads101x::realtime_report report;
+        {
+            ads101x::acquisition acquisition(*devices.front().driver);
+            acquisition.set_mode(mode);
+            acquisition.set_configuration(config);
+            acquisition.set_channels({static_cast<ads101x::configuration::multiplexer>(channel << 12)});
+            if(devices.front().alert_rdy_pin >= 0)
+            {
+                acquisition.set_alert_rdy_pin(devices.front().alert_rdy_pin);
+            }
+            acquisition.set_realtime(profile);
+            jitter.attach(acquisition);
+
+            // Measure.
+            acquisition.start();
+            report = acquisition.realtime();
+            std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+            acquisition.stop();
+            samples = acquisition.samples();
+            errors = acquisition.errors();
+        }
+        tools::release_devices(devices);
+
+        // Report.
+        std::cout << "device=" << specification << " rate=" << rate << " samples=" << samples << " errors=" << errors << std::endl
+                  << "realtime: scheduling=" << report.scheduling << " affinity=" << report.affinity
+                  << " memory_locked=" << report.memory_locked << " prefaulted=" << report.prefaulted << std::endl;
+        jitter.print(std::cout, histograms);
+    }
+    catch(const std::exception& error)
+    {
+        std::cerr << "ads101x_jitter: " << error.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+// ads101x
+#include <ads101x/simulator/driver.hpp>
+#include <ads101x/simulator/pigpiod_server.hpp>
+
+// std
+#include <csignal>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+/// \brief The server stopped by signal handlers.
+ads101x::simulator::pigpiod_server* running_server = nullptr;
+
+/// \brief Stops the server on SIGINT and SIGTERM.
+void handle_signal(int signal)
+{
+    if(running_server)
+    {
+        running_server->stop();
+    }
+}
+
+/// \brief Prints usage information.
+void print_usage()
+{
+    std::cout << "usage: ads101x_pigpiod_simulator [--port N] [--bus N] [--address ADDRESS] [--alert-pin N]" << std::endl
+              << "                                 [--input VOLTS] [--latency [COMMAND:]MICROSECONDS ...]" << std::endl
+              << std::endl
+              << "Serves a simulated ADS101X over the pigpiod socket protocol, so the pigpiod backend can be tested" << std::endl
+              << "and benchmarked without a Raspberry Pi. --port defaults to 8888, and --input sets every input." << std::endl
+              << "COMMAND is one of I2CO, I2CC, I2CRW, I2CWW, I2CZ, MODES, PUD, WDOG, NB, or TICK, and latency" << std::endl
+              << "without a command applies to every command. Latencies are applied in the order given." << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    typedef ads101x::simulator::pigpiod_server::command command;
+    const std::map<std::string, command> commands = {
+        {"I2CO", command::I2CO}, {"I2CC", command::I2CC}, {"I2CRW", command::I2CRW}, {"I2CWW", command::I2CWW},
+        {"I2CZ", command::I2CZ}, {"MODES", command::MODES}, {"PUD", command::PUD}, {"WDOG", command::WDOG},
+        {"NB", command::NB}, {"TICK", command::TICK}};
+
+    // Parse arguments.
+    uint16_t port = 8888;
+    uint32_t bus = 1;
+    uint8_t address = 0x48;
+    uint16_t alert_rdy_pin = 25;
+    double input = 0.0;
+    std::vector<std::string> latencies;
+    try
+    {
+        for(int i = 1; i < argc; ++i)
+        {
+            std::string argument = argv[i];
+            if(argument == "--port" && i + 1 < argc)
+            {
+                port = std::stoul(argv[++i]);
+            }
+            else if(argument == "--bus" && i + 1 < argc)
+            {
+                bus = std::stoul(argv[++i]);
+            }
+            else if(argument == "--address" && i + 1 < argc)
+            {
+                address = std::stoul(argv[++i], nullptr, 0);
+            }
+            else if(argument == "--alert-pin" && i + 1 < argc)
+            {
+                alert_rdy_pin = std::stoul(argv[++i]);
+            }
+            else if(argument == "--input" && i + 1 < argc)
+            {
+                input = std::stod(argv[++i]);
+            }
+            else if(argument == "--latency" && i + 1 < argc)
+            {
+                latencies.push_back(argv[++i]);
+            }
+            else
+            {
+                print_usage();
+                return argument == "--help" ? 0 : 1;
+            }
+        }
+    }
+    catch(const std::exception&)
+    {
+        print_usage();
+        return 1;
+    }
+
+    try
+    {
+        // Create the simulated device.
+        ads101x::simulator::driver driver;
+        driver.set_signal([input](ads101x::configuration::multiplexer, double) { return input; });
+        driver.start();
+
+        {
+            // Create the server and apply latencies, then serve until signalled.
+            ads101x::simulator::pigpiod_server server(driver, bus, address, alert_rdy_pin, port);
+            for(auto& latency : latencies)
+            {
+                size_t separator = latency.find(':');
+                std::chrono::microseconds microseconds(std::stoul(latency.substr(separator == std::string::npos ? 0 : separator + 1)));
+                if(separator == std::string::npos)
+                {
+                    server.set_latency(microseconds);
+                    continue;
+                }
+                auto entry = commands.find(latency.substr(0, separator));
+                if(entry == commands.end())
+                {
+                    throw std::runtime_error("unknown latency command: " + latency.substr(0, separator));
+                }
+                server.set_latency(entry->second, microseconds);
+            }
+            running_server = &server;
+            std::signal(SIGINT, handle_signal);
+            std::signal(SIGTERM, handle_signal);
+            std::cout << "serving simulated device 0x" << std::hex << static_cast<uint32_t>(address) << std::dec << " on bus " << bus
+                      << " at localhost:" << server.port() << " (ALERT/RDY on GPIO " << alert_rdy_pin << ")" << std::endl;
+            server.run();
+            running_server = nullptr;
+        }
+
+        // Stop the device.
+        driver.stop();
+    }
+    catch(const std::exception& error)
+    {
+        std::cerr << "ads101x_pigpiod_simulator: " << error.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
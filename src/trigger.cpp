@@ -0,0 +1,243 @@
+#include <ads101x/trigger.hpp>
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+using namespace ads101x;
+
+// CONSTRUCTORS
+trigger::trigger(uint32_t pre_samples, uint32_t post_samples)
+    : m_pre_samples(pre_samples),
+      m_post_samples(post_samples),
+      m_threshold(false),
+      m_threshold_low(0),
+      m_threshold_high(0),
+      m_driver(nullptr),
+      m_alert_time(0),
+      m_state(trigger::state::IDLE),
+      m_history_count(0),
+      m_captures(0)
+{
+    if(post_samples == 0)
+    {
+        throw std::runtime_error("trigger requires at least one post-trigger sample");
+    }
+
+    // Allocate the record once, so captures do not allocate on the acquisition thread.
+    trigger::m_record.samples.reserve(static_cast<size_t>(pre_samples) + post_samples);
+    trigger::m_record.trigger_index = 0;
+    trigger::m_record.source = trigger::source::THRESHOLD;
+}
+trigger::~trigger()
+{
+    // Detach ALERT/RDY if necessary.
+    try
+    {
+        trigger::detach_alert_rdy();
+    }
+    catch(...)
+    {}
+}
+
+// SOURCES
+void trigger::set_threshold(int16_t low, int16_t high)
+{
+    trigger::m_threshold_low = low;
+    trigger::m_threshold_high = high;
+    trigger::m_threshold = true;
+}
+void trigger::attach_alert_rdy(ads101x::driver& driver, uint16_t pin, ads101x::configuration::comparator_polarity polarity)
+{
+    // Detach any prior attachment.
+    trigger::detach_alert_rdy();
+
+    // Record the time of the first assertion while armed. Only the asserting edge is subscribed to.
+    driver.attach_alert_rdy(pin, [this, &driver](bool)
+    {
+        if(trigger::m_state.load(std::memory_order_acquire) == trigger::state::ARMED)
+        {
+            uint64_t expected = 0;
+            trigger::m_alert_time.compare_exchange_strong(expected, driver.alert_rdy_timestamp(), std::memory_order_release);
+        }
+    }, ads101x::asserting_edge(polarity));
+    trigger::m_driver = &driver;
+}
+void trigger::detach_alert_rdy()
+{
+    // Check if attached.
+    if(!trigger::m_driver)
+    {
+        return;
+    }
+
+    // Detach and reset the driver.
+    trigger::m_driver->detach_alert_rdy();
+    trigger::m_driver = nullptr;
+}
+
+// CAPTURE
+void trigger::attach(ads101x::acquisition& acquisition)
+{
+    // Keep views of enough blocks to hold the pre-trigger samples. The views stay intact as long as the writer cannot
+    // reach them, which leaves room for the block being processed.
+    const ads101x::broadcast_ring<ads101x::sample>& ring = acquisition.ring();
+    uint32_t blocks = (trigger::m_pre_samples + ring.block_size() - 1) / ring.block_size();
+    if(blocks >= ring.block_count())
+    {
+        throw std::runtime_error("trigger pre-trigger samples exceed the acquisition's broadcast ring");
+    }
+    trigger::m_history.assign(std::max<uint32_t>(blocks, 1), std::span<const ads101x::sample>());
+    trigger::m_history_count = 0;
+
+    // Process every published block.
+    acquisition.add_sink([this](std::span<const ads101x::sample> block) { trigger::process(block); });
+}
+void trigger::arm()
+{
+    // Verify no capture is in progress.
+    trigger::state state = trigger::m_state.load(std::memory_order_acquire);
+    if(state == trigger::state::ARMED || state == trigger::state::TRIGGERED)
+    {
+        throw std::runtime_error("trigger capture is already in progress");
+    }
+
+    // Reset the record, keeping its storage, and arm.
+    trigger::m_record.samples.clear();
+    trigger::m_record.trigger_index = 0;
+    trigger::m_alert_time.store(0, std::memory_order_relaxed);
+    trigger::m_state.store(trigger::state::ARMED, std::memory_order_release);
+}
+bool trigger::armed() const
+{
+    trigger::state state = trigger::m_state.load(std::memory_order_acquire);
+    return state == trigger::state::ARMED || state == trigger::state::TRIGGERED;
+}
+bool trigger::wait(uint64_t timeout_ns) const
+{
+    std::unique_lock<std::mutex> lock(trigger::m_mutex);
+    return trigger::m_complete.wait_for(lock, std::chrono::nanoseconds(timeout_ns), [this]
+    {
+        return trigger::m_state.load(std::memory_order_acquire) == trigger::state::COMPLETE;
+    });
+}
+const trigger::record& trigger::capture() const
+{
+    return trigger::m_record;
+}
+uint64_t trigger::captures() const
+{
+    return trigger::m_captures;
+}
+
+// PROCESSING
+void trigger::process(std::span<const ads101x::sample> block)
+{
+    trigger::state state = trigger::m_state.load(std::memory_order_acquire);
+    if(state == trigger::state::ARMED)
+    {
+        // Look for the trigger sample, and start the record at it.
+        trigger::source source;
+        size_t index = trigger::find(block, source);
+        if(index < block.size())
+        {
+            trigger::m_record.source = source;
+            trigger::copy_pre(block, index);
+            trigger::m_state.store(trigger::state::TRIGGERED, std::memory_order_relaxed);
+            trigger::copy_post(block.subspan(index));
+        }
+    }
+    else if(state == trigger::state::TRIGGERED)
+    {
+        trigger::copy_post(block);
+    }
+
+    // Keep a view of the block for later pre-trigger samples.
+    trigger::m_history[trigger::m_history_count % trigger::m_history.size()] = block;
+    trigger::m_history_count++;
+}
+size_t trigger::find(std::span<const ads101x::sample> block, trigger::source& source) const
+{
+    size_t index = block.size();
+
+    // Find the first sample outside the threshold window.
+    if(trigger::m_threshold)
+    {
+        for(size_t i = 0; i < block.size(); ++i)
+        {
+            if(block[i].value < trigger::m_threshold_low || block[i].value > trigger::m_threshold_high)
+            {
+                index = i;
+                source = trigger::source::THRESHOLD;
+                break;
+            }
+        }
+    }
+
+    // Find the first sample read after a comparator assertion, if earlier.
+    uint64_t alert_time = trigger::m_alert_time.load(std::memory_order_acquire);
+    if(alert_time != 0)
+    {
+        for(size_t i = 0; i < index; ++i)
+        {
+            if(block[i].timestamp >= alert_time)
+            {
+                index = i;
+                source = trigger::source::ALERT_RDY;
+                break;
+            }
+        }
+    }
+
+    return index;
+}
+void trigger::copy_pre(std::span<const ads101x::sample> block, size_t index)
+{
+    // Walk back through the viewed blocks until enough samples precede the trigger sample.
+    size_t available = index;
+    size_t views = std::min<uint64_t>(trigger::m_history_count, trigger::m_history.size());
+    size_t blocks = 0;
+    while(available < trigger::m_pre_samples && blocks < views)
+    {
+        available += trigger::m_history[(trigger::m_history_count - 1 - blocks) % trigger::m_history.size()].size();
+        blocks++;
+    }
+
+    // Copy forward from the oldest sample needed.
+    size_t skip = (available > trigger::m_pre_samples) ? available - trigger::m_pre_samples : 0;
+    auto append = [this, &skip](std::span<const ads101x::sample> samples)
+    {
+        if(skip >= samples.size())
+        {
+            skip -= samples.size();
+            return;
+        }
+        trigger::m_record.samples.insert(trigger::m_record.samples.end(), samples.begin() + skip, samples.end());
+        skip = 0;
+    };
+    for(size_t i = blocks; i > 0; --i)
+    {
+        append(trigger::m_history[(trigger::m_history_count - i) % trigger::m_history.size()]);
+    }
+    append(block.first(index));
+    trigger::m_record.trigger_index = trigger::m_record.samples.size();
+}
+void trigger::copy_post(std::span<const ads101x::sample> samples)
+{
+    // Copy up to the remaining post-trigger samples.
+    size_t remaining = trigger::m_record.trigger_index + trigger::m_post_samples - trigger::m_record.samples.size();
+    size_t count = std::min(remaining, samples.size());
+    trigger::m_record.samples.insert(trigger::m_record.samples.end(), samples.begin(), samples.begin() + count);
+
+    // Complete the record once all are collected.
+    if(count == remaining)
+    {
+        trigger::m_captures++;
+        {
+            std::lock_guard<std::mutex> lock(trigger::m_mutex);
+            trigger::m_state.store(trigger::state::COMPLETE, std::memory_order_release);
+        }
+        trigger::m_complete.notify_all();
+    }
+}
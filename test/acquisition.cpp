@@ -0,0 +1,364 @@
+// ads101x
+#include <ads101x/acquisition.hpp>
+#include <ads101x/clock.hpp>
+#include <ads101x/simulator/driver.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+// posix
+#include <sched.h>
+
+/// \brief Gets the first CPU the test process may run on, which may not be CPU 0 under a restricted cpuset.
+static int32_t first_allowed_cpu()
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if(sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+        for(int32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if(CPU_ISSET(cpu, &set))
+            {
+                return cpu;
+            }
+        }
+    }
+    return 0;
+}
+
+// Create test driver whose configuration writes fail, and which tracks the ALERT/RDY attachment.
+struct failing_driver
+    : public ads101x::driver
+{
+    // CONSTRUCTORS
+    failing_driver()
+        : registers{0, 0x8583, 0x8000, 0x7FF0},
+          interrupt_pin(-1),
+          watchdog(0),
+          armed(0)
+    {}
+
+    // OVERRIDES
+    void open_i2c(uint32_t i2c_bus, uint8_t i2c_address) override
+    {}
+    void close_i2c() override
+    {}
+    void write_register(uint8_t register_address, uint16_t value) const override
+    {
+        if(register_address == static_cast<uint8_t>(ads101x::register_address::CONFIG))
+        {
+            throw std::runtime_error("write failed");
+        }
+        failing_driver::registers[register_address] = value;
+    }
+    uint16_t read_register(uint8_t register_address) const override
+    {
+        return failing_driver::registers[register_address];
+    }
+    void attach_interrupt(uint16_t pin) override
+    {
+        failing_driver::interrupt_pin = pin;
+    }
+    void detach_interrupt(uint16_t pin) override
+    {
+        failing_driver::interrupt_pin = -1;
+    }
+    void set_watchdog(uint16_t pin, uint32_t timeout_ms) override
+    {
+        failing_driver::watchdog = timeout_ms;
+        failing_driver::armed = timeout_ms ? timeout_ms : failing_driver::armed;
+    }
+
+    // STATE
+    mutable uint16_t registers[4];
+    int32_t interrupt_pin;
+    uint32_t watchdog;
+    uint32_t armed;
+};
+
+// MODES
+TEST(acquisition, polling)
+{
+    // Create simulated device with a constant input.
+    ads101x::simulator::driver driver;
+    driver.set_input(ads101x::configuration::multiplexer::AIN0_GND, 1.024);
+    driver.start();
+
+    // Configure acquisition.
+    ads101x::acquisition acquisition(driver, 8, 16);
+    ads101x::configuration config;
+    config.set_fsr(ads101x::configuration::fsr::FSR_2_048);
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    acquisition.set_configuration(config);
+    acquisition.set_channels({ads101x::configuration::multiplexer::AIN0_GND});
+
+    // Subscribe two consumers and acquire briefly.
+    auto first = acquisition.subscribe();
+    auto second = acquisition.subscribe();
+    uint32_t sink_samples = 0;
+    acquisition.add_sink([&sink_samples](std::span<const ads101x::sample> block) { sink_samples += block.size(); });
+    acquisition.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    acquisition.stop();
+
+    // Verify samples reached every consumer with the expected values.
+    // The reader starts at the oldest block still in the ring, so sequences are contiguous from there.
+    EXPECT_GT(acquisition.samples(), 16);
+    EXPECT_EQ(sink_samples, acquisition.samples());
+    std::span<const ads101x::sample> view;
+    ASSERT_TRUE(first.next(view));
+    uint64_t sequence = view.front().sequence;
+    EXPECT_EQ(sequence, first.overruns() * 8);
+    do
+    {
+        for(auto& sample : view)
+        {
+            EXPECT_EQ(sample.sequence, sequence++);
+            EXPECT_EQ(sample.fsr, ads101x::configuration::fsr::FSR_2_048);
+            EXPECT_EQ(sample.channel, ads101x::configuration::multiplexer::AIN0_GND);
+        }
+        EXPECT_TRUE(first.release());
+    } while(first.next(view));
+    EXPECT_EQ(sequence, acquisition.samples());
+    EXPECT_TRUE(second.next(view));
+    EXPECT_NEAR(view.back().voltage(), 1.024, 0.001);
+    EXPECT_EQ(acquisition.errors(), 0);
+}
+TEST(acquisition, data_ready)
+{
+    // Create simulated device.
+    ads101x::simulator::driver driver;
+    driver.set_input(ads101x::configuration::multiplexer::AIN1_GND, -0.5);
+    driver.start();
+
+    // Configure acquisition paced by ALERT/RDY.
+    ads101x::acquisition acquisition(driver, 4, 16);
+    ads101x::configuration config;
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_1600);
+    acquisition.set_configuration(config);
+    acquisition.set_mode(ads101x::acquisition::mode::DATA_READY);
+    acquisition.set_channels({ads101x::configuration::multiplexer::AIN1_GND});
+    acquisition.set_alert_rdy_pin(17);
+
+    // Acquire briefly.
+    auto reader = acquisition.subscribe();
+    acquisition.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    acquisition.stop();
+
+    // Verify samples were acquired on conversion-ready edges.
+    EXPECT_GT(acquisition.samples(), 8);
+    std::span<const ads101x::sample> view;
+    ASSERT_TRUE(reader.next(view));
+    EXPECT_NEAR(view.front().voltage(), -0.5, 0.001);
+}
+TEST(acquisition, watchdog)
+{
+    // Create simulated device.
+    ads101x::simulator::driver driver;
+    driver.set_input(ads101x::configuration::multiplexer::AIN0_GND, 0.5);
+    driver.start();
+
+    // Configure acquisition paced by ALERT/RDY, with the watchdog armed.
+    ads101x::acquisition acquisition(driver, 4, 16);
+    ads101x::configuration config;
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_1600);
+    acquisition.set_configuration(config);
+    acquisition.set_mode(ads101x::acquisition::mode::DATA_READY);
+    acquisition.set_alert_rdy_pin(17);
+    acquisition.set_watchdog(4);
+
+    // Acquire, then reset the device so conversion-ready edges stop.
+    acquisition.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(acquisition.stalls(), 0);
+    driver.reset();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    uint64_t recovered = acquisition.samples();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    acquisition.stop();
+
+    // Verify the stall was detected and conversions resumed.
+    EXPECT_GE(acquisition.stalls(), 1);
+    EXPECT_GT(acquisition.samples(), recovered + 8);
+    EXPECT_EQ(acquisition.errors(), 0);
+}
+TEST(acquisition, singleshot_scan)
+{
+    // Create simulated device with a different input on each channel.
+    ads101x::simulator::driver driver;
+    driver.set_input(ads101x::configuration::multiplexer::AIN0_GND, 0.25);
+    driver.set_input(ads101x::configuration::multiplexer::AIN3_GND, 0.75);
+    driver.start();
+
+    // Configure a two channel scan.
+    ads101x::acquisition acquisition(driver, 4, 16);
+    ads101x::configuration config;
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    acquisition.set_configuration(config);
+    acquisition.set_mode(ads101x::acquisition::mode::SINGLESHOT);
+    acquisition.set_channels({ads101x::configuration::multiplexer::AIN0_GND, ads101x::configuration::multiplexer::AIN3_GND});
+
+    // Acquire briefly.
+    auto reader = acquisition.subscribe();
+    acquisition.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    acquisition.stop();
+
+    // Verify each sample carries its channel's value.
+    std::span<const ads101x::sample> view;
+    ASSERT_TRUE(reader.next(view));
+    for(auto& sample : view)
+    {
+        double expected = (sample.channel == ads101x::configuration::multiplexer::AIN0_GND) ? 0.25 : 0.75;
+        EXPECT_NEAR(sample.voltage(), expected, 0.001);
+    }
+    EXPECT_NE(view[0].channel, view[1].channel);
+}
+TEST(acquisition, latest)
+{
+    // Create simulated device with a different input on each channel.
+    ads101x::simulator::driver driver;
+    driver.set_input(ads101x::configuration::multiplexer::AIN0_GND, 0.25);
+    driver.set_input(ads101x::configuration::multiplexer::AIN3_GND, 0.75);
+    driver.start();
+
+    // Configure a two channel scan.
+    ads101x::acquisition acquisition(driver, 4, 16);
+    ads101x::configuration config;
+    config.set_fsr(ads101x::configuration::fsr::FSR_2_048);
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    acquisition.set_configuration(config);
+    acquisition.set_mode(ads101x::acquisition::mode::SINGLESHOT);
+    acquisition.set_channels({ads101x::configuration::multiplexer::AIN0_GND, ads101x::configuration::multiplexer::AIN3_GND});
+
+    // Verify no channel has a latest sample before acquiring.
+    ads101x::sample sample;
+    EXPECT_FALSE(acquisition.latest(ads101x::configuration::multiplexer::AIN0_GND, sample));
+
+    // Poll the latest samples from another thread while acquiring.
+    acquisition.start();
+    uint32_t reads = 0;
+    uint32_t errors = 0;
+    uint64_t last_sequence = 0;
+    uint64_t end = ads101x::monotonic_ns() + 30000000;
+    while(ads101x::monotonic_ns() < end)
+    {
+        if(acquisition.latest(ads101x::configuration::multiplexer::AIN3_GND, sample))
+        {
+            reads++;
+            errors += sample.channel != ads101x::configuration::multiplexer::AIN3_GND;
+            errors += std::abs(sample.voltage() - 0.75) > 0.001;
+            errors += sample.sequence < last_sequence;
+            last_sequence = sample.sequence;
+        }
+    }
+    acquisition.stop();
+
+    // Verify every read was consistent, and the final samples are the newest of each channel.
+    EXPECT_GT(reads, 0);
+    EXPECT_EQ(errors, 0);
+    ASSERT_TRUE(acquisition.latest(ads101x::configuration::multiplexer::AIN0_GND, sample));
+    EXPECT_NEAR(sample.voltage(), 0.25, 0.001);
+    EXPECT_EQ(sample.fsr, ads101x::configuration::fsr::FSR_2_048);
+    ads101x::sample other;
+    ASSERT_TRUE(acquisition.latest(ads101x::configuration::multiplexer::AIN3_GND, other));
+    EXPECT_GE(std::max(sample.sequence, other.sequence) + 1, acquisition.samples());
+    EXPECT_FALSE(acquisition.latest(ads101x::configuration::multiplexer::AIN1_GND, sample));
+}
+TEST(acquisition, realtime)
+{
+    // Create simulated device.
+    ads101x::simulator::driver driver;
+    driver.set_input(ads101x::configuration::multiplexer::AIN0_GND, 0.25);
+    driver.start();
+
+    // Request a real-time profile. Scheduling may be refused without privileges.
+    ads101x::acquisition acquisition(driver, 8, 16);
+    ads101x::configuration config;
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    acquisition.set_configuration(config);
+    ads101x::realtime_profile profile;
+    profile.priority = 10;
+    profile.cpu = first_allowed_cpu();
+    profile.prefault = true;
+    acquisition.set_realtime(profile);
+    acquisition.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    acquisition.stop();
+
+    // Verify the granted settings were reported and the read interval was tracked.
+    EXPECT_TRUE(acquisition.realtime().affinity);
+    EXPECT_TRUE(acquisition.realtime().prefaulted);
+    EXPECT_FALSE(acquisition.realtime().memory_locked);
+    EXPECT_GT(acquisition.samples(), 8);
+    EXPECT_GT(acquisition.max_interval(), 0);
+}
+
+// ERRORS
+TEST(acquisition, start_rollback)
+{
+    // Configure acquisition paced by ALERT/RDY with the watchdog armed, on a device whose configuration writes fail.
+    failing_driver driver;
+    ads101x::acquisition acquisition(driver, 4, 16);
+    acquisition.set_mode(ads101x::acquisition::mode::DATA_READY);
+    acquisition.set_alert_rdy_pin(17);
+    acquisition.set_watchdog(4);
+
+    // Verify the failed start detached ALERT/RDY and disarmed the watchdog.
+    EXPECT_THROW(acquisition.start(), std::runtime_error);
+    EXPECT_FALSE(acquisition.running());
+    EXPECT_EQ(driver.interrupt_pin, -1);
+    EXPECT_EQ(driver.watchdog, 0);
+
+    // Verify ALERT/RDY can be attached again.
+    EXPECT_NO_THROW(driver.attach_alert_rdy(17, [](bool) {}));
+    EXPECT_EQ(driver.interrupt_pin, 17);
+    driver.detach_alert_rdy();
+}
+TEST(acquisition, variant)
+{
+    // Configure acquisition of a 16-bit device at its slowest data rate, with the watchdog armed.
+    failing_driver driver;
+    ads101x::acquisition acquisition(driver, 4, 16);
+    ads101x::configuration config;
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_128);
+    acquisition.set_configuration(config);
+    acquisition.set_variant(ads101x::variant::ADS1115);
+    acquisition.set_mode(ads101x::acquisition::mode::DATA_READY);
+    acquisition.set_alert_rdy_pin(17);
+    acquisition.set_watchdog(4);
+
+    // Verify the watchdog was armed for four 8 SPS periods, not four 128 SPS periods.
+    EXPECT_THROW(acquisition.start(), std::runtime_error);
+    EXPECT_EQ(driver.armed, 550);
+    EXPECT_EQ(driver.armed, ads101x::watchdog_timeout_ms(ads101x::variant::ADS1115, ads101x::configuration::data_rate::SPS_128, 4));
+}
+TEST(acquisition, singleshot_errors)
+{
+    // Configure single-shot acquisition at 128SPS on a device whose configuration writes fail.
+    failing_driver driver;
+    ads101x::acquisition acquisition(driver, 4, 16);
+    ads101x::configuration config;
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_128);
+    acquisition.set_configuration(config);
+    acquisition.set_mode(ads101x::acquisition::mode::SINGLESHOT);
+
+    // Verify failed conversions are retried once per period instead of in a busy loop. Powering the device down on
+    // stop fails too.
+    uint64_t start = ads101x::monotonic_ns();
+    acquisition.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_THROW(acquisition.stop(), std::runtime_error);
+    uint64_t elapsed = ads101x::monotonic_ns() - start;
+    EXPECT_FALSE(acquisition.running());
+    EXPECT_GT(acquisition.errors(), 0);
+    EXPECT_LE(acquisition.errors(), elapsed / 7812500 + 1);
+    EXPECT_EQ(acquisition.samples(), 0);
+}
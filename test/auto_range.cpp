@@ -0,0 +1,141 @@
+// ads101x
+#include <ads101x/auto_range.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// Create test driver object.
+struct auto_range_driver
+    : public ads101x::driver
+{
+    // CONSTRUCTORS
+    auto_range_driver()
+        : write_count(0),
+          write_value(0),
+          read_value(0)
+    {}
+
+    // OVERRIDES
+    void open_i2c(uint32_t i2c_bus, uint8_t i2c_address) override
+    {}
+    void close_i2c() override
+    {}
+    void write_register(uint8_t register_address, uint16_t value) const override
+    {
+        // Count writes and store value.
+        auto_range_driver::write_count++;
+        auto_range_driver::write_value = value;
+    }
+    uint16_t read_register(uint8_t register_address) const override
+    {
+        // Return conversion value (12bit, MSB aligned).
+        return auto_range_driver::read_value << 4;
+    }
+
+    // STATE
+    mutable uint32_t write_count;
+    mutable uint16_t write_value;
+    uint16_t read_value;
+};
+
+// CONSTRUCTORS
+TEST(auto_range, invalid_thresholds)
+{
+    // Verify that thresholds without hysteresis are rejected.
+    EXPECT_THROW(ads101x::auto_range(ads101x::configuration(), 0.5f, 0.5f), std::runtime_error);
+    EXPECT_THROW(ads101x::auto_range(ads101x::configuration(), 1.5f, 0.5f), std::runtime_error);
+}
+
+// CONVERSION
+TEST(auto_range, widen_on_saturation)
+{
+    // Create controller starting at +/- 1.024V.
+    ads101x::configuration config;
+    config.set_fsr(ads101x::configuration::fsr::FSR_1_024);
+    ads101x::auto_range auto_range(config);
+
+    // Process a saturated negative conversion.
+    ads101x::sample sample = auto_range.process(0x0800);
+
+    // Verify sample is tagged with the range it was taken at.
+    EXPECT_EQ(sample.fsr, ads101x::configuration::fsr::FSR_1_024);
+    EXPECT_EQ(sample.value, -2048);
+
+    // Verify the range change is pending but not yet active.
+    EXPECT_TRUE(auto_range.pending());
+    EXPECT_EQ(auto_range.get_configuration().get_fsr(), ads101x::configuration::fsr::FSR_2_048);
+    EXPECT_EQ(auto_range.active_fsr(), ads101x::configuration::fsr::FSR_1_024);
+}
+TEST(auto_range, narrow_after_dwell)
+{
+    // Create controller starting at +/- 4.096V with a dwell of two conversions.
+    ads101x::configuration config;
+    config.set_fsr(ads101x::configuration::fsr::FSR_4_096);
+    ads101x::auto_range auto_range(config, 0.95f, 0.8f, 2);
+
+    // Process a small conversion once, which should not yet narrow the range.
+    auto_range.process(100);
+    EXPECT_FALSE(auto_range.pending());
+
+    // Process the second small conversion, which should narrow the range.
+    auto_range.process(100);
+    EXPECT_TRUE(auto_range.pending());
+    EXPECT_EQ(auto_range.get_configuration().get_fsr(), ads101x::configuration::fsr::FSR_2_048);
+}
+TEST(auto_range, hysteresis)
+{
+    // Create controller starting at +/- 4.096V with no dwell.
+    ads101x::configuration config;
+    config.set_fsr(ads101x::configuration::fsr::FSR_4_096);
+    ads101x::auto_range auto_range(config, 0.95f, 0.8f, 1);
+
+    // Process a conversion at 50% of full scale, which is 100% of the narrower range and within the band.
+    auto_range.process(1024);
+    EXPECT_FALSE(auto_range.pending());
+}
+TEST(auto_range, limits)
+{
+    // Create controller limited to +/- 2.048V.
+    ads101x::configuration config;
+    config.set_fsr(ads101x::configuration::fsr::FSR_2_048);
+    ads101x::auto_range auto_range(config, 0.95f, 0.8f, 1);
+    auto_range.set_limits(ads101x::configuration::fsr::FSR_2_048, ads101x::configuration::fsr::FSR_2_048);
+
+    // Verify neither saturation nor small signals change the range.
+    auto_range.process(0x07FF);
+    EXPECT_FALSE(auto_range.pending());
+    auto_range.process(0);
+    EXPECT_FALSE(auto_range.pending());
+}
+
+// DRIVER
+TEST(auto_range, folded_write)
+{
+    // Create test driver.
+    auto_range_driver driver;
+
+    // Create controller for a single-shot configuration.
+    ads101x::configuration config;
+    config.set_operation(ads101x::configuration::operation::CONVERT);
+    config.set_mode(ads101x::configuration::mode::SINGLESHOT);
+    config.set_fsr(ads101x::configuration::fsr::FSR_2_048);
+    ads101x::auto_range auto_range(config);
+
+    // Start the first conversion and read a saturated value.
+    auto_range.write_config(driver);
+    driver.read_value = 0x07FF;
+    ads101x::sample sample = auto_range.read_conversion(driver);
+    EXPECT_EQ(sample.fsr, ads101x::configuration::fsr::FSR_2_048);
+
+    // Start the next conversion, which should carry the range change without extra writes.
+    auto_range.write_config(driver);
+    EXPECT_EQ(driver.write_count, 2);
+    EXPECT_EQ(ads101x::configuration(driver.write_value).get_fsr(), ads101x::configuration::fsr::FSR_4_096);
+    EXPECT_EQ(ads101x::configuration(driver.write_value).get_operation(), ads101x::configuration::operation::CONVERT);
+    EXPECT_FALSE(auto_range.pending());
+
+    // Verify the next conversion is tagged with the new range.
+    driver.read_value = 0x0100;
+    sample = auto_range.read_conversion(driver);
+    EXPECT_EQ(sample.fsr, ads101x::configuration::fsr::FSR_4_096);
+}
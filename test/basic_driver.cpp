@@ -0,0 +1,124 @@
+// ads101x
+#include <ads101x/basic_driver.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// Create statically dispatched test backend.
+class static_driver
+    : public ads101x::basic_driver<static_driver>
+{
+public:
+    // CONSTRUCTORS
+    static_driver()
+        : i2c_opened(false),
+          write_address(0),
+          write_value(0),
+          read_address(0),
+          read_value(0)
+    {}
+
+    // STATE
+    bool i2c_opened;
+    mutable uint8_t write_address;
+    mutable uint16_t write_value;
+    mutable uint8_t read_address;
+    uint16_t read_value;
+
+private:
+    // BACKEND
+    friend class ads101x::basic_driver<static_driver>;
+    void open_i2c(uint32_t i2c_bus, uint8_t i2c_address)
+    {
+        static_driver::i2c_opened = true;
+    }
+    void close_i2c()
+    {
+        static_driver::i2c_opened = false;
+    }
+    void write_register(uint8_t register_address, uint16_t value) const
+    {
+        static_driver::write_address = register_address;
+        static_driver::write_value = value;
+    }
+    uint16_t read_register(uint8_t register_address) const
+    {
+        static_driver::read_address = register_address;
+        return static_driver::read_value;
+    }
+};
+
+// CONTROL
+TEST(basic_driver, start_stop)
+{
+    // Create static driver.
+    static_driver driver;
+
+    // Verify start and stop reach the backend.
+    driver.start();
+    EXPECT_TRUE(driver.i2c_opened);
+    driver.stop();
+    EXPECT_FALSE(driver.i2c_opened);
+}
+
+// REGISTERS
+TEST(basic_driver, registers)
+{
+    // Create static driver.
+    static_driver driver;
+
+    // Verify configuration write.
+    ads101x::configuration config(0x1234);
+    driver.write_config(config);
+    EXPECT_EQ(driver.write_address, static_cast<uint8_t>(ads101x::register_address::CONFIG));
+    EXPECT_EQ(driver.write_value, 0x1234);
+
+    // Verify conversion read.
+    driver.read_value = 0x0AAA << 4;
+    EXPECT_EQ(driver.read_conversion(), 0x0AAA);
+    EXPECT_EQ(driver.read_address, static_cast<uint8_t>(ads101x::register_address::CONVERSION));
+
+    // Verify threshold write.
+    driver.write_hi_thresh(0x0AAA);
+    EXPECT_EQ(driver.write_address, static_cast<uint8_t>(ads101x::register_address::HI_THRESH));
+    EXPECT_EQ(driver.write_value, 0x0AAA << 4);
+}
+
+// CONVERSION
+TEST(basic_driver, read_conversions)
+{
+    // Create static driver.
+    static_driver driver;
+    driver.read_value = 0x0555 << 4;
+
+    // Verify a back to back block read.
+    uint16_t conversions[8];
+    driver.read_conversions(conversions);
+    for(auto conversion : conversions)
+    {
+        EXPECT_EQ(conversion, 0x0555);
+    }
+
+    // Verify a timed block read is paced by the period.
+    uint64_t timestamps[8];
+    uint64_t start = ads101x::monotonic_ns();
+    driver.read_conversions(conversions, 1000000, timestamps);
+    EXPECT_GE(timestamps[7] - start, 7000000);
+    for(uint32_t i = 1; i < 8; ++i)
+    {
+        EXPECT_GT(timestamps[i], timestamps[i - 1]);
+    }
+
+    // Verify a mismatched timestamp buffer is rejected.
+    EXPECT_THROW(driver.read_conversions(conversions, 1000000, std::span<uint64_t>(timestamps, 4)), std::runtime_error);
+}
+
+// ALERT_RDY
+TEST(basic_driver, no_interrupts)
+{
+    // Create static driver, which does not provide interrupt support.
+    static_driver driver;
+
+    // Verify attach uses the default, unsupported attachment.
+    EXPECT_THROW(driver.attach_alert_rdy(8, [](bool level) {}), std::runtime_error);
+}
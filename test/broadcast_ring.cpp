@@ -0,0 +1,100 @@
+// ads101x
+#include <ads101x/broadcast_ring.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <thread>
+
+// Writes a block of sequential values into a ring.
+void write_block(ads101x::broadcast_ring<uint32_t>& ring, uint32_t first)
+{
+    std::span<uint32_t> block = ring.claim();
+    for(uint32_t i = 0; i < block.size(); ++i)
+    {
+        block[i] = first + i;
+    }
+    ring.publish(block.size());
+}
+
+// READERS
+TEST(broadcast_ring, independent_readers)
+{
+    // Create ring and two readers.
+    ads101x::broadcast_ring<uint32_t> ring(4, 8);
+    auto fast = ring.subscribe();
+    auto slow = ring.subscribe();
+
+    // Publish a block and read it from the fast reader.
+    write_block(ring, 0);
+    std::span<const uint32_t> view;
+    ASSERT_TRUE(fast.next(view));
+    EXPECT_EQ(view.size(), 8);
+    EXPECT_EQ(view[7], 7);
+    EXPECT_TRUE(fast.release());
+    EXPECT_FALSE(fast.next(view));
+
+    // Verify the slow reader still has the block, viewing the same memory.
+    EXPECT_EQ(slow.lag(), 1);
+    std::span<const uint32_t> slow_view;
+    ASSERT_TRUE(slow.next(slow_view));
+    EXPECT_EQ(slow_view.data(), view.data());
+    EXPECT_EQ(slow.lag(), 0);
+}
+TEST(broadcast_ring, overrun)
+{
+    // Create ring and reader.
+    ads101x::broadcast_ring<uint32_t> ring(4, 2);
+    auto reader = ring.subscribe();
+
+    // Publish more blocks than the ring holds.
+    for(uint32_t i = 0; i < 6; ++i)
+    {
+        write_block(ring, i * 2);
+    }
+
+    // Verify the reader skips to the oldest intact block and counts the lost blocks.
+    std::span<const uint32_t> view;
+    ASSERT_TRUE(reader.next(view));
+    EXPECT_EQ(view[0], 4);
+    EXPECT_EQ(reader.overruns(), 2);
+    EXPECT_EQ(reader.lag(), 3);
+}
+TEST(broadcast_ring, overwritten_view)
+{
+    // Create ring and reader.
+    ads101x::broadcast_ring<uint32_t> ring(2, 2);
+    auto reader = ring.subscribe();
+
+    // Take a view, then let the writer lap it.
+    write_block(ring, 0);
+    std::span<const uint32_t> view;
+    ASSERT_TRUE(reader.next(view));
+    write_block(ring, 2);
+    write_block(ring, 4);
+
+    // Verify the overwrite is detected.
+    EXPECT_FALSE(reader.release());
+    EXPECT_EQ(reader.overruns(), 1);
+}
+TEST(broadcast_ring, wait_close)
+{
+    // Create ring and reader.
+    ads101x::broadcast_ring<uint32_t> ring(4, 2);
+    auto reader = ring.subscribe();
+
+    // Publish from another thread and wait for it.
+    std::thread writer([&ring]()
+    {
+        write_block(ring, 0);
+        ring.close();
+    });
+    EXPECT_TRUE(reader.wait());
+    std::span<const uint32_t> view;
+    EXPECT_TRUE(reader.next(view));
+    writer.join();
+
+    // Verify a closed, caught up ring stops waiting.
+    EXPECT_FALSE(reader.wait());
+}
@@ -0,0 +1,108 @@
+// ads101x
+#include <ads101x/calibration.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cstdio>
+#include <fstream>
+
+// TABLES
+TEST(calibration, default_voltage)
+{
+    // Create calibration and select a configuration with no transform.
+    ads101x::calibration calibration;
+    ads101x::configuration config;
+    config.set_fsr(ads101x::configuration::fsr::FSR_4_096);
+    calibration.select(config);
+
+    // Verify conversions calibrate to volts.
+    EXPECT_FLOAT_EQ(calibration.apply(1024), 2.048f);
+    EXPECT_FLOAT_EQ(calibration.apply(0x0800), -4.096f);
+}
+TEST(calibration, polynomial)
+{
+    // Create calibration with an offset and gain for AIN1_GND at +/- 2.048V.
+    ads101x::calibration calibration;
+    calibration.set_polynomial(ads101x::configuration::multiplexer::AIN1_GND, ads101x::configuration::fsr::FSR_2_048, {0.5, 2.0});
+
+    // Select the calibrated channel.
+    ads101x::configuration config;
+    config.set_multiplexer(ads101x::configuration::multiplexer::AIN1_GND);
+    config.set_fsr(ads101x::configuration::fsr::FSR_2_048);
+    calibration.select(config);
+
+    // Verify single and block application.
+    EXPECT_FLOAT_EQ(calibration.apply(1024), 0.5f + 2.0f * 1.024f);
+    uint16_t conversions[3] = {0, 1024, 0x0800};
+    float output[3];
+    calibration.apply(conversions, output, 3);
+    EXPECT_FLOAT_EQ(output[0], 0.5f);
+    EXPECT_FLOAT_EQ(output[1], 0.5f + 2.0f * 1.024f);
+    EXPECT_FLOAT_EQ(output[2], 0.5f - 2.0f * 2.048f);
+}
+TEST(calibration, rebuild_selected)
+{
+    // Create calibration and select default channel.
+    ads101x::calibration calibration;
+    ads101x::configuration config;
+    calibration.select(config);
+
+    // Change the transform of the selected channel.
+    calibration.set_transform(config.get_multiplexer(), config.get_fsr(), [](double voltage) { return voltage * 10.0; });
+
+    // Verify the selected table was rebuilt.
+    EXPECT_FLOAT_EQ(calibration.apply(1024), 10.24f);
+}
+TEST(calibration, sample_fsr)
+{
+    // Create calibration with gain on two ranges of the default multiplexer.
+    ads101x::calibration calibration;
+    ads101x::configuration config;
+    calibration.set_polynomial(config.get_multiplexer(), ads101x::configuration::fsr::FSR_0_256, {0.0, 2.0});
+    calibration.set_polynomial(config.get_multiplexer(), ads101x::configuration::fsr::FSR_4_096, {0.0, 3.0});
+
+    // Verify the sample's own range selects the table, through a const calibration as used on the acquisition thread.
+    const ads101x::calibration& selected = calibration;
+    EXPECT_FLOAT_EQ(selected.apply(ads101x::sample(1024, ads101x::configuration::fsr::FSR_0_256)), 0.256f);
+    EXPECT_FLOAT_EQ(selected.apply(ads101x::sample(1024, ads101x::configuration::fsr::FSR_4_096)), 6.144f);
+    EXPECT_FLOAT_EQ(selected.apply(ads101x::sample(1024, ads101x::configuration::fsr::FSR_2_048)), 1.024f);
+}
+TEST(calibration, load)
+{
+    // Write a calibration file.
+    std::string path = "ads101x_calibration_test.txt";
+    std::ofstream file(path);
+    file << "# multiplexer fsr coefficients" << std::endl;
+    file << "AIN2_GND * 1.0 1.0" << std::endl;
+    file << "AIN3_GND FSR_1_024 0.0 0.0 1.0" << std::endl;
+    file.close();
+
+    // Load calibration file.
+    ads101x::calibration calibration;
+    calibration.load(path);
+
+    // Verify wildcard entry.
+    ads101x::configuration config;
+    config.set_multiplexer(ads101x::configuration::multiplexer::AIN2_GND);
+    config.set_fsr(ads101x::configuration::fsr::FSR_0_512);
+    calibration.select(config);
+    EXPECT_FLOAT_EQ(calibration.apply(1024), 1.256f);
+
+    // Verify quadratic entry.
+    config.set_multiplexer(ads101x::configuration::multiplexer::AIN3_GND);
+    config.set_fsr(ads101x::configuration::fsr::FSR_1_024);
+    calibration.select(config);
+    EXPECT_FLOAT_EQ(calibration.apply(1024), 0.512f * 0.512f);
+
+    // Verify invalid files are rejected without applying their valid lines.
+    file.open(path);
+    file << "AIN3_GND FSR_1_024 5.0" << std::endl;
+    file << "AIN9_GND FSR_1_024 0.0" << std::endl;
+    file.close();
+    EXPECT_THROW(calibration.load(path), std::runtime_error);
+    EXPECT_FLOAT_EQ(calibration.apply(1024), 0.512f * 0.512f);
+    std::remove(path.c_str());
+    EXPECT_THROW(calibration.load(path), std::runtime_error);
+}
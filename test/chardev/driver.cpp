@@ -0,0 +1,284 @@
+// ads101x
+#include <ads101x/chardev/driver.hpp>
+#include <ads101x/clock.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// posix
+#include <linux/gpio.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <unistd.h>
+
+// Create simulated I2C adapter and GPIO chip. Line events are delivered through a pipe.
+class mock_io
+    : public ads101x::chardev::io
+{
+public:
+    // CONSTRUCTORS
+    mock_io()
+        : registers{0, 0, 0, 0},
+          pointer(0),
+          transactions(0),
+          failures(0),
+          line_offset(0),
+          line_flags(0)
+    {
+        pipe(events);
+    }
+    ~mock_io()
+    {
+        ::close(events[1]);
+    }
+
+    // STATE
+    uint16_t registers[4];
+    uint8_t pointer;
+    uint32_t transactions;
+    uint32_t failures;
+    uint32_t line_offset;
+    uint64_t line_flags;
+    int32_t events[2];
+
+    // EVENTS
+    void edge(bool rising, uint64_t timestamp, uint32_t sequence)
+    {
+        gpio_v2_line_event event;
+        std::memset(&event, 0, sizeof(event));
+        event.timestamp_ns = timestamp;
+        event.id = rising ? GPIO_V2_LINE_EVENT_RISING_EDGE : GPIO_V2_LINE_EVENT_FALLING_EDGE;
+        event.line_seqno = sequence;
+        ::write(mock_io::events[1], &event, sizeof(event));
+    }
+    void edges(std::span<const bool> rising, uint64_t timestamp, uint32_t sequence)
+    {
+        // Queue all edges with a single write, so they are read as one batch.
+        std::vector<gpio_v2_line_event> events(rising.size());
+        std::memset(events.data(), 0, events.size() * sizeof(gpio_v2_line_event));
+        for(size_t i = 0; i < events.size(); ++i)
+        {
+            events[i].timestamp_ns = timestamp + i;
+            events[i].id = rising[i] ? GPIO_V2_LINE_EVENT_RISING_EDGE : GPIO_V2_LINE_EVENT_FALLING_EDGE;
+            events[i].line_seqno = sequence + i;
+        }
+        ::write(mock_io::events[1], events.data(), events.size() * sizeof(gpio_v2_line_event));
+    }
+
+    // SYSTEM CALLS
+    int32_t open(const char* path, int32_t flags) override
+    {
+        return (std::strncmp(path, "/dev/i2c-", 9) == 0) ? 100 : 101;
+    }
+    int32_t close(int32_t descriptor) override
+    {
+        return (descriptor == mock_io::events[0]) ? ::close(descriptor) : 0;
+    }
+    int32_t ioctl(int32_t descriptor, unsigned long request, void* argument) override
+    {
+        if(request == I2C_RDWR)
+        {
+            // Fail with lost arbitration while failures are pending.
+            mock_io::transactions++;
+            if(mock_io::failures > 0)
+            {
+                mock_io::failures--;
+                errno = EAGAIN;
+                return -1;
+            }
+
+            // Execute each message against the register file.
+            i2c_rdwr_ioctl_data* transaction = static_cast<i2c_rdwr_ioctl_data*>(argument);
+            for(uint32_t i = 0; i < transaction->nmsgs; ++i)
+            {
+                i2c_msg& message = transaction->msgs[i];
+                if(message.flags & I2C_M_RD)
+                {
+                    message.buf[0] = mock_io::registers[mock_io::pointer] >> 8;
+                    message.buf[1] = mock_io::registers[mock_io::pointer] & 0xFF;
+                }
+                else
+                {
+                    mock_io::pointer = message.buf[0];
+                    if(message.len == 3)
+                    {
+                        mock_io::registers[mock_io::pointer] = (message.buf[1] << 8) | message.buf[2];
+                    }
+                }
+            }
+            return 0;
+        }
+        if(request == GPIO_V2_GET_LINE_IOCTL)
+        {
+            // Grant the line request with the pipe.
+            gpio_v2_line_request* line = static_cast<gpio_v2_line_request*>(argument);
+            mock_io::line_offset = line->offsets[0];
+            mock_io::line_flags = line->config.flags;
+            line->fd = mock_io::events[0];
+            return 0;
+        }
+        return -1;
+    }
+};
+
+// REGISTERS
+TEST(chardev, registers)
+{
+    // Create driver on the mock.
+    mock_io io;
+    ads101x::chardev::driver driver("/dev/gpiochip0", io);
+    driver.start(1);
+
+    // Verify configuration round trip.
+    ads101x::configuration config(0x4283);
+    driver.write_config(config);
+    EXPECT_EQ(io.registers[1], 0x4283);
+    EXPECT_EQ(driver.read_config().bitfield(), 0x4283);
+
+    // Verify block reads are batched into few transactions.
+    io.registers[0] = 0x0AB0;
+    io.transactions = 0;
+    std::vector<uint16_t> conversions(100);
+    driver.read_conversions(conversions);
+    EXPECT_EQ(io.transactions, 3);
+    for(auto conversion : conversions)
+    {
+        EXPECT_EQ(conversion, 0x00AB);
+    }
+}
+
+TEST(chardev, deadline)
+{
+    // Create driver on the mock.
+    mock_io io;
+    ads101x::chardev::driver driver("/dev/gpiochip0", io);
+    driver.start(1);
+    io.registers[0] = 0x0AB0;
+
+    // Verify an unbounded read reports the first failure.
+    io.failures = 1;
+    EXPECT_THROW(driver.read_conversion(), std::runtime_error);
+
+    // Verify a bounded read retries transient failures.
+    driver.set_timeout(100000000);
+    io.failures = 3;
+    io.transactions = 0;
+    EXPECT_EQ(driver.read_conversion(), 0x00AB);
+    EXPECT_EQ(io.transactions, 4);
+
+    // Verify retries stop at the deadline.
+    io.failures = UINT32_MAX;
+    uint64_t deadline = ads101x::monotonic_ns() + 10000000;
+    EXPECT_THROW(driver.read_conversion(deadline), ads101x::timeout_error);
+    EXPECT_GE(ads101x::monotonic_ns(), deadline);
+    io.failures = 0;
+
+    // Verify an expired deadline is not issued.
+    io.transactions = 0;
+    EXPECT_THROW(driver.write_config(ads101x::configuration(0x4283), ads101x::monotonic_ns() - 1), ads101x::timeout_error);
+    EXPECT_EQ(io.transactions, 0);
+}
+
+// ALERT_RDY
+TEST(chardev, alert_rdy)
+{
+    // Create driver on the mock.
+    mock_io io;
+    ads101x::chardev::driver driver("/dev/gpiochip0", io);
+
+    // Record each edge with its timestamp.
+    std::atomic<uint32_t> edges(0);
+    std::atomic<bool> level(true);
+    std::atomic<uint64_t> timestamp(0);
+    driver.attach_alert_rdy(17, [&](bool value)
+    {
+        level = value;
+        timestamp = driver.alert_rdy_timestamp();
+        edges++;
+    });
+
+    // Verify the line was requested with edge detection on both edges.
+    EXPECT_EQ(io.line_offset, 17);
+    EXPECT_TRUE(io.line_flags & GPIO_V2_LINE_FLAG_EDGE_RISING);
+    EXPECT_TRUE(io.line_flags & GPIO_V2_LINE_FLAG_EDGE_FALLING);
+
+    // Deliver a falling edge, then a rising edge after two lost edges.
+    io.edge(false, 1000, 1);
+    io.edge(true, 2000, 4);
+    for(uint32_t i = 0; i < 100 && edges < 2; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Verify the edges were raised with the kernel timestamps.
+    EXPECT_EQ(edges, 2);
+    EXPECT_TRUE(level);
+    EXPECT_EQ(timestamp, 2000);
+    EXPECT_EQ(driver.lost_edges(), 2);
+    driver.detach_alert_rdy();
+}
+TEST(chardev, alert_rdy_batch)
+{
+    // Create driver on the mock.
+    mock_io io;
+    ads101x::chardev::driver driver("/dev/gpiochip0", io);
+
+    // Record each batch of falling edges.
+    std::atomic<uint32_t> batches(0);
+    std::atomic<uint32_t> edges(0);
+    std::atomic<uint64_t> timestamp(0);
+    driver.attach_alert_rdy_batch(17, [&](std::span<const ads101x::edge_event> events)
+    {
+        timestamp = events.back().timestamp;
+        edges += events.size();
+        batches++;
+    }, ads101x::edge::FALLING);
+
+    // Verify the line was requested with edge detection on the falling edge only.
+    EXPECT_FALSE(io.line_flags & GPIO_V2_LINE_FLAG_EDGE_RISING);
+    EXPECT_TRUE(io.line_flags & GPIO_V2_LINE_FLAG_EDGE_FALLING);
+
+    // Queue a burst of edges at once.
+    const bool rising[4] = {false, true, false, false};
+    io.edges(rising, 1000, 1);
+    for(uint32_t i = 0; i < 100 && edges < 3; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Verify the falling edges were delivered in one batch with the kernel timestamps.
+    EXPECT_EQ(batches, 1);
+    EXPECT_EQ(edges, 3);
+    EXPECT_EQ(timestamp, 1003);
+    driver.detach_alert_rdy();
+}
+TEST(chardev, watchdog)
+{
+    // Create driver on the mock.
+    mock_io io;
+    ads101x::chardev::driver driver("/dev/gpiochip0", io);
+
+    // Count stalls with a short watchdog.
+    std::atomic<uint32_t> stalls(0);
+    driver.attach_alert_rdy(17, [](bool) {});
+    driver.set_alert_rdy_watchdog(5, [&stalls]() { stalls++; });
+
+    // Verify stalls are raised repeatedly while no edges arrive.
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_GE(stalls, 2);
+
+    // Verify disarming stops the stalls.
+    driver.set_alert_rdy_watchdog(0, nullptr);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    uint32_t disarmed = stalls;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(stalls, disarmed);
+    driver.detach_alert_rdy();
+}
@@ -143,4 +143,17 @@ TEST(configuration, comparator_queue)
     config.set_comparator_queue(value);
     EXPECT_EQ(config.get_comparator_queue(), value);
     EXPECT_EQ(config.bitfield(), static_cast<uint16_t>(value));
-}
\ No newline at end of file
+}
+// FIELD ISOLATION
+TEST(configuration, field_isolation)
+{
+    // Create default configuration.
+    ads101x::configuration config;
+
+    // Change the full-scale range.
+    config.set_fsr(ads101x::configuration::fsr::FSR_0_256);
+
+    // Verify only the FSR bits changed.
+    EXPECT_EQ(config.bitfield(), (0x0583 & ~0x0E00) | static_cast<uint16_t>(ads101x::configuration::fsr::FSR_0_256));
+    EXPECT_EQ(config.get_comparator_queue(), ads101x::configuration::comparator_queue::DISABLED);
+}
@@ -0,0 +1,258 @@
+// ads101x
+#include <ads101x/daemon/client.hpp>
+#include <ads101x/daemon/server.hpp>
+#include <ads101x/simulator/driver.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <atomic>
+#include <thread>
+
+// posix
+#include <sys/socket.h>
+#include <unistd.h>
+
+/// \brief Gets a daemon socket path unique to this test process.
+std::string socket_path(const std::string& test)
+{
+    return "/tmp/ads101x_test_" + test + "_" + std::to_string(getpid()) + ".sock";
+}
+
+/// \brief A simulated device that fails to start continuous conversions on rejected channels.
+struct rejecting_driver
+    : public ads101x::driver
+{
+    // CONSTRUCTORS
+    rejecting_driver()
+        : rejected(ads101x::configuration::multiplexer::AIN3_GND),
+          reject_all(false)
+    {}
+
+    // OVERRIDES
+    void open_i2c(uint32_t i2c_bus, uint8_t i2c_address) override
+    {}
+    void close_i2c() override
+    {}
+    void write_register(uint8_t register_address, uint16_t value) const override
+    {
+        switch(static_cast<ads101x::register_address>(register_address))
+        {
+            case ads101x::register_address::CONFIG:
+            {
+                ads101x::configuration configuration(value);
+                if(configuration.get_mode() == ads101x::configuration::mode::CONTINUOUS && (rejecting_driver::reject_all || configuration.get_multiplexer() == rejecting_driver::rejected))
+                {
+                    throw std::runtime_error("write failed");
+                }
+                rejecting_driver::simulator.write_config(configuration);
+                break;
+            }
+            case ads101x::register_address::LO_THRESH:
+                rejecting_driver::simulator.write_lo_thresh(value >> 4);
+                break;
+            case ads101x::register_address::HI_THRESH:
+                rejecting_driver::simulator.write_hi_thresh(value >> 4);
+                break;
+            default:
+                break;
+        }
+    }
+    uint16_t read_register(uint8_t register_address) const override
+    {
+        switch(static_cast<ads101x::register_address>(register_address))
+        {
+            case ads101x::register_address::CONVERSION:
+                return rejecting_driver::simulator.read_conversion() << 4;
+            case ads101x::register_address::CONFIG:
+                return rejecting_driver::simulator.read_config().bitfield();
+            case ads101x::register_address::LO_THRESH:
+                return rejecting_driver::simulator.read_lo_thresh() << 4;
+            default:
+                return rejecting_driver::simulator.read_hi_thresh() << 4;
+        }
+    }
+
+    // STATE
+    ads101x::simulator::driver simulator;
+    std::atomic<ads101x::configuration::multiplexer> rejected;
+    std::atomic<bool> reject_all;
+};
+
+// STREAMING
+TEST(daemon, subscribe)
+{
+    // Create a server for one simulated device.
+    ads101x::simulator::driver driver;
+    driver.set_input(ads101x::configuration::multiplexer::AIN1_GND, 0.5);
+    driver.start();
+    ads101x::daemon::server server(socket_path("subscribe"));
+    server.add_device(driver, -1, 8);
+    std::thread thread(&ads101x::daemon::server::run, &server);
+
+    // Configure the stream and subscribe two clients.
+    ads101x::daemon::client first(socket_path("subscribe"));
+    ads101x::daemon::client second(socket_path("subscribe"));
+    ads101x::configuration config;
+    config.set_multiplexer(ads101x::configuration::multiplexer::AIN1_GND);
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    first.configure(0, config);
+    first.subscribe(0);
+    second.subscribe(0);
+
+    // Verify both clients are pushed the same shared stream.
+    uint16_t device;
+    std::vector<ads101x::sample> samples;
+    ASSERT_TRUE(first.receive(device, samples, std::chrono::seconds(5)));
+    EXPECT_EQ(device, 0);
+    EXPECT_EQ(samples.size(), 8);
+    EXPECT_EQ(samples[0].channel, ads101x::configuration::multiplexer::AIN1_GND);
+    EXPECT_NEAR(samples[0].voltage(), 0.5, 0.002);
+    ASSERT_TRUE(second.receive(device, samples, std::chrono::seconds(5)));
+    EXPECT_EQ(server.clients(), 2);
+
+    // Verify single-shots on the streamed channel are answered from the stream, and others are refused.
+    EXPECT_NEAR(second.singleshot(0, config).voltage(), 0.5, 0.002);
+    EXPECT_EQ(server.conversions(), 0);
+    EXPECT_EQ(server.coalesced(), 1);
+    ads101x::configuration other = config;
+    other.set_multiplexer(ads101x::configuration::multiplexer::AIN2_GND);
+    EXPECT_THROW(second.singleshot(0, other), std::runtime_error);
+
+    // Verify invalid devices are rejected.
+    EXPECT_THROW(first.subscribe(3), std::runtime_error);
+
+    server.stop();
+    thread.join();
+}
+
+TEST(daemon, configure_failure)
+{
+    // Create a server for one simulated device that rejects streams on AIN3.
+    rejecting_driver driver;
+    driver.simulator.set_input(ads101x::configuration::multiplexer::AIN1_GND, 0.5);
+    driver.simulator.start();
+    ads101x::daemon::server server(socket_path("configure_failure"));
+    server.add_device(driver, -1, 8);
+    std::thread thread(&ads101x::daemon::server::run, &server);
+
+    // Stream AIN1 to a subscriber.
+    ads101x::daemon::client client(socket_path("configure_failure"));
+    ads101x::configuration config;
+    config.set_multiplexer(ads101x::configuration::multiplexer::AIN1_GND);
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    client.configure(0, config);
+    client.subscribe(0);
+    uint16_t device;
+    std::vector<ads101x::sample> samples;
+    ASSERT_TRUE(client.receive(device, samples, std::chrono::seconds(5)));
+
+    // Verify a configuration the device rejects fails, and the previous stream is restored.
+    ads101x::configuration rejected = config;
+    rejected.set_multiplexer(ads101x::configuration::multiplexer::AIN3_GND);
+    EXPECT_THROW(client.configure(0, rejected), std::runtime_error);
+    EXPECT_NEAR(client.singleshot(0, config).voltage(), 0.5, 0.002);
+    ASSERT_TRUE(client.receive(device, samples, std::chrono::seconds(5)));
+    EXPECT_EQ(samples.back().channel, ads101x::configuration::multiplexer::AIN1_GND);
+
+    // Verify the subscriber is told the stream stopped when the previous stream cannot be restored either.
+    driver.reject_all = true;
+    EXPECT_THROW(client.configure(0, rejected), std::runtime_error);
+    bool stopped = false;
+    try
+    {
+        while(client.receive(device, samples, std::chrono::seconds(5)))
+        {}
+    }
+    catch(const std::runtime_error&)
+    {
+        stopped = true;
+    }
+    EXPECT_TRUE(stopped);
+
+    server.stop();
+    thread.join();
+}
+
+// SINGLESHOT
+TEST(daemon, coalesce)
+{
+    // Create a server for one simulated device.
+    ads101x::simulator::driver driver;
+    driver.set_input(ads101x::configuration::multiplexer::AIN0_GND, 1.5);
+    driver.start();
+    ads101x::daemon::server server(socket_path("coalesce"));
+    server.add_device(driver);
+
+    // Queue identical single-shot requests from two clients before the server runs, so they arrive together.
+    ads101x::daemon::client first(socket_path("coalesce"));
+    ads101x::daemon::client second(socket_path("coalesce"));
+    ads101x::configuration config;
+    config.set_multiplexer(ads101x::configuration::multiplexer::AIN0_GND);
+    config.set_fsr(ads101x::configuration::fsr::FSR_4_096);
+    ads101x::daemon::request request = {ads101x::daemon::command::SINGLESHOT, 0, config.bitfield(), 0, 7};
+    ASSERT_EQ(send(first.descriptor(), &request, sizeof(request), 0), sizeof(request));
+    ASSERT_EQ(send(second.descriptor(), &request, sizeof(request), 0), sizeof(request));
+    std::thread thread(&ads101x::daemon::server::run, &server);
+
+    // Verify both were answered by one conversion.
+    ads101x::daemon::response first_response;
+    ads101x::daemon::response second_response;
+    ASSERT_EQ(recv(first.descriptor(), &first_response, sizeof(first_response), 0), sizeof(first_response));
+    ASSERT_EQ(recv(second.descriptor(), &second_response, sizeof(second_response), 0), sizeof(second_response));
+    EXPECT_EQ(first_response.status, ads101x::daemon::status::OK);
+    EXPECT_EQ(first_response.id, 7);
+    EXPECT_NEAR(first_response.sample.voltage(), 1.5, 0.002);
+    EXPECT_EQ(first_response.sample.sequence, second_response.sample.sequence);
+    EXPECT_EQ(server.conversions(), 1);
+    EXPECT_EQ(server.coalesced(), 1);
+
+    // Verify a later request takes a new conversion.
+    EXPECT_NEAR(first.singleshot(0, config).voltage(), 1.5, 0.002);
+    EXPECT_EQ(server.conversions(), 2);
+
+    server.stop();
+    thread.join();
+}
+TEST(daemon, singleshot_concurrency)
+{
+    // Create a server for two simulated devices.
+    ads101x::simulator::driver slow;
+    slow.set_input(ads101x::configuration::multiplexer::AIN0_GND, 1.0);
+    slow.start();
+    ads101x::simulator::driver fast;
+    fast.set_input(ads101x::configuration::multiplexer::AIN0_GND, 2.0);
+    fast.start();
+    ads101x::daemon::server server(socket_path("singleshot_concurrency"));
+    server.add_device(slow);
+    server.add_device(fast);
+    std::thread thread(&ads101x::daemon::server::run, &server);
+
+    // Start a slow single-shot conversion on the first device.
+    ads101x::daemon::client first(socket_path("singleshot_concurrency"));
+    ads101x::daemon::client second(socket_path("singleshot_concurrency"));
+    ads101x::configuration config;
+    config.set_multiplexer(ads101x::configuration::multiplexer::AIN0_GND);
+    config.set_fsr(ads101x::configuration::fsr::FSR_4_096);
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_128);
+    ads101x::daemon::request request = {ads101x::daemon::command::SINGLESHOT, 0, config.bitfield(), 0, 3};
+    ASSERT_EQ(send(first.descriptor(), &request, sizeof(request), 0), sizeof(request));
+
+    // Verify the second device is served while the first converts.
+    ads101x::configuration fast_config = config;
+    fast_config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    EXPECT_NEAR(second.singleshot(1, fast_config).voltage(), 2.0, 0.002);
+    ads101x::daemon::response response;
+    EXPECT_EQ(recv(first.descriptor(), &response, sizeof(response), MSG_DONTWAIT), -1);
+
+    // Verify the slow conversion is answered once it completes.
+    ASSERT_EQ(recv(first.descriptor(), &response, sizeof(response), 0), sizeof(response));
+    EXPECT_EQ(response.status, ads101x::daemon::status::OK);
+    EXPECT_EQ(response.id, 3);
+    EXPECT_NEAR(response.sample.voltage(), 1.0, 0.002);
+    EXPECT_EQ(server.conversions(), 2);
+
+    server.stop();
+    thread.join();
+}
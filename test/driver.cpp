@@ -4,6 +4,9 @@
 // gtest
 #include <gtest/gtest.h>
 
+// std
+#include <vector>
+
 // Create test driver object.
 struct test_driver
     : public ads101x::driver
@@ -74,6 +77,10 @@ struct test_driver
     {
         test_driver::raise_interrupt(pin, level);
     }
+    void simulate_interrupts(uint16_t pin, std::span<ads101x::edge_event> events)
+    {
+        test_driver::raise_interrupts(pin, events);
+    }
 
     // STATE: I2C
     uint32_t i2c_bus;
@@ -191,6 +198,23 @@ TEST(driver, read_conversion)
     // Verify read value.
     EXPECT_EQ(conversion, conversion_value);
 }
+TEST(driver, read_conversions)
+{
+    // Create test driver.
+    test_driver driver;
+    driver.read_value = 0x0AAA << 4;
+
+    // Read a block of conversions.
+    uint16_t conversions[16];
+    driver.read_conversions(conversions);
+
+    // Verify the block was read from the conversion register.
+    EXPECT_EQ(driver.read_address, static_cast<uint8_t>(ads101x::register_address::CONVERSION));
+    for(auto conversion : conversions)
+    {
+        EXPECT_EQ(conversion, 0x0AAA);
+    }
+}
 
 // THRESHOLDS
 TEST(driver, write_lo_thresh)
@@ -297,4 +321,53 @@ TEST(driver, alert_rdy)
     // Verify that interrupt is detached.
     EXPECT_EQ(driver.interrupt_pin_detach, alert_rdy_pin);
     EXPECT_FALSE(driver.interrupt_attached);
-}
\ No newline at end of file
+}
+TEST(driver, alert_rdy_edge)
+{
+    // Create test driver.
+    test_driver driver;
+
+    // Count falling edges only.
+    uint32_t edges = 0;
+    driver.attach_alert_rdy(8, [&edges](bool level) { EXPECT_FALSE(level); edges++; }, ads101x::edge::FALLING);
+
+    // Simulate both edges and verify only the falling edge raised the callback.
+    driver.simulate_interrupt(8, true);
+    driver.simulate_interrupt(8, false);
+    EXPECT_EQ(edges, 1);
+
+    // Detach alert_rdy.
+    driver.detach_alert_rdy();
+}
+TEST(driver, alert_rdy_batch)
+{
+    // Create test driver.
+    test_driver driver;
+
+    // Record each batch of rising edges.
+    std::vector<std::vector<uint64_t>> batches;
+    driver.attach_alert_rdy_batch(8, [&batches](std::span<const ads101x::edge_event> events)
+    {
+        std::vector<uint64_t> batch;
+        for(const auto& event : events)
+        {
+            EXPECT_TRUE(event.level);
+            batch.push_back(event.timestamp);
+        }
+        batches.push_back(batch);
+    }, ads101x::edge::RISING);
+
+    // Simulate a burst of edges, and verify the rising edges were delivered as one batch with their timestamps.
+    ads101x::edge_event events[4] = {{true, 100}, {false, 200}, {true, 300}, {false, 400}};
+    driver.simulate_interrupts(8, events);
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_EQ(batches[0], std::vector<uint64_t>({100, 300}));
+
+    // Simulate a burst of falling edges only, and verify no batch was delivered.
+    ads101x::edge_event falling[1] = {{false, 500}};
+    driver.simulate_interrupts(8, falling);
+    EXPECT_EQ(batches.size(), 1);
+
+    // Detach alert_rdy.
+    driver.detach_alert_rdy();
+}
@@ -0,0 +1,96 @@
+// ads101x
+#include <ads101x/acquisition.hpp>
+#include <ads101x/event.hpp>
+#include <ads101x/simulator/driver.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// posix
+#include <poll.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+// Waits up to one second for an event's descriptor to become readable through epoll.
+bool wait_readable(const ads101x::event& event)
+{
+    int32_t epoll = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event registration = {};
+    registration.events = EPOLLIN;
+    epoll_ctl(epoll, EPOLL_CTL_ADD, event.descriptor(), &registration);
+    epoll_event ready;
+    int32_t count = epoll_wait(epoll, &ready, 1, 1000);
+    close(epoll);
+    return count == 1;
+}
+
+// EVENT
+TEST(event, signal)
+{
+    // Create event.
+    ads101x::event event;
+
+    // Verify the descriptor is not readable until signalled.
+    pollfd descriptor = {event.descriptor(), POLLIN, 0};
+    EXPECT_EQ(poll(&descriptor, 1, 0), 0);
+    EXPECT_EQ(event.consume(), 0);
+
+    // Verify signals accumulate until consumed.
+    event.signal();
+    event.signal(2);
+    EXPECT_EQ(poll(&descriptor, 1, 0), 1);
+    EXPECT_EQ(event.consume(), 3);
+    EXPECT_EQ(poll(&descriptor, 1, 0), 0);
+}
+
+// ALERT_RDY
+TEST(event, alert_rdy)
+{
+    // Create simulated device with ALERT/RDY in conversion-ready mode.
+    ads101x::simulator::driver driver;
+    driver.start();
+    ads101x::event event;
+    driver.attach_alert_rdy(4, event, false);
+    driver.write_hi_thresh(0x0800);
+    driver.write_lo_thresh(0x0000);
+
+    // Run continuous conversions.
+    ads101x::configuration config;
+    config.set_mode(ads101x::configuration::mode::CONTINUOUS);
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    config.set_comparator_queue(ads101x::configuration::comparator_queue::AFTER_1);
+    driver.write_config(config);
+
+    // Verify conversion-ready assertions are delivered through the descriptor.
+    ASSERT_TRUE(wait_readable(event));
+    EXPECT_GE(event.consume(), 1);
+    driver.detach_alert_rdy();
+}
+
+// SAMPLES
+TEST(event, acquisition)
+{
+    // Create simulated device.
+    ads101x::simulator::driver driver;
+    driver.set_input(ads101x::configuration::multiplexer::AIN0_GND, 1.0);
+    driver.start();
+
+    // Signal an event for each published block.
+    ads101x::event event;
+    ads101x::acquisition acquisition(driver, 4, 16);
+    ads101x::configuration config;
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    acquisition.set_configuration(config);
+    acquisition.set_event(&event);
+    auto reader = acquisition.subscribe();
+    acquisition.start();
+
+    // Verify blocks can be drained once the descriptor is readable.
+    ASSERT_TRUE(wait_readable(event));
+    EXPECT_GE(event.consume(), 1);
+    std::span<const ads101x::sample> block;
+    ASSERT_TRUE(reader.next(block));
+    EXPECT_EQ(block.size(), 4);
+    EXPECT_EQ(block[0].value, 1000);
+    acquisition.stop();
+}
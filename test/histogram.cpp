@@ -0,0 +1,57 @@
+// ads101x
+#include <ads101x/histogram.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <sstream>
+
+// STATISTICS
+TEST(histogram, empty)
+{
+    ads101x::histogram histogram;
+    EXPECT_EQ(histogram.count(), 0);
+    EXPECT_EQ(histogram.min(), 0);
+    EXPECT_EQ(histogram.max(), 0);
+    EXPECT_EQ(histogram.percentile(50), 0);
+}
+TEST(histogram, exact)
+{
+    // Small values are counted exactly.
+    ads101x::histogram histogram;
+    for(uint64_t i = 1; i <= 20; ++i)
+    {
+        histogram.record(i);
+    }
+    EXPECT_EQ(histogram.count(), 20);
+    EXPECT_EQ(histogram.min(), 1);
+    EXPECT_EQ(histogram.max(), 20);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 10.5);
+    EXPECT_EQ(histogram.percentile(50), 10);
+    EXPECT_EQ(histogram.percentile(100), 20);
+}
+TEST(histogram, relative_error)
+{
+    // Large values are bucketed within 1/16 of their magnitude.
+    ads101x::histogram histogram;
+    for(uint64_t i = 1; i <= 1000; ++i)
+    {
+        histogram.record(i * 1000);
+    }
+    EXPECT_NEAR(histogram.percentile(50), 500000, 500000 / 16);
+    EXPECT_NEAR(histogram.percentile(99), 990000, 990000 / 16);
+    EXPECT_EQ(histogram.percentile(100), 1000000);
+    EXPECT_EQ(histogram.max(), 1000000);
+
+    // Verify extreme values do not overflow the buckets.
+    histogram.record(UINT64_MAX);
+    EXPECT_EQ(histogram.max(), UINT64_MAX);
+
+    // Verify printing and reset.
+    std::stringstream stream;
+    histogram.print(stream);
+    EXPECT_FALSE(stream.str().empty());
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0);
+}
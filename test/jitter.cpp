@@ -0,0 +1,77 @@
+// ads101x
+#include <ads101x/clock.hpp>
+#include <ads101x/jitter.hpp>
+#include <ads101x/simulator/driver.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <sstream>
+#include <thread>
+
+/// \brief Measures an acquisition of the simulator for a short time.
+/// \return The number of samples acquired.
+uint64_t measure(ads101x::acquisition::mode mode, ads101x::jitter& jitter)
+{
+    ads101x::simulator::driver driver;
+    driver.start();
+    ads101x::acquisition acquisition(driver);
+    ads101x::configuration config;
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_1600);
+    acquisition.set_configuration(config);
+    acquisition.set_mode(mode);
+    acquisition.set_alert_rdy_pin(17);
+    jitter.attach(acquisition);
+    acquisition.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    acquisition.stop();
+    return acquisition.samples();
+}
+
+// MEASUREMENT
+TEST(jitter, record)
+{
+    // Verify intervals start from the second read, and early reads have no latency.
+    ads101x::jitter jitter;
+    jitter.record(1000, 1500);
+    jitter.record(2000, 1900);
+    EXPECT_EQ(jitter.intervals().count(), 1);
+    EXPECT_EQ(jitter.intervals().max(), 400);
+    EXPECT_EQ(jitter.latencies().count(), 2);
+    EXPECT_EQ(jitter.latencies().max(), 500);
+    EXPECT_EQ(jitter.latencies().min(), 0);
+
+    // Verify the summary.
+    std::stringstream stream;
+    jitter.print(stream, true);
+    EXPECT_NE(stream.str().find("p99.9="), std::string::npos);
+    jitter.reset();
+    EXPECT_EQ(jitter.intervals().count(), 0);
+}
+TEST(jitter, polling)
+{
+    // Verify every read was recorded. Interval and latency values depend on the host's load, so only their structure
+    // is checked: one latency per read, one interval per pair of reads, and no interval longer than the run.
+    ads101x::jitter jitter;
+    uint64_t start = ads101x::monotonic_ns();
+    uint64_t samples = measure(ads101x::acquisition::mode::POLLING, jitter);
+    uint64_t elapsed = ads101x::monotonic_ns() - start;
+    ASSERT_GT(samples, 1);
+    EXPECT_EQ(jitter.latencies().count(), samples);
+    EXPECT_EQ(jitter.intervals().count(), samples - 1);
+    EXPECT_LE(jitter.intervals().max(), elapsed);
+}
+TEST(jitter, data_ready)
+{
+    // Verify every read on a conversion-ready edge was recorded.
+    ads101x::jitter jitter;
+    uint64_t start = ads101x::monotonic_ns();
+    uint64_t samples = measure(ads101x::acquisition::mode::DATA_READY, jitter);
+    uint64_t elapsed = ads101x::monotonic_ns() - start;
+    ASSERT_GT(samples, 1);
+    EXPECT_EQ(jitter.latencies().count(), samples);
+    EXPECT_EQ(jitter.intervals().count(), samples - 1);
+    EXPECT_LE(jitter.intervals().max(), elapsed);
+    EXPECT_LE(jitter.latencies().max(), elapsed);
+}
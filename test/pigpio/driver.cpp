@@ -4,6 +4,9 @@
 // gtest
 #include <gtest/gtest.h>
 
+// std
+#include <atomic>
+
 // PARAMATERS
 // NOTE: These may be overridden by compiler options.
 #ifndef TEST_I2C_BUS
@@ -175,6 +178,68 @@ TEST(pigpio, alert_rdy)
     driver.stop();
 }
 
+TEST(pigpio, alert_rdy_isr)
+{
+    // Create driver using ISR interrupts on the active-low conversion-ready edge.
+    ads101x::pigpio::driver driver;
+    driver.set_interrupt_mode(ads101x::pigpio::driver::interrupt_mode::ISR);
+
+    // Start the driver.
+    driver.start(TEST_I2C_BUS, static_cast<ads101x::slave_address>(TEST_I2C_ADDRESS));
+
+    // Count conversion-ready assertions.
+    std::atomic<uint32_t> assertions(0);
+    driver.attach_alert_rdy(TEST_ALERT_RDY_PIN, [&assertions](bool level) { if(!level) assertions++; }, ads101x::edge::FALLING);
+
+    // Write lo_thresh/hi_thresh to put alert_rdy into conversion ready mode.
+    driver.write_hi_thresh(0b0000100000000000);
+    driver.write_lo_thresh(0b0000000000000000);
+
+    // Create configuration for single shot.
+    ads101x::configuration config;
+    config.set_operation(ads101x::configuration::operation::CONVERT);
+    config.set_multiplexer(ads101x::configuration::multiplexer::AIN0_GND);
+    config.set_fsr(ads101x::configuration::fsr::FSR_6_114);
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_128);
+
+    // Start conversion, and wait for it to finish.
+    driver.write_config(config);
+    usleep(50000);
+
+    // Verify the conversion-ready edge was delivered.
+    EXPECT_EQ(assertions, 1);
+
+    // Detach alert_rdy callback.
+    driver.detach_alert_rdy();
+
+    // Stop the driver.
+    driver.stop();
+}
+
+TEST(pigpio, alert_rdy_watchdog)
+{
+    // Create driver.
+    ads101x::pigpio::driver driver;
+
+    // Start the driver.
+    driver.start(TEST_I2C_BUS, static_cast<ads101x::slave_address>(TEST_I2C_ADDRESS));
+
+    // Attach alert_rdy, and arm the watchdog while no conversions are running.
+    std::atomic<uint32_t> stalls(0);
+    driver.attach_alert_rdy(TEST_ALERT_RDY_PIN, [](bool level) {});
+    driver.set_alert_rdy_watchdog(10, [&stalls]() { stalls++; });
+
+    // Verify the missing edges were reported as stalls.
+    usleep(50000);
+    EXPECT_GE(stalls, 2);
+
+    // Detach alert_rdy callback.
+    driver.detach_alert_rdy();
+
+    // Stop the driver.
+    driver.stop();
+}
+
 // TERMINATE
 TEST(pigpio, terminate)
 {
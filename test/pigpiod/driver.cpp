@@ -1,12 +1,19 @@
 // ads101x
 #include <ads101x/pigpiod/driver.hpp>
+#include <ads101x/simulator/driver.hpp>
+#include <ads101x/simulator/pigpiod_server.hpp>
 
 // pigpio
 #include <pigpio.h>
+#include <pigpiod_if2.h>
 
 // gtest
 #include <gtest/gtest.h>
 
+// std
+#include <atomic>
+#include <thread>
+
 // PARAMATERS
 // NOTE: These may be overridden by compiler options.
 #ifndef TEST_DAEMON_IP
@@ -190,6 +197,63 @@ TEST(pigpiod, alert_rdy)
     driver.stop();
 }
 
+// RECONNECT
+TEST(pigpiod, reconnect)
+{
+    // Serve a simulated device over the pigpiod protocol, so connection drops can be injected without a daemon.
+    ads101x::simulator::driver device;
+    device.start();
+    ads101x::simulator::pigpiod_server server(device, TEST_I2C_BUS, TEST_I2C_ADDRESS, TEST_ALERT_RDY_PIN);
+    std::thread thread(&ads101x::simulator::pigpiod_server::run, &server);
+
+    // Create a driver that opens its own connection.
+    ads101x::pigpiod::driver driver;
+    driver.pigpiod_connect("localhost", server.port());
+    driver.start(TEST_I2C_BUS, static_cast<ads101x::slave_address>(TEST_I2C_ADDRESS));
+
+    // Write thresholds and run a single-shot conversion, and attach alert_rdy.
+    std::atomic<uint32_t> edges(0);
+    driver.attach_alert_rdy(TEST_ALERT_RDY_PIN, [&edges](bool) { edges++; });
+    driver.write_hi_thresh(0b0000100000000000);
+    driver.write_lo_thresh(0b0000000000000000);
+    ads101x::configuration config;
+    config.set_operation(ads101x::configuration::operation::CONVERT);
+    config.set_mode(ads101x::configuration::mode::SINGLESHOT);
+    config.set_multiplexer(ads101x::configuration::multiplexer::AIN0_GND);
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    config.set_comparator_queue(ads101x::configuration::comparator_queue::AFTER_1);
+    driver.write_config(config);
+    usleep(5000);
+    uint64_t conversions = device.conversions();
+
+    // Drop the connection underneath the driver, and reset the device so only the restore can bring its registers back.
+    server.drop();
+    device.reset();
+
+    // Verify the next operation reconnects and restores the session, without starting another conversion.
+    EXPECT_EQ(driver.read_config().bitfield() & 0x7FFF, config.bitfield() & 0x7FFF);
+    EXPECT_EQ(driver.read_hi_thresh(), 0b0000100000000000);
+    EXPECT_EQ(driver.read_lo_thresh(), 0);
+    EXPECT_EQ(driver.reconnects(), 1);
+    EXPECT_GT(driver.reconnect_latency(), 0);
+    usleep(5000);
+    EXPECT_EQ(device.conversions(), conversions);
+
+    // Verify the alert_rdy callback was reattached.
+    edges = 0;
+    config.set_mode(ads101x::configuration::mode::CONTINUOUS);
+    driver.write_config(config);
+    usleep(50000);
+    EXPECT_GT(edges, 0);
+
+    // Stop the driver and the server.
+    driver.detach_alert_rdy();
+    driver.stop();
+    driver.pigpiod_disconnect();
+    server.stop();
+    thread.join();
+}
+
 // DISCONNECT
 TEST(pigpiod, disconnect)
 {
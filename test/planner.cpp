@@ -0,0 +1,123 @@
+// ads101x
+#include <ads101x/planner.hpp>
+#include <ads101x/simulator/driver.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// COST MODEL
+TEST(planner, cost_model)
+{
+    // Verify the wire time of each transaction at 400kHz: 38 bits per write and 48 bits per read.
+    ads101x::planner::cost_model model = {400000, 0};
+    EXPECT_EQ(model.write_ns(), 95000);
+    EXPECT_EQ(model.read_ns(), 120000);
+
+    // Verify the overhead is added to every transaction.
+    model.overhead_ns = 50000;
+    EXPECT_EQ(model.write_ns(), 145000);
+    EXPECT_EQ(model.read_ns(), 170000);
+}
+TEST(planner, calibrate)
+{
+    // Create a simulated device with a 200us transaction latency.
+    ads101x::simulator::driver driver;
+    driver.start();
+    driver.set_latency(std::chrono::microseconds(200));
+
+    // Verify the overhead covers the latency beyond the 120us wire time of a read at 400kHz.
+    ads101x::planner::cost_model model = ads101x::planner::cost_model::calibrate(driver, 400000, 16);
+    EXPECT_EQ(model.clock_hz, 400000);
+    EXPECT_GE(model.overhead_ns, 80000);
+    EXPECT_GE(model.read_ns(), 200000);
+}
+
+// PLANNING
+TEST(planner, feasible)
+{
+    // Plan two single-shot channels on one device, and a continuous channel at its data rate on another.
+    ads101x::planner planner({400000, 0});
+    std::vector<ads101x::planner::request> plan = {
+        {0, ads101x::configuration::multiplexer::AIN0_GND, ads101x::configuration::data_rate::SPS_3300, ads101x::configuration::mode::SINGLESHOT, 100},
+        {0, ads101x::configuration::multiplexer::AIN1_GND, ads101x::configuration::data_rate::SPS_3300, ads101x::configuration::mode::SINGLESHOT, 100},
+        {1, ads101x::configuration::multiplexer::AIN0_AIN1, ads101x::configuration::data_rate::SPS_1600, ads101x::configuration::mode::CONTINUOUS, 1600}};
+
+    // Verify the load: 200 * 215us of single-shot traffic and 1600 * 120us of continuous reads.
+    ads101x::planner::report report = planner.evaluate(plan);
+    EXPECT_TRUE(report.feasible);
+    EXPECT_NEAR(report.bus_utilisation, 0.235, 1e-9);
+    ASSERT_EQ(report.device_utilisation.size(), 2);
+    EXPECT_NEAR(report.device_utilisation[0], 200 * 549.4e-6, 1e-9);
+    EXPECT_NEAR(report.device_utilisation[1], 1, 1e-9);
+
+    // Verify the plan is admitted at the requested rates.
+    std::vector<double> rates = planner.admit(plan, ads101x::planner::policy::REJECT);
+    EXPECT_EQ(rates, std::vector<double>({100, 100, 1600}));
+}
+TEST(planner, bus_bound)
+{
+    // Plan four continuous devices at 3300SPS, which needs 158% of the bus.
+    ads101x::planner planner({400000, 0}, 0.8);
+    std::vector<ads101x::planner::request> plan;
+    for(uint32_t device = 0; device < 4; ++device)
+    {
+        plan.push_back({device, ads101x::configuration::multiplexer::AIN0_GND, ads101x::configuration::data_rate::SPS_3300, ads101x::configuration::mode::CONTINUOUS, 3300});
+    }
+    ads101x::planner::report report = planner.evaluate(plan);
+    EXPECT_FALSE(report.feasible);
+    EXPECT_NEAR(report.bus_utilisation, 1.584, 1e-9);
+
+    // Verify rejection, and that degrading scales every rate down to fit the utilisation limit.
+    EXPECT_THROW(planner.admit(plan, ads101x::planner::policy::REJECT), std::runtime_error);
+    std::vector<double> rates = planner.admit(plan, ads101x::planner::policy::DEGRADE);
+    ASSERT_EQ(rates.size(), 4);
+    for(auto rate : rates)
+    {
+        EXPECT_NEAR(rate, 3300 * 0.8 / 1.584, 1e-6);
+    }
+}
+TEST(planner, device_bound)
+{
+    // Plan two single-shot channels that need 110% of their device, and a continuous channel above its data rate.
+    ads101x::planner planner({400000, 0});
+    std::vector<ads101x::planner::request> plan = {
+        {0, ads101x::configuration::multiplexer::AIN0_GND, ads101x::configuration::data_rate::SPS_3300, ads101x::configuration::mode::SINGLESHOT, 1000},
+        {0, ads101x::configuration::multiplexer::AIN1_GND, ads101x::configuration::data_rate::SPS_3300, ads101x::configuration::mode::SINGLESHOT, 1000},
+        {1, ads101x::configuration::multiplexer::AIN0_GND, ads101x::configuration::data_rate::SPS_1600, ads101x::configuration::mode::CONTINUOUS, 2000}};
+    EXPECT_THROW(planner.admit(plan, ads101x::planner::policy::REJECT), std::runtime_error);
+
+    // Verify only the overloaded devices are degraded, each to fit its own time.
+    std::vector<double> rates = planner.admit(plan, ads101x::planner::policy::DEGRADE);
+    ASSERT_EQ(rates.size(), 3);
+    EXPECT_NEAR(rates[0], 1000 / 1.0988, 1e-6);
+    EXPECT_NEAR(rates[1], 1000 / 1.0988, 1e-6);
+    EXPECT_NEAR(rates[2], 1600, 1e-6);
+}
+TEST(planner, variant)
+{
+    // Plan a continuous channel at the ADS1115's 475SPS, which its SPS_3300 setting selects.
+    ads101x::planner planner({400000, 0});
+    std::vector<ads101x::planner::request> plan = {
+        {0, ads101x::configuration::multiplexer::AIN0_GND, ads101x::configuration::data_rate::SPS_3300, ads101x::configuration::mode::CONTINUOUS, 475, ads101x::variant::ADS1115}};
+
+    // Verify the device is fully used by the 16-bit data rate.
+    ads101x::planner::report report = planner.evaluate(plan);
+    EXPECT_TRUE(report.feasible);
+    EXPECT_NEAR(report.device_utilisation[0], 1, 1e-9);
+    plan[0].rate = 500;
+    EXPECT_THROW(planner.admit(plan, ads101x::planner::policy::REJECT), std::runtime_error);
+}
+TEST(planner, invalid)
+{
+    ads101x::planner planner({400000, 0});
+
+    // Verify a continuous channel cannot share its device.
+    std::vector<ads101x::planner::request> plan = {
+        {0, ads101x::configuration::multiplexer::AIN0_GND, ads101x::configuration::data_rate::SPS_1600, ads101x::configuration::mode::CONTINUOUS, 100},
+        {0, ads101x::configuration::multiplexer::AIN1_GND, ads101x::configuration::data_rate::SPS_1600, ads101x::configuration::mode::SINGLESHOT, 100}};
+    EXPECT_THROW(planner.evaluate(plan), std::runtime_error);
+
+    // Verify rates must be positive.
+    plan = {{0, ads101x::configuration::multiplexer::AIN0_GND, ads101x::configuration::data_rate::SPS_1600, ads101x::configuration::mode::SINGLESHOT, 0}};
+    EXPECT_THROW(planner.evaluate(plan), std::runtime_error);
+}
@@ -0,0 +1,57 @@
+// ads101x
+#include <ads101x/realtime.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <thread>
+
+// posix
+#include <sched.h>
+
+/// \brief Gets the first CPU the test process may run on, which may not be CPU 0 under a restricted cpuset.
+static int32_t first_allowed_cpu()
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if(sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+        for(int32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if(CPU_ISSET(cpu, &set))
+            {
+                return cpu;
+            }
+        }
+    }
+    return 0;
+}
+
+// PROFILE
+TEST(realtime, defaults)
+{
+    // Verify nothing is applied or reported by default.
+    ads101x::realtime_report report;
+    std::thread([&report]() { report = ads101x::apply_realtime(ads101x::realtime_profile()); }).join();
+    EXPECT_FALSE(report.scheduling);
+    EXPECT_FALSE(report.affinity);
+    EXPECT_FALSE(report.memory_locked);
+    EXPECT_FALSE(report.prefaulted);
+}
+TEST(realtime, unprivileged)
+{
+    // Affinity to a CPU the process may use and prefaulting do not require privileges.
+    ads101x::realtime_profile profile;
+    profile.cpu = first_allowed_cpu();
+    profile.prefault = true;
+    ads101x::realtime_report report;
+    std::thread([&]() { report = ads101x::apply_realtime(profile); }).join();
+    EXPECT_TRUE(report.affinity);
+    EXPECT_TRUE(report.prefaulted);
+
+    // An invalid CPU is reported as not granted.
+    profile.cpu = 100000;
+    std::thread([&]() { report = ads101x::apply_realtime(profile); }).join();
+    EXPECT_FALSE(report.affinity);
+}
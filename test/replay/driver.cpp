@@ -0,0 +1,122 @@
+// ads101x
+#include <ads101x/acquisition.hpp>
+#include <ads101x/replay/driver.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+/// \brief Creates a capture of a ramp sampled every millisecond.
+ads101x::replay::capture make_ramp(uint32_t count)
+{
+    ads101x::replay::capture capture;
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        capture.add_conversion(i * 1000000ULL, static_cast<int16_t>(i * 10 - 1000));
+    }
+    return capture;
+}
+
+// CAPTURE
+TEST(replay, capture_file)
+{
+    // Save and load a capture with an explicit edge.
+    ads101x::replay::capture capture = make_ramp(3);
+    capture.add_alert(2500000, false);
+    std::string path = "/tmp/ads101x_test_capture_" + std::to_string(getpid()) + ".txt";
+    capture.save(path);
+    ads101x::replay::capture loaded;
+    loaded.load(path);
+    ASSERT_EQ(loaded.events().size(), 4);
+    EXPECT_EQ(loaded.conversions(), 3);
+    EXPECT_EQ(loaded.events()[1].time, 1000000);
+    EXPECT_EQ(loaded.events()[2].value, -980);
+    EXPECT_TRUE(loaded.events()[3].alert);
+    EXPECT_FALSE(loaded.events()[3].level);
+
+    // Verify invalid events are rejected.
+    std::ofstream(path) << "0 5\n1 9999\n";
+    EXPECT_THROW(ads101x::replay::capture().load(path), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(capture.add_conversion(0, 0), std::runtime_error);
+    EXPECT_THROW(ads101x::replay::driver(ads101x::replay::capture()), std::runtime_error);
+}
+
+// PLAYBACK
+TEST(replay, as_fast_as_possible)
+{
+    // Replay a capture through a data-ready acquisition as fast as possible.
+    ads101x::replay::driver driver(make_ramp(100));
+    driver.set_speed(0);
+    driver.start();
+    ads101x::acquisition acquisition(driver, 10, 16);
+    acquisition.set_mode(ads101x::acquisition::mode::DATA_READY);
+    acquisition.set_alert_rdy_pin(4);
+    auto reader = acquisition.subscribe();
+    acquisition.start();
+    for(uint32_t i = 0; i < 500 && !driver.finished(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    acquisition.stop();
+
+    // Verify every conversion was read once and in order.
+    EXPECT_TRUE(driver.finished());
+    EXPECT_EQ(acquisition.samples(), 100);
+    std::span<const ads101x::sample> view;
+    int16_t expected = -1000;
+    while(reader.next(view))
+    {
+        for(auto& sample : view)
+        {
+            EXPECT_EQ(sample.value, expected);
+            expected += 10;
+        }
+    }
+    EXPECT_EQ(expected, -1000 + 100 * 10);
+}
+TEST(replay, speed)
+{
+    // Replay 20 ms of capture at 10x speed, counting conversion-ready edges.
+    ads101x::replay::driver driver(make_ramp(20));
+    driver.set_speed(10);
+    uint32_t edges = 0;
+    driver.start();
+    driver.write_hi_thresh(0x0800);
+    driver.write_lo_thresh(0x0000);
+    ads101x::configuration config;
+    config.set_comparator_queue(ads101x::configuration::comparator_queue::AFTER_1);
+    driver.write_config(config);
+    driver.attach_alert_rdy(4, [&edges](bool level) { edges += !level; });
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < 500 && !driver.finished(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    driver.detach_alert_rdy();
+
+    // Verify playback took about 2 ms and held the last conversion.
+    EXPECT_TRUE(driver.finished());
+    EXPECT_EQ(driver.played(), 20);
+    EXPECT_GE(edges, 18);
+    EXPECT_LT(elapsed, std::chrono::milliseconds(20));
+    EXPECT_EQ(ads101x::sample(driver.read_conversion(), config.get_fsr()).value, -1000 + 19 * 10);
+}
+TEST(replay, loop)
+{
+    // Verify looping playback keeps going past the end of the capture.
+    ads101x::replay::driver driver(make_ramp(5));
+    driver.set_speed(0);
+    driver.set_loop(true);
+    driver.start();
+    for(uint32_t i = 0; i < 12; ++i)
+    {
+        EXPECT_EQ(ads101x::sample(driver.read_conversion(), ads101x::configuration::fsr::FSR_2_048).value, -1000 + static_cast<int16_t>(i % 5) * 10);
+    }
+    EXPECT_FALSE(driver.finished());
+}
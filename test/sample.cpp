@@ -0,0 +1,33 @@
+// ads101x
+#include <ads101x/sample.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// CONSTRUCTORS
+TEST(sample, sign_extension)
+{
+    // Verify positive full scale.
+    ads101x::sample positive(0x07FF, ads101x::configuration::fsr::FSR_2_048);
+    EXPECT_EQ(positive.value, 2047);
+
+    // Verify negative full scale.
+    ads101x::sample negative(0x0800, ads101x::configuration::fsr::FSR_2_048);
+    EXPECT_EQ(negative.value, -2048);
+
+    // Verify minus one LSB.
+    ads101x::sample minus_one(0x0FFF, ads101x::configuration::fsr::FSR_2_048);
+    EXPECT_EQ(minus_one.value, -1);
+}
+
+// CONVERSION
+TEST(sample, voltage)
+{
+    // Half of positive full scale at +/- 4.096V.
+    ads101x::sample sample(1024, ads101x::configuration::fsr::FSR_4_096);
+    EXPECT_DOUBLE_EQ(sample.voltage(), 2.048);
+
+    // Negative full scale at +/- 0.256V.
+    sample = ads101x::sample(0x0800, ads101x::configuration::fsr::FSR_0_256);
+    EXPECT_DOUBLE_EQ(sample.voltage(), -0.256);
+}
@@ -0,0 +1,116 @@
+// ads101x
+#include <ads101x/clock.hpp>
+#include <ads101x/sampler.hpp>
+#include <ads101x/simulator/driver.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// SCHEDULING
+TEST(sampler, periodic)
+{
+    // Create two simulated devices with a different input on each channel.
+    ads101x::simulator::driver first;
+    first.set_input(ads101x::configuration::multiplexer::AIN0_GND, 0.25);
+    first.set_input(ads101x::configuration::multiplexer::AIN1_GND, 0.5);
+    first.start();
+    ads101x::simulator::driver second;
+    second.set_input(ads101x::configuration::multiplexer::AIN2_GND, 0.75);
+    second.start();
+
+    // Sample two channels of the first device at 100Hz and 50Hz, and the second device at 200Hz.
+    ads101x::sampler sampler;
+    ads101x::configuration config;
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    std::mutex mutex;
+    std::vector<ads101x::sample> samples[3];
+    auto record = [&mutex, &samples](uint32_t task)
+    {
+        return [&mutex, &samples, task](const ads101x::sample& sample)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            samples[task].push_back(sample);
+        };
+    };
+    EXPECT_EQ(sampler.add(first, config, ads101x::configuration::multiplexer::AIN0_GND, 10000000, record(0)), 0);
+    EXPECT_EQ(sampler.add(first, config, ads101x::configuration::multiplexer::AIN1_GND, 20000000, record(1)), 1);
+    EXPECT_EQ(sampler.add(second, config, ads101x::configuration::multiplexer::AIN2_GND, 5000000, record(2)), 2);
+
+    // Sample briefly. The schedule's grid starts when the sampler starts.
+    uint64_t epoch = ads101x::monotonic_ns();
+    sampler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(205));
+    sampler.stop();
+    uint64_t elapsed = ads101x::monotonic_ns() - epoch;
+
+    // Verify each task sampled its channel. Wall-clock rates depend on the host's load, so only properties that hold
+    // however late the thread wakes are checked: no task runs ahead of its grid, and every period up to the stop is
+    // either sampled or counted as an overrun at most once.
+    std::lock_guard<std::mutex> lock(mutex);
+    const double voltages[3] = {0.25, 0.5, 0.75};
+    const uint64_t periods[3] = {10000000, 20000000, 5000000};
+    for(uint32_t task = 0; task < 3; ++task)
+    {
+        ASSERT_GT(samples[task].size(), 1);
+        EXPECT_LE(samples[task].size() + sampler.overruns(task), elapsed / periods[task] + 1);
+        EXPECT_EQ(sampler.samples(task), samples[task].size());
+        EXPECT_EQ(sampler.errors(task), 0);
+        for(uint32_t i = 0; i < samples[task].size(); ++i)
+        {
+            EXPECT_NEAR(samples[task][i].voltage(), voltages[task], 0.001);
+            EXPECT_EQ(samples[task][i].sequence, i);
+            EXPECT_GE(samples[task][i].timestamp, epoch + i * periods[task]);
+            if(i > 0)
+            {
+                EXPECT_GT(samples[task][i].timestamp, samples[task][i - 1].timestamp);
+            }
+        }
+    }
+}
+TEST(sampler, overruns)
+{
+    // Create a simulated device with a bus slower than the sampling period.
+    ads101x::simulator::driver driver;
+    driver.start();
+    driver.set_latency(std::chrono::milliseconds(3));
+
+    // Sample at 200Hz, which needs 6ms of bus time per 5ms period.
+    ads101x::sampler sampler;
+    ads101x::configuration config;
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    sampler.add(driver, config, ads101x::configuration::multiplexer::AIN0_GND, 5000000, [](const ads101x::sample&) {});
+    uint64_t epoch = ads101x::monotonic_ns();
+    sampler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    sampler.stop();
+    uint64_t elapsed = ads101x::monotonic_ns() - epoch;
+
+    // Verify the missed periods were reported, and no period was counted twice.
+    EXPECT_GT(sampler.samples(0), 0);
+    EXPECT_GT(sampler.overruns(0), 0);
+    EXPECT_LE(sampler.samples(0) + sampler.overruns(0), elapsed / 5000000 + 1);
+}
+TEST(sampler, invalid)
+{
+    // Create simulated device.
+    ads101x::simulator::driver driver;
+    ads101x::sampler sampler;
+
+    // Verify a sampler without tasks cannot start.
+    EXPECT_THROW(sampler.start(), std::runtime_error);
+
+    // Verify a period shorter than a conversion is rejected.
+    ads101x::configuration config;
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_128);
+    EXPECT_THROW(sampler.add(driver, config, ads101x::configuration::multiplexer::AIN0_GND, 5000000, [](const ads101x::sample&) {}), std::runtime_error);
+
+    // Verify the conversion time follows the variant: 3300SPS on the ADS1015 is 475SPS on the ADS1115.
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    EXPECT_EQ(sampler.add(driver, config, ads101x::configuration::multiplexer::AIN0_GND, 1000000, [](const ads101x::sample&) {}), 0);
+    EXPECT_THROW(sampler.add(driver, config, ads101x::configuration::multiplexer::AIN0_GND, 1000000, [](const ads101x::sample&) {}, ads101x::variant::ADS1115), std::runtime_error);
+}
@@ -0,0 +1,80 @@
+// ads101x
+#include <ads101x/seqlock.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Create a value that is torn if its fields differ.
+struct triple
+{
+    uint64_t a;
+    uint64_t b;
+    uint32_t c;
+};
+
+// SLOT
+TEST(seqlock, store_load)
+{
+    ads101x::seqlock<triple> slot;
+
+    // Verify an empty slot.
+    triple value = {7, 7, 7};
+    EXPECT_FALSE(slot.load(value));
+    EXPECT_EQ(value.a, 7);
+    EXPECT_EQ(slot.version(), 0);
+
+    // Verify the latest value is loaded.
+    slot.store({1, 2, 3});
+    slot.store({4, 5, 6});
+    ASSERT_TRUE(slot.load(value));
+    EXPECT_EQ(value.a, 4);
+    EXPECT_EQ(value.b, 5);
+    EXPECT_EQ(value.c, 6);
+    EXPECT_EQ(slot.version(), 2);
+}
+
+// CONCURRENCY
+TEST(seqlock, concurrent_readers)
+{
+    ads101x::seqlock<triple> slot;
+    slot.store({0, 0, 0});
+
+    // Read the slot from several threads while it is being stored.
+    std::atomic<bool> running(true);
+    std::atomic<uint32_t> torn(0);
+    std::atomic<uint32_t> regressions(0);
+    std::vector<std::thread> readers;
+    for(uint32_t t = 0; t < 3; ++t)
+    {
+        readers.emplace_back([&slot, &running, &torn, &regressions]()
+        {
+            uint64_t last = 0;
+            triple value;
+            while(running.load(std::memory_order_relaxed))
+            {
+                slot.load(value);
+                torn += value.a != value.b || value.a != value.c;
+                regressions += value.a < last;
+                last = value.a;
+            }
+        });
+    }
+    for(uint32_t i = 1; i <= 200000; ++i)
+    {
+        slot.store({i, i, i});
+    }
+    running = false;
+    for(auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    // Verify no torn or stale value was read.
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(regressions, 0);
+}
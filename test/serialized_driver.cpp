@@ -0,0 +1,227 @@
+// ads101x
+#include <ads101x/serialized_driver.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <thread>
+#include <vector>
+
+// Create test driver that models the ADS101X register pointer and detects concurrent access.
+struct serial_driver
+    : public ads101x::driver
+{
+    // CONSTRUCTORS
+    serial_driver()
+        : registers{0x0123 << 4, 0x8583, 0x8000, 0x7FF0},
+          busy(false),
+          overlaps(0),
+          reads(0),
+          latency(0),
+          fail(false)
+    {}
+
+    // OVERRIDES
+    void open_i2c(uint32_t i2c_bus, uint8_t i2c_address) override
+    {}
+    void close_i2c() override
+    {}
+    void write_register(uint8_t register_address, uint16_t value) const override
+    {
+        enter();
+        serial_driver::registers[register_address] = value;
+        leave();
+    }
+    uint16_t read_register(uint8_t register_address) const override
+    {
+        enter();
+        serial_driver::reads++;
+        std::this_thread::sleep_for(serial_driver::latency);
+        uint16_t value = serial_driver::registers[register_address];
+        leave();
+        if(serial_driver::fail)
+        {
+            throw std::runtime_error("read failed");
+        }
+        return value;
+    }
+
+    // ACCESS
+    void enter() const
+    {
+        // Flag overlapping bus access and hold the bus briefly to widen the race window.
+        if(serial_driver::busy.exchange(true))
+        {
+            serial_driver::overlaps++;
+        }
+        std::this_thread::yield();
+    }
+    void leave() const
+    {
+        serial_driver::busy.store(false);
+    }
+
+    // STATE
+    mutable uint16_t registers[4];
+    mutable std::atomic<bool> busy;
+    mutable std::atomic<uint32_t> overlaps;
+    mutable std::atomic<uint32_t> reads;
+    std::chrono::microseconds latency;
+    bool fail;
+};
+
+// CONCURRENCY
+TEST(serialized_driver, concurrent_access)
+{
+    // Create driver and serialized front end.
+    serial_driver driver;
+    ads101x::serialized_driver serialized(driver);
+
+    // Hammer the front end from several threads.
+    std::vector<std::thread> threads;
+    std::atomic<uint32_t> errors(0);
+    for(uint32_t t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&serialized, &errors, t]()
+        {
+            for(uint32_t i = 0; i < 2000; ++i)
+            {
+                if(t % 2)
+                {
+                    // Monitoring thread reads the configuration.
+                    if(serialized.read_config().bitfield() != 0x8583)
+                    {
+                        errors++;
+                    }
+                }
+                else if(serialized.read_conversion() != 0x0123)
+                {
+                    // Acquisition thread read the wrong register.
+                    errors++;
+                }
+            }
+        });
+    }
+    for(auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Verify no overlapping bus access and no wrong values.
+    EXPECT_EQ(driver.overlaps, 0);
+    EXPECT_EQ(errors, 0);
+
+    // Verify every read was either a bus transaction or coalesced.
+    EXPECT_EQ(driver.reads + serialized.coalesced_reads(), 8000);
+}
+
+// PRIORITIES
+TEST(serialized_driver, priority)
+{
+    // Create a driver with slow reads, and split LOW block reads every 10 values.
+    serial_driver driver;
+    driver.latency = std::chrono::microseconds(100);
+    ads101x::serialized_driver serialized(driver);
+    serialized.set_preemption_interval(10);
+
+    // Start a LOW block read of 500 values, which holds the bus for at least 50ms.
+    std::vector<uint16_t> conversions(500);
+    std::thread logger([&serialized, &conversions]()
+    {
+        serialized.read_conversions(conversions, ads101x::serialized_driver::priority::LOW);
+    });
+    while(driver.reads == 0)
+    {
+        std::this_thread::yield();
+    }
+
+    // Read the configuration at HIGH priority while the block is in progress.
+    uint32_t errors = 0;
+    for(uint32_t i = 0; i < 10; ++i)
+    {
+        errors += serialized.read_config().bitfield() != 0x8583;
+    }
+    logger.join();
+    EXPECT_EQ(errors, 0);
+    EXPECT_EQ(driver.overlaps, 0);
+    for(auto conversion : conversions)
+    {
+        EXPECT_EQ(conversion, 0x0123);
+    }
+
+    // Verify the HIGH reads preempted the block at chunk boundaries instead of waiting for the whole block.
+    const ads101x::histogram& high = serialized.latency(ads101x::serialized_driver::priority::HIGH);
+    const ads101x::histogram& low = serialized.latency(ads101x::serialized_driver::priority::LOW);
+    EXPECT_EQ(high.count(), 10);
+    EXPECT_EQ(low.count(), 50);
+    EXPECT_GT(serialized.preemptions(), 0);
+    EXPECT_LT(high.max(), 25000000);
+}
+
+// SEQUENCES
+TEST(serialized_driver, sequence)
+{
+    // Create driver and serialized front end.
+    serial_driver driver;
+    ads101x::serialized_driver serialized(driver);
+
+    // Execute an atomic threshold setup.
+    serialized.execute([](ads101x::driver& driver)
+    {
+        driver.write_hi_thresh(0x0800);
+        driver.write_lo_thresh(0x0000);
+    });
+
+    // Verify registers.
+    EXPECT_EQ(serialized.read_hi_thresh(), 0x0800);
+    EXPECT_EQ(serialized.read_lo_thresh(), 0x0000);
+}
+
+// CACHE
+TEST(serialized_driver, cache)
+{
+    // Create driver and serialized front end.
+    serial_driver driver;
+    ads101x::serialized_driver serialized(driver);
+
+    // Verify the cache starts empty.
+    ads101x::configuration config;
+    EXPECT_FALSE(serialized.cached_config(config));
+
+    // Write configuration and verify it is served from the cache.
+    serialized.write_config(ads101x::configuration(0x4583));
+    uint32_t reads = driver.reads;
+    EXPECT_TRUE(serialized.cached_config(config));
+    EXPECT_EQ(config.bitfield(), 0x4583);
+    EXPECT_EQ(driver.reads, reads);
+
+    // Verify thresholds are cached after a read.
+    uint16_t threshold = 0;
+    EXPECT_FALSE(serialized.cached_hi_thresh(threshold));
+    serialized.read_hi_thresh();
+    EXPECT_TRUE(serialized.cached_hi_thresh(threshold));
+    EXPECT_EQ(threshold, 0x07FF);
+
+    // Verify block reads of the conversion register leave the cache intact.
+    std::vector<uint16_t> conversions(8);
+    serialized.read_conversions(conversions);
+    EXPECT_TRUE(serialized.cached_config(config));
+    EXPECT_TRUE(serialized.cached_hi_thresh(threshold));
+
+    // Verify invalidation.
+    serialized.invalidate_cache();
+    EXPECT_FALSE(serialized.cached_hi_thresh(threshold));
+}
+
+// ERRORS
+TEST(serialized_driver, exception)
+{
+    // Create failing driver and serialized front end.
+    serial_driver driver;
+    driver.fail = true;
+    ads101x::serialized_driver serialized(driver);
+
+    // Verify the exception reaches the caller.
+    EXPECT_THROW(serialized.read_conversion(), std::runtime_error);
+}
@@ -0,0 +1,150 @@
+// ads101x
+#include <ads101x/shm/publisher.hpp>
+#include <ads101x/shm/reader.hpp>
+#include <ads101x/simulator/driver.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <thread>
+#include <vector>
+
+// posix
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/// \brief Gets a sample bus name unique to this test process.
+std::string bus_name(const std::string& test)
+{
+    return "/ads101x_test_" + test + "_" + std::to_string(getpid());
+}
+/// \brief Creates samples with consecutive sequence numbers.
+std::vector<ads101x::sample> make_samples(uint64_t first, uint32_t count)
+{
+    std::vector<ads101x::sample> samples(count);
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        samples[i].value = static_cast<int16_t>(first + i);
+        samples[i].sequence = first + i;
+    }
+    return samples;
+}
+
+// READING
+TEST(shm, publish_read)
+{
+    // Create bus and reader.
+    ads101x::shm::publisher publisher(bus_name("publish_read"), 4, 8);
+    ads101x::shm::reader reader(publisher.name());
+    EXPECT_EQ(reader.block_size(), 8);
+
+    // Publish more samples than fit in one block.
+    publisher.publish(make_samples(0, 12));
+    EXPECT_EQ(publisher.published(), 2);
+    EXPECT_EQ(reader.lag(), 2);
+
+    // Read both blocks.
+    std::vector<ads101x::sample> buffer(reader.block_size());
+    ASSERT_EQ(reader.read(buffer), 8);
+    EXPECT_EQ(buffer[7].sequence, 7);
+    ASSERT_EQ(reader.read(buffer), 4);
+    EXPECT_EQ(buffer[0].sequence, 8);
+    EXPECT_EQ(buffer[3].value, 11);
+    EXPECT_EQ(reader.read(buffer), 0);
+    EXPECT_EQ(reader.overruns(), 0);
+}
+TEST(shm, overrun)
+{
+    // Create bus and reader.
+    ads101x::shm::publisher publisher(bus_name("overrun"), 4, 2);
+    ads101x::shm::reader reader(publisher.name());
+
+    // Publish more blocks than the ring holds.
+    for(uint64_t i = 0; i < 10; ++i)
+    {
+        publisher.publish(make_samples(2 * i, 2));
+    }
+
+    // Verify the reader skips to the oldest intact block.
+    std::vector<ads101x::sample> buffer(2);
+    ASSERT_EQ(reader.read(buffer), 2);
+    EXPECT_EQ(buffer[0].sequence, 12);
+    EXPECT_EQ(reader.overruns(), 6);
+    EXPECT_EQ(reader.lag(), 3);
+}
+TEST(shm, wait)
+{
+    // Create bus and reader.
+    ads101x::shm::publisher publisher(bus_name("wait"), 4, 4);
+    ads101x::shm::reader reader(publisher.name());
+
+    // Verify waiting times out without data.
+    EXPECT_FALSE(reader.wait(std::chrono::milliseconds(1)));
+
+    // Verify a publish from another thread wakes the reader.
+    std::thread thread([&publisher]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        publisher.publish(make_samples(0, 4));
+    });
+    EXPECT_TRUE(reader.wait(std::chrono::seconds(5)));
+    thread.join();
+
+    // Verify closing is visible to readers.
+    publisher.close();
+    EXPECT_TRUE(reader.closed());
+}
+TEST(shm, invalid)
+{
+    // Verify missing buses and bad parameters are rejected.
+    EXPECT_THROW(ads101x::shm::reader(bus_name("missing")), std::runtime_error);
+    EXPECT_THROW(ads101x::shm::publisher(bus_name("invalid"), 0, 4), std::runtime_error);
+
+    // Verify small read buffers are rejected.
+    ads101x::shm::publisher publisher(bus_name("invalid"), 2, 4);
+    ads101x::shm::reader reader(publisher.name());
+    std::vector<ads101x::sample> buffer(2);
+    EXPECT_THROW(reader.read(buffer), std::runtime_error);
+}
+TEST(shm, ownership)
+{
+    // Leave a stale bus, as a publisher that crashed would.
+    std::string name = bus_name("ownership");
+    int descriptor = shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+    ASSERT_GE(descriptor, 0);
+    close(descriptor);
+
+    // Verify the stale bus is replaced, but a bus owned by a running publisher is not.
+    ads101x::shm::publisher publisher(name, 2, 4);
+    EXPECT_THROW(ads101x::shm::publisher(name, 2, 4), std::runtime_error);
+    ads101x::shm::reader reader(name);
+    publisher.publish(make_samples(0, 4));
+    std::vector<ads101x::sample> buffer(4);
+    EXPECT_EQ(reader.read(buffer), 4);
+}
+TEST(shm, acquisition)
+{
+    // Create simulated device and acquisition.
+    ads101x::simulator::driver driver;
+    driver.set_input(ads101x::configuration::multiplexer::AIN0_GND, 1.0);
+    driver.start();
+    ads101x::acquisition acquisition(driver, 8, 16);
+    ads101x::configuration config;
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    acquisition.set_configuration(config);
+
+    // Publish the acquisition onto the bus.
+    ads101x::shm::publisher publisher(bus_name("acquisition"), 64, 8);
+    publisher.attach(acquisition);
+    ads101x::shm::reader reader(publisher.name());
+    acquisition.start();
+    ASSERT_TRUE(reader.wait(std::chrono::seconds(5)));
+    acquisition.stop();
+
+    // Verify the acquired stream arrived.
+    std::vector<ads101x::sample> buffer(reader.block_size());
+    ASSERT_GT(reader.read(buffer), 0);
+    EXPECT_EQ(buffer[0].sequence, 0);
+    EXPECT_NEAR(buffer[0].voltage(), 1.0, 0.003);
+}
@@ -0,0 +1,167 @@
+// ads101x
+#include <ads101x/clock.hpp>
+#include <ads101x/simulator/driver.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <memory>
+#include <thread>
+#include <vector>
+
+// CONVERSION
+TEST(simulator, singleshot)
+{
+    // Create simulated device.
+    ads101x::simulator::driver driver;
+    driver.set_input(ads101x::configuration::multiplexer::AIN2_GND, 3.0);
+    driver.start();
+
+    // Verify the device starts idle.
+    EXPECT_EQ(driver.read_config().get_operation(), ads101x::configuration::operation::CONVERT);
+
+    // Start a single-shot conversion.
+    ads101x::configuration config;
+    config.set_operation(ads101x::configuration::operation::CONVERT);
+    config.set_mode(ads101x::configuration::mode::SINGLESHOT);
+    config.set_multiplexer(ads101x::configuration::multiplexer::AIN2_GND);
+    config.set_fsr(ads101x::configuration::fsr::FSR_4_096);
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    driver.write_config(config);
+
+    // Verify the conversion is in progress, then completes.
+    EXPECT_EQ(driver.read_config().get_operation(), ads101x::configuration::operation::IDLE);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(driver.read_config().get_operation(), ads101x::configuration::operation::CONVERT);
+    EXPECT_EQ(driver.read_conversion(), 1500);
+    EXPECT_EQ(driver.conversions(), 1);
+}
+TEST(simulator, saturation)
+{
+    // Create simulated device with an input beyond full scale.
+    ads101x::simulator::driver driver;
+    driver.set_input(ads101x::configuration::multiplexer::AIN0_AIN1, -5.0);
+    driver.start();
+
+    // Run a single-shot conversion at +/- 2.048V.
+    ads101x::configuration config;
+    config.set_operation(ads101x::configuration::operation::CONVERT);
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    driver.write_config(config);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    // Verify negative full scale.
+    EXPECT_EQ(driver.read_conversion(), 0x0800);
+}
+
+TEST(simulator, polymorphic)
+{
+    // Verify a started device owned through the abstract driver stops its model thread when destroyed.
+    std::unique_ptr<ads101x::driver> driver = std::make_unique<ads101x::simulator::driver>();
+    driver->start();
+    driver->write_config(ads101x::configuration());
+    driver.reset();
+}
+
+// BUS
+TEST(simulator, deadline)
+{
+    // Create a simulated device with a slow bus.
+    ads101x::simulator::driver driver;
+    driver.start();
+    driver.set_latency(std::chrono::milliseconds(20));
+
+    // Verify a transaction that outlasts its deadline fails when the deadline passes.
+    uint64_t start = ads101x::monotonic_ns();
+    EXPECT_THROW(driver.read_conversion(start + 5000000), ads101x::timeout_error);
+    uint64_t elapsed = ads101x::monotonic_ns() - start;
+    EXPECT_GE(elapsed, 5000000);
+    EXPECT_LT(elapsed, 20000000);
+
+    // Verify a transaction within the default timeout succeeds.
+    driver.set_timeout(200000000);
+    EXPECT_EQ(driver.get_timeout(), 200000000);
+    EXPECT_NO_THROW(driver.read_config());
+
+    // Verify a transaction that is not expected to complete within the timeout is not issued.
+    driver.set_timeout(1000000);
+    uint64_t transactions = driver.transactions();
+    EXPECT_THROW(driver.read_config(), ads101x::timeout_error);
+    EXPECT_EQ(driver.transactions(), transactions);
+}
+TEST(simulator, deadline_estimate)
+{
+    // Create a simulated device with a slightly slow bus, and read a block under the default timeout.
+    ads101x::simulator::driver driver;
+    driver.start();
+    driver.set_latency(std::chrono::milliseconds(2));
+    driver.set_timeout(1000000000);
+    std::vector<uint16_t> conversions(16);
+    driver.read_conversions(conversions);
+
+    // Verify the block was accounted per value, so a single read is still issued against a short deadline.
+    EXPECT_NO_THROW(driver.read_conversion(ads101x::monotonic_ns() + 15000000));
+
+    // Verify thresholds honour their deadlines.
+    EXPECT_NO_THROW(driver.write_lo_thresh(0x123, ads101x::monotonic_ns() + 15000000));
+    EXPECT_EQ(driver.read_lo_thresh(ads101x::monotonic_ns() + 15000000), 0x123);
+    driver.set_latency(std::chrono::milliseconds(20));
+    EXPECT_THROW(driver.write_hi_thresh(0x456, ads101x::monotonic_ns() + 5000000), ads101x::timeout_error);
+}
+
+// ALERT_RDY
+TEST(simulator, conversion_ready)
+{
+    // Create simulated device.
+    ads101x::simulator::driver driver;
+    driver.start();
+
+    // Count active-low conversion-ready assertions.
+    std::atomic<uint32_t> assertions(0);
+    driver.attach_alert_rdy(4, [&assertions](bool level) { if(!level) assertions++; });
+    driver.write_hi_thresh(0x0800);
+    driver.write_lo_thresh(0x0000);
+
+    // Run continuous conversions at 1600 SPS.
+    ads101x::configuration config;
+    config.set_mode(ads101x::configuration::mode::CONTINUOUS);
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_1600);
+    config.set_comparator_queue(ads101x::configuration::comparator_queue::AFTER_1);
+    driver.write_config(config);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    driver.detach_alert_rdy();
+
+    // Verify roughly one assertion per conversion.
+    EXPECT_GT(assertions, 10);
+    EXPECT_LE(assertions, driver.conversions());
+}
+TEST(simulator, comparator)
+{
+    // Create simulated device with an input above the high threshold.
+    ads101x::simulator::driver driver;
+    driver.set_input(ads101x::configuration::multiplexer::AIN0_AIN1, 1.5);
+    driver.start();
+
+    // Track the active-high ALERT/RDY level.
+    std::atomic<bool> level(false);
+    driver.attach_alert_rdy(4, [&level](bool value) { level = value; });
+    driver.write_hi_thresh(1000);
+    driver.write_lo_thresh(500);
+
+    // Run a latching, active-high traditional comparator.
+    ads101x::configuration config;
+    config.set_operation(ads101x::configuration::operation::CONVERT);
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    config.set_comparator_polarity(ads101x::configuration::comparator_polarity::ACTIVE_HIGH);
+    config.set_comparator_latch(ads101x::configuration::comparator_latch::LATCHING);
+    config.set_comparator_queue(ads101x::configuration::comparator_queue::AFTER_1);
+    driver.write_config(config);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    // Verify the comparator asserted, and is released by reading the conversion.
+    EXPECT_TRUE(level);
+    driver.read_conversion();
+    EXPECT_FALSE(level);
+    driver.detach_alert_rdy();
+}
@@ -0,0 +1,222 @@
+// ads101x
+#include <ads101x/clock.hpp>
+#include <ads101x/simulator/driver.hpp>
+#include <ads101x/simulator/pigpiod_server.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// posix
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+typedef ads101x::simulator::pigpiod_server::command command;
+
+/// \brief Connects a raw pigpiod client to a server, with a receive timeout of one second.
+static int32_t connect_client(uint16_t port)
+{
+    int32_t client = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    EXPECT_EQ(connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    timeval timeout = {1, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return client;
+}
+/// \brief Sends a pigpiod command and receives its result, and any bytes that follow it.
+static int32_t execute(int32_t client, command code, uint32_t p1, uint32_t p2, const std::vector<uint8_t>& extension = {}, std::vector<uint8_t>* bytes = nullptr)
+{
+    // Send the command and its extension.
+    uint32_t words[4] = {static_cast<uint32_t>(code), p1, p2, static_cast<uint32_t>(extension.size())};
+    std::vector<uint8_t> message(reinterpret_cast<uint8_t*>(words), reinterpret_cast<uint8_t*>(words) + sizeof(words));
+    message.insert(message.end(), extension.begin(), extension.end());
+    EXPECT_EQ(send(client, message.data(), message.size(), 0), static_cast<ssize_t>(message.size()));
+
+    // Receive the echoed command and result.
+    if(recv(client, words, sizeof(words), MSG_WAITALL) != sizeof(words))
+    {
+        return INT32_MIN;
+    }
+    int32_t result;
+    std::memcpy(&result, &words[3], sizeof(result));
+    if(bytes && result > 0)
+    {
+        bytes->resize(result);
+        EXPECT_EQ(recv(client, bytes->data(), result, MSG_WAITALL), result);
+    }
+    return result;
+}
+/// \brief Packs a 32-bit parameter as an extension.
+static std::vector<uint8_t> extension(uint32_t value)
+{
+    std::vector<uint8_t> bytes(sizeof(value));
+    std::memcpy(bytes.data(), &value, sizeof(value));
+    return bytes;
+}
+
+// I2C
+TEST(pigpiod_server, i2c)
+{
+    // Create a server for a simulated device.
+    ads101x::simulator::driver driver;
+    driver.set_input(ads101x::configuration::multiplexer::AIN2_GND, 3.0);
+    driver.start();
+    ads101x::simulator::pigpiod_server server(driver, 1, 0x48, 25);
+    std::thread thread(&ads101x::simulator::pigpiod_server::run, &server);
+    int32_t client = connect_client(server.port());
+
+    // Open a handle, and verify other addresses do not answer.
+    int32_t handle = execute(client, command::I2CO, 1, 0x48, extension(0));
+    ASSERT_GE(handle, 0);
+    int32_t other = execute(client, command::I2CO, 1, 0x49, extension(0));
+    ASSERT_GE(other, 0);
+    EXPECT_EQ(execute(client, command::I2CRW, other, 1), -83);
+    EXPECT_EQ(execute(client, command::I2CC, other, 0), 0);
+    EXPECT_EQ(execute(client, command::I2CRW, other, 1), -25);
+
+    // Write the thresholds as SMBus words, whose first byte is the register's most significant byte.
+    EXPECT_EQ(execute(client, command::I2CWW, handle, 2, extension(0x3412)), 0);
+    EXPECT_EQ(driver.read_lo_thresh(), 0x123);
+    EXPECT_EQ(execute(client, command::I2CRW, handle, 2), 0x3412);
+
+    // Start a single-shot conversion with a zip, then read the conversion register twice in another.
+    ads101x::configuration config;
+    config.set_operation(ads101x::configuration::operation::CONVERT);
+    config.set_mode(ads101x::configuration::mode::SINGLESHOT);
+    config.set_multiplexer(ads101x::configuration::multiplexer::AIN2_GND);
+    config.set_fsr(ads101x::configuration::fsr::FSR_4_096);
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    uint16_t bitfield = config.bitfield();
+    std::vector<uint8_t> write = {7, 3, 1, static_cast<uint8_t>(bitfield >> 8), static_cast<uint8_t>(bitfield), 0};
+    EXPECT_EQ(execute(client, command::I2CZ, handle, 0, write), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    std::vector<uint8_t> read = {7, 1, 0, 6, 2, 6, 2, 0};
+    std::vector<uint8_t> bytes;
+    ASSERT_EQ(execute(client, command::I2CZ, handle, 0, read, &bytes), 4);
+    EXPECT_EQ((bytes[0] << 8) | bytes[1], 1500 << 4);
+    EXPECT_EQ((bytes[2] << 8) | bytes[3], 1500 << 4);
+
+    // Verify unknown commands are refused, and the commands were counted.
+    EXPECT_EQ(execute(client, static_cast<command>(120), 0, 0), -123);
+    EXPECT_EQ(server.commands(command::I2CZ), 2);
+    EXPECT_EQ(server.commands(command::I2CRW), 3);
+    EXPECT_EQ(server.clients(), 1);
+
+    close(client);
+    server.stop();
+    thread.join();
+}
+
+// NOTIFICATIONS
+TEST(pigpiod_server, notify)
+{
+    // Create a server for a simulated device.
+    ads101x::simulator::driver driver;
+    driver.start();
+    ads101x::simulator::pigpiod_server server(driver, 1, 0x48, 25);
+    std::thread thread(&ads101x::simulator::pigpiod_server::run, &server);
+    int32_t client = connect_client(server.port());
+
+    // Open a notification stream and watch the ALERT/RDY pin.
+    int32_t stream = connect_client(server.port());
+    int32_t notify = execute(stream, command::NOIB, 0, 0);
+    ASSERT_GE(notify, 0);
+    EXPECT_EQ(execute(client, command::BR1, 0, 0), 1 << 25);
+    EXPECT_EQ(execute(client, command::MODES, 25, 0), 0);
+    EXPECT_EQ(execute(client, command::PUD, 25, 2), 0);
+    EXPECT_EQ(execute(client, command::NB, notify, 1 << 25), 0);
+
+    // Run continuous conversions in conversion-ready mode at 1600 SPS.
+    driver.write_hi_thresh(0x0800);
+    driver.write_lo_thresh(0x0000);
+    ads101x::configuration config;
+    config.set_mode(ads101x::configuration::mode::CONTINUOUS);
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_1600);
+    config.set_comparator_queue(ads101x::configuration::comparator_queue::AFTER_1);
+    driver.write_config(config);
+
+    // Verify the stream reports alternating levels in sequence.
+    uint32_t assertions = 0;
+    uint32_t last_level = 1 << 25;
+    for(uint16_t sequence = 0; sequence < 20; ++sequence)
+    {
+        uint8_t report[12];
+        ASSERT_EQ(recv(stream, report, sizeof(report), MSG_WAITALL), sizeof(report));
+        uint16_t report_sequence;
+        uint16_t flags;
+        uint32_t level;
+        std::memcpy(&report_sequence, report, sizeof(report_sequence));
+        std::memcpy(&flags, report + 2, sizeof(flags));
+        std::memcpy(&level, report + 8, sizeof(level));
+        EXPECT_EQ(report_sequence, sequence);
+        EXPECT_EQ(flags, 0);
+        EXPECT_NE(level, last_level);
+        last_level = level;
+        assertions += (level == 0);
+    }
+    EXPECT_EQ(assertions, 10);
+
+    // Stop conversions, and verify the watchdog reports the stall.
+    config.set_mode(ads101x::configuration::mode::SINGLESHOT);
+    driver.write_config(config);
+    EXPECT_EQ(execute(client, command::WDOG, 25, 10), 0);
+    bool stalled = false;
+    for(uint32_t i = 0; i < 100 && !stalled; ++i)
+    {
+        uint8_t report[12];
+        ASSERT_EQ(recv(stream, report, sizeof(report), MSG_WAITALL), sizeof(report));
+        uint16_t flags;
+        std::memcpy(&flags, report + 2, sizeof(flags));
+        stalled = flags == ((1 << 5) | 25);
+    }
+    EXPECT_TRUE(stalled);
+    EXPECT_EQ(execute(client, command::WDOG, 25, 0), 0);
+
+    close(stream);
+    close(client);
+    server.stop();
+    thread.join();
+}
+
+// FAULTS
+TEST(pigpiod_server, latency)
+{
+    // Create a server whose word reads are slow.
+    ads101x::simulator::driver driver;
+    driver.start();
+    ads101x::simulator::pigpiod_server server(driver);
+    server.set_latency(command::I2CRW, std::chrono::milliseconds(20));
+    std::thread thread(&ads101x::simulator::pigpiod_server::run, &server);
+    int32_t client = connect_client(server.port());
+    int32_t handle = execute(client, command::I2CO, 1, 0x48, extension(0));
+    ASSERT_GE(handle, 0);
+
+    // Verify only the slow command is delayed.
+    uint64_t start = ads101x::monotonic_ns();
+    EXPECT_GE(execute(client, command::TICK, 0, 0), 0);
+    EXPECT_LT(ads101x::monotonic_ns() - start, 10000000);
+    start = ads101x::monotonic_ns();
+    EXPECT_GE(execute(client, command::I2CRW, handle, 1), 0);
+    EXPECT_GE(ads101x::monotonic_ns() - start, 20000000);
+
+    // Drop the connection, and verify the client sees it closed and its handle was closed with it.
+    server.drop();
+    uint8_t byte;
+    EXPECT_EQ(recv(client, &byte, 1, 0), 0);
+    close(client);
+    client = connect_client(server.port());
+    EXPECT_EQ(execute(client, command::I2CRW, handle, 1), -25);
+    EXPECT_EQ(server.clients(), 1);
+
+    close(client);
+    server.stop();
+    thread.join();
+}
@@ -0,0 +1,92 @@
+// ads101x
+#include <ads101x/trigger.hpp>
+#include <ads101x/simulator/driver.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// Create a simulated input that steps from 0.5V to 1.5V after 50ms.
+double step(ads101x::configuration::multiplexer multiplexer, double time)
+{
+    return (time < 0.05) ? 0.5 : 1.5;
+}
+
+// CAPTURE
+TEST(trigger, threshold)
+{
+    // Create simulated device.
+    ads101x::simulator::driver driver;
+    driver.set_signal(step);
+    driver.start();
+
+    // Arm a capture of 16 samples either side of the step.
+    ads101x::acquisition acquisition(driver, 8, 16);
+    ads101x::configuration config;
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    acquisition.set_configuration(config);
+    ads101x::trigger trigger(16, 16);
+    trigger.set_threshold(-2048, 1000);
+    trigger.attach(acquisition);
+    trigger.arm();
+    EXPECT_TRUE(trigger.armed());
+
+    // Acquire until the capture completes.
+    acquisition.start();
+    ASSERT_TRUE(trigger.wait(1000000000));
+    acquisition.stop();
+
+    // Verify the record is contiguous around the first sample outside the window.
+    const ads101x::trigger::record& record = trigger.capture();
+    ASSERT_EQ(record.samples.size(), 32);
+    EXPECT_EQ(record.trigger_index, 16);
+    EXPECT_EQ(record.source, ads101x::trigger::source::THRESHOLD);
+    EXPECT_EQ(record.samples[15].value, 500);
+    EXPECT_EQ(record.samples[16].value, 1500);
+    for(uint32_t i = 1; i < record.samples.size(); ++i)
+    {
+        EXPECT_EQ(record.samples[i].sequence, record.samples[i - 1].sequence + 1);
+    }
+    EXPECT_FALSE(trigger.armed());
+    EXPECT_EQ(trigger.captures(), 1);
+}
+TEST(trigger, alert_rdy)
+{
+    // Create simulated device with a window comparator around the step.
+    ads101x::simulator::driver driver;
+    driver.set_signal(step);
+    driver.start();
+    driver.write_hi_thresh(1000);
+    driver.write_lo_thresh(900);
+
+    // Poll continuous conversions with the comparator asserting ALERT/RDY.
+    ads101x::acquisition acquisition(driver, 8, 16);
+    ads101x::configuration config;
+    config.set_data_rate(ads101x::configuration::data_rate::SPS_3300);
+    config.set_comparator_polarity(ads101x::configuration::comparator_polarity::ACTIVE_HIGH);
+    config.set_comparator_queue(ads101x::configuration::comparator_queue::AFTER_1);
+    acquisition.set_configuration(config);
+
+    // Arm a capture on the comparator.
+    ads101x::trigger trigger(20, 4);
+    trigger.attach_alert_rdy(driver, 4, ads101x::configuration::comparator_polarity::ACTIVE_HIGH);
+    trigger.attach(acquisition);
+    trigger.arm();
+
+    // Acquire until the capture completes.
+    acquisition.start();
+    ASSERT_TRUE(trigger.wait(1000000000));
+    acquisition.stop();
+    trigger.detach_alert_rdy();
+
+    // Verify the capture starts before and triggers after the step.
+    const ads101x::trigger::record& record = trigger.capture();
+    ASSERT_EQ(record.samples.size(), 24);
+    EXPECT_EQ(record.trigger_index, 20);
+    EXPECT_EQ(record.source, ads101x::trigger::source::ALERT_RDY);
+    EXPECT_EQ(record.samples.front().value, 500);
+    EXPECT_EQ(record.samples[record.trigger_index].value, 1500);
+
+    // Verify the trigger cannot be armed twice, and can be re-armed once complete.
+    trigger.arm();
+    EXPECT_THROW(trigger.arm(), std::runtime_error);
+}
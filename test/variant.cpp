@@ -0,0 +1,118 @@
+// ads101x
+#include <ads101x/driver.hpp>
+#include <ads101x/variant.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// Create test driver object.
+struct variant_driver
+    : public ads101x::driver
+{
+    // CONSTRUCTORS
+    variant_driver()
+        : write_value(0),
+          read_value(0)
+    {}
+
+    // OVERRIDES
+    void open_i2c(uint32_t i2c_bus, uint8_t i2c_address) override
+    {}
+    void close_i2c() override
+    {}
+    void write_register(uint8_t register_address, uint16_t value) const override
+    {
+        variant_driver::write_value = value;
+    }
+    uint16_t read_register(uint8_t register_address) const override
+    {
+        return variant_driver::read_value;
+    }
+
+    // STATE
+    mutable uint16_t write_value;
+    uint16_t read_value;
+};
+
+// TRAITS
+TEST(variant, traits)
+{
+    // Verify resolution constants.
+    static_assert(ads101x::traits<ads101x::variant::ADS1015>::shift == 4, "ADS1015 shift");
+    static_assert(ads101x::traits<ads101x::variant::ADS1115>::shift == 0, "ADS1115 shift");
+    static_assert(ads101x::traits<ads101x::variant::ADS1013>::max_code == 2047, "ADS1013 max code");
+    static_assert(ads101x::traits<ads101x::variant::ADS1113>::min_code == -32768, "ADS1113 min code");
+
+    // Verify data rate tables.
+    static_assert(ads101x::traits<ads101x::variant::ADS1015>::samples_per_second(ads101x::configuration::data_rate::SPS_3300) == 3300, "ADS1015 data rate");
+    static_assert(ads101x::traits<ads101x::variant::ADS1115>::samples_per_second(ads101x::configuration::data_rate::SPS_3300) == 475, "ADS1115 data rate");
+    static_assert(ads101x::traits<ads101x::variant::ADS1114>::conversion_period_us(ads101x::configuration::data_rate::SPS_128) == 125000, "ADS1114 period");
+
+    // Verify feature support.
+    static_assert(!ads101x::traits<ads101x::variant::ADS1013>::supports(ads101x::configuration::fsr::FSR_4_096), "ADS1013 PGA");
+    static_assert(!ads101x::traits<ads101x::variant::ADS1014>::supports(ads101x::configuration::multiplexer::AIN0_GND), "ADS1014 MUX");
+    static_assert(ads101x::traits<ads101x::variant::ADS1015>::supports(ads101x::configuration::multiplexer::AIN0_GND), "ADS1015 MUX");
+
+    // Verify sign extension.
+    EXPECT_EQ(ads101x::traits<ads101x::variant::ADS1015>::decode(0x8000), -2048);
+    EXPECT_EQ(ads101x::traits<ads101x::variant::ADS1115>::decode(0xFFFF), -1);
+}
+
+// CONFIGURATION
+TEST(variant, configuration)
+{
+    // Create ADS1014 configuration using compile-time checked settings.
+    ads101x::variant_configuration<ads101x::variant::ADS1014> config;
+    config.set_fsr<ads101x::configuration::fsr::FSR_0_512>();
+    config.set_multiplexer<ads101x::configuration::multiplexer::AIN0_AIN1>();
+    config.set_comparator_polarity(ads101x::configuration::comparator_polarity::ACTIVE_HIGH);
+
+    // Verify underlying configuration.
+    EXPECT_EQ(config.get().get_fsr(), ads101x::configuration::fsr::FSR_0_512);
+    EXPECT_EQ(config.get().get_comparator_polarity(), ads101x::configuration::comparator_polarity::ACTIVE_HIGH);
+
+    // Write configuration.
+    variant_driver driver;
+    driver.write_config(config);
+    EXPECT_EQ(driver.write_value, config.get().bitfield());
+}
+
+// DRIVER
+TEST(variant, read_conversion)
+{
+    // Create test driver with a negative full scale register value.
+    variant_driver driver;
+    driver.read_value = 0x8000;
+
+    // Verify each resolution reads the same register through its own shift.
+    EXPECT_EQ(driver.read_conversion<ads101x::variant::ADS1015>(), 0x0800);
+    EXPECT_EQ(driver.read_conversion<ads101x::variant::ADS1115>(), 0x8000);
+    EXPECT_EQ(driver.read_conversion(), 0x0800);
+}
+TEST(variant, write_thresh)
+{
+    // Create test driver.
+    variant_driver driver;
+
+    // Verify threshold encoding for each resolution.
+    driver.write_hi_thresh<ads101x::variant::ADS1014>(0x0123);
+    EXPECT_EQ(driver.write_value, 0x1230);
+    driver.write_lo_thresh<ads101x::variant::ADS1115>(0x1234);
+    EXPECT_EQ(driver.write_value, 0x1234);
+}
+TEST(variant, read_thresh)
+{
+    // Create test driver.
+    variant_driver driver;
+
+    // Verify a 16-bit threshold round trips through the register, including its low nibble.
+    driver.write_hi_thresh<ads101x::variant::ADS1115>(0xABCD);
+    driver.read_value = driver.write_value;
+    EXPECT_EQ(driver.read_hi_thresh<ads101x::variant::ADS1115>(), 0xABCD);
+    driver.write_lo_thresh<ads101x::variant::ADS1115>(0x8001);
+    driver.read_value = driver.write_value;
+    EXPECT_EQ(driver.read_lo_thresh<ads101x::variant::ADS1115>(), 0x8001);
+
+    // Verify the 12-bit variants read the same register through their own shift.
+    EXPECT_EQ(driver.read_lo_thresh<ads101x::variant::ADS1015>(), 0x0800);
+}